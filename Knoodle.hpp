@@ -67,6 +67,7 @@ namespace Knoodle
 #include "src/PlanarDiagramComplex/LoopRemover.hpp"
 #include "src/PlanarDiagramComplex/ArcSimplifier.hpp"
 #include "src/PlanarDiagramComplex/PassSimplifier.hpp"
+#include "src/PlanarDiagramComplex/SimplifyWorkspace.hpp"
 
 #include "src/PlanarDiagram.hpp"
 #include "src/PlanarDiagramComplex.hpp"
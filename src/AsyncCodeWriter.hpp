@@ -0,0 +1,471 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <deque>
+#include <thread>
+
+#ifdef KNOODLE_USE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace Knoodle
+{
+    /*!@brief Writes blocks of text to a file on a background thread, so that the thread that produces the blocks never waits for the filesystem.
+     *
+     * The blocks are handed over through a bounded single-producer/single-consumer ring buffer. If the ring buffer is full, `Push` keeps the block in a backlog on the producer side and hands it over with a later call of `Push` or `Flush`. The backlog holds at most `backlog_capacity` blocks; once it is full, `Push` waits until the writer thread has made room, so that a slow filesystem cannot make the producer hoard an unbounded amount of memory. The writer thread collects consecutive blocks into batches of about `batch_byte_count` bytes and writes each batch with a single call. Optionally, each batch is compressed into an independent zstd frame (this requires `KNOODLE_USE_ZSTD`), and a new file is started whenever the current one has reached `rotate_byte_count` bytes. Blocks are never split across batches, so each file contains only complete blocks.
+     *
+     * The first file is `file` (with ".zst" appended if compressed); file number k > 0 has "_<k>" inserted before the extension.
+     */
+
+    class AsyncCodeWriter final
+    {
+    public:
+
+        struct Settings_T
+        {
+            Size_T queue_capacity    = 1024;             // Number of blocks; rounded up to a power of 2.
+            Size_T backlog_capacity  = 4096;             // Number of blocks; at least 1.
+            Size_T batch_byte_count  = Size_T(1) << 20;
+            Size_T rotate_byte_count = 0;                // 0 means that the file is never rotated.
+            int    compression_level = 0;                // zstd level; 0 means no compression.
+            bool   appendQ           = false;            // Continue an existing first file instead of truncating it; not with compression or rotation.
+        };
+
+        AsyncCodeWriter( cref<std::filesystem::path> file_, cref<Settings_T> settings_ )
+        :   base_file { file_     }
+        ,   settings  { settings_ }
+        ,   slots     ( std::bit_ceil( Max( settings_.queue_capacity, Size_T(2) ) ) )
+        ,   mask      { slots.size() - Size_T(1) }
+        {
+#ifndef KNOODLE_USE_ZSTD
+            if( settings.compression_level != 0 )
+            {
+                throw std::runtime_error(
+                    ClassName()+"(): Compression requires compilation with KNOODLE_USE_ZSTD."
+                );
+            }
+#endif
+            // The byte counts of a continued file would not be counts of uncompressed bytes in a single file.
+            if( settings.appendQ && ((settings.compression_level != 0) || (settings.rotate_byte_count > Size_T(0))) )
+            {
+                throw std::runtime_error(
+                    ClassName()+"(): A file cannot be continued with compression or rotation."
+                );
+            }
+            
+            // We create the first file here, so that a failure is reported to the caller.
+            OpenFile();
+            
+            byte_count = file_byte_count;
+
+            writer = std::thread( [this](){ this->WriterLoop(); } );
+        }
+
+        // Default constructor
+        AsyncCodeWriter() = delete;
+        // Destructor
+        ~AsyncCodeWriter()
+        {
+            try
+            {
+                Close();
+            }
+            catch( const std::exception & e )
+            {
+                eprint(e.what());
+            }
+        }
+        // Copy constructor
+        AsyncCodeWriter( const AsyncCodeWriter & other ) = delete;
+        // Copy assignment operator
+        AsyncCodeWriter & operator=( const AsyncCodeWriter & other ) = delete;
+        // Move constructor
+        AsyncCodeWriter( AsyncCodeWriter && other ) = delete;
+        // Move assignment operator
+        AsyncCodeWriter & operator=( AsyncCodeWriter && other ) = delete;
+
+    private:
+
+        // Only read by the writer thread after construction.
+        std::filesystem::path base_file;
+        Settings_T            settings;
+
+        std::vector<std::string> slots;
+        Size_T                   mask;
+
+        // The producer writes to `tail`, the writer thread to `head`.
+        alignas( ObjectAlignment ) std::atomic<Size_T> head    { 0 };
+        alignas( ObjectAlignment ) std::atomic<Size_T> tail    { 0 };
+        alignas( ObjectAlignment ) std::atomic<Size_T> written { 0 }; // Number of blocks that are written (or discarded after an error).
+        alignas( ObjectAlignment ) std::atomic<Size_T> signal  { 0 }; // Bumped whenever the writer thread has to wake up.
+
+        std::atomic<bool> closeQ  { false };
+        std::atomic<bool> failedQ { false };
+        std::string       error; // Written by the writer thread before `failedQ` is set.
+
+        // Owned by the producer.
+        std::deque<std::string> backlog;
+        Size_T pushed_count      = 0;
+        Size_T byte_count        = 0;
+        Size_T max_backlog_count  = 0;
+        Size_T backlog_wait_count = 0;
+        bool   closedQ           = false;
+
+        // Owned by the writer thread until it is joined.
+        std::thread   writer;
+        std::ofstream stream;
+        std::filesystem::path file;
+        Size_T file_count      = 0;
+        Size_T file_byte_count = 0;
+        double write_time      = 0;
+
+    public:
+
+        /*!@brief Hands `block` over to the writer thread. This waits for the writer thread only if the ring buffer and the backlog are both full. Throws if an earlier write has failed.
+         */
+
+        void Push( std::string && block )
+        {
+            CheckError("Push");
+
+            byte_count += block.size();
+            ++pushed_count;
+
+            DrainBacklog();
+
+            if( !backlog.empty() || !TryEnqueue( block ) )
+            {
+                WaitForBacklogRoom();
+
+                backlog.push_back( std::move(block) );
+                max_backlog_count = Max( max_backlog_count, backlog.size() );
+            }
+        }
+
+        /*!@brief Waits until all blocks pushed so far are written to the file and flushed.
+         */
+
+        void Flush()
+        {
+            WaitForWriter();
+
+            CheckError("Flush");
+        }
+
+        /*!@brief Writes all remaining blocks, stops the writer thread, and closes the file. Further calls of `Push` are not allowed.
+         */
+
+        void Close()
+        {
+            if( closedQ )
+            {
+                return;
+            }
+
+            // The writer thread has to be joined in any case, so we must not throw before.
+            WaitForWriter();
+
+            closedQ = true;
+
+            closeQ.store( true, std::memory_order_release );
+            Wake();
+
+            writer.join();
+
+            CheckError("Close");
+        }
+
+        // Number of bytes pushed so far (before compression); with `appendQ`, this includes the bytes that the file had before.
+        Size_T ByteCount() const
+        {
+            return byte_count;
+        }
+
+        // Greatest number of blocks that had to wait on the producer side because the ring buffer was full. Never exceeds `backlog_capacity`.
+        Size_T MaxBacklogCount() const
+        {
+            return max_backlog_count;
+        }
+
+        // Number of calls of `Push` that had to wait because the backlog was full.
+        Size_T BacklogWaitCount() const
+        {
+            return backlog_wait_count;
+        }
+
+        // Only valid after `Close`.
+        Size_T FileCount() const
+        {
+            return file_count;
+        }
+
+        // Time the writer thread spent in writing and compressing. Only valid after `Close`.
+        double WriteTime() const
+        {
+            return write_time;
+        }
+
+    private:
+
+        void Wake()
+        {
+            signal.fetch_add( Size_T(1), std::memory_order_release );
+            signal.notify_one();
+        }
+
+        bool TryEnqueue( mref<std::string> block )
+        {
+            const Size_T t = tail.load( std::memory_order_relaxed );
+
+            if( t - head.load( std::memory_order_acquire ) >= slots.size() )
+            {
+                return false;
+            }
+
+            swap( slots[t & mask], block );
+
+            tail.store( t + Size_T(1), std::memory_order_release );
+
+            Wake();
+
+            return true;
+        }
+
+        void WaitForWriter()
+        {
+            while( !backlog.empty() )
+            {
+                DrainBacklog();
+
+                if( !backlog.empty() )
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            Size_T w = written.load( std::memory_order_acquire );
+
+            while( w < pushed_count )
+            {
+                written.wait( w, std::memory_order_acquire );
+                w = written.load( std::memory_order_acquire );
+            }
+        }
+
+        // Waits until the backlog has room for one more block. The writer thread bumps `written` after each batch, and it always makes progress while the ring buffer is full (also after a failed write, when it discards the blocks).
+        void WaitForBacklogRoom()
+        {
+            const Size_T capacity = Max( settings.backlog_capacity, Size_T(1) );
+
+            if( backlog.size() < capacity )
+            {
+                return;
+            }
+
+            ++backlog_wait_count;
+
+            while( true )
+            {
+                const Size_T w = written.load( std::memory_order_acquire );
+
+                DrainBacklog();
+
+                if( backlog.size() < capacity )
+                {
+                    return;
+                }
+
+                written.wait( w, std::memory_order_acquire );
+            }
+        }
+
+        void DrainBacklog()
+        {
+            while( !backlog.empty() && TryEnqueue( backlog.front() ) )
+            {
+                backlog.pop_front();
+            }
+        }
+
+        void CheckError( const std::string & tag ) const
+        {
+            if( failedQ.load( std::memory_order_acquire ) )
+            {
+                throw std::runtime_error( ClassName()+"::" + tag + ": " + error );
+            }
+        }
+
+        std::filesystem::path FileName( const Size_T k ) const
+        {
+            std::filesystem::path f = base_file;
+
+            if( k > Size_T(0) )
+            {
+                f.replace_filename(
+                    base_file.stem().string() + "_" + StringWithLeadingZeroes(k,4) + base_file.extension().string()
+                );
+            }
+
+            if( settings.compression_level != 0 )
+            {
+                f += ".zst";
+            }
+
+            return f;
+        }
+
+        void OpenFile()
+        {
+            if( stream.is_open() )
+            {
+                stream.close();
+            }
+
+            file = FileName( file_count );
+
+            const bool appendQ = settings.appendQ && (file_count == Size_T(0));
+
+            stream.open(
+                file,
+                std::ios_base::out | std::ios_base::binary | (appendQ ? std::ios_base::app : std::ios_base::trunc)
+            );
+
+            if( !stream )
+            {
+                throw std::runtime_error(
+                    ClassName()+"::OpenFile: Failed to create file \"" + file.string() + "\"."
+                );
+            }
+
+            ++file_count;
+            file_byte_count = appendQ ? static_cast<Size_T>(std::filesystem::file_size(file)) : Size_T(0);
+        }
+
+        void WriteBatch( cref<std::string> batch )
+        {
+            if( (settings.rotate_byte_count > Size_T(0)) && (file_byte_count >= settings.rotate_byte_count) )
+            {
+                OpenFile();
+            }
+
+#ifdef KNOODLE_USE_ZSTD
+            if( settings.compression_level != 0 )
+            {
+                std::string frame ( ZSTD_compressBound( batch.size() ), '\0' );
+
+                const Size_T size = ZSTD_compress(
+                    frame.data(), frame.size(), batch.data(), batch.size(), settings.compression_level
+                );
+
+                if( ZSTD_isError(size) )
+                {
+                    throw std::runtime_error(
+                        ClassName()+"::WriteBatch: zstd failed with \"" + std::string(ZSTD_getErrorName(size)) + "\"."
+                    );
+                }
+
+                stream.write( frame.data(), static_cast<std::streamsize>(size) );
+                file_byte_count += size;
+            }
+            else
+#endif
+            {
+                stream.write( batch.data(), static_cast<std::streamsize>(batch.size()) );
+                file_byte_count += batch.size();
+            }
+
+            stream.flush();
+
+            if( !stream )
+            {
+                throw std::runtime_error(
+                    ClassName()+"::WriteBatch: Failed to write to file \"" + file.string() + "\"."
+                );
+            }
+        }
+
+        void WriterLoop()
+        {
+            std::string batch;
+            std::string block;
+
+            while( true )
+            {
+                const Size_T s = signal.load( std::memory_order_acquire );
+
+                Size_T h = head.load( std::memory_order_relaxed );
+                Size_T t = tail.load( std::memory_order_acquire );
+
+                if( h == t )
+                {
+                    if( closeQ.load( std::memory_order_acquire ) )
+                    {
+                        break;
+                    }
+
+                    signal.wait( s, std::memory_order_acquire );
+                    continue;
+                }
+
+                // Collect blocks until the batch is large enough or the queue runs empty.
+                Size_T count = 0;
+
+                batch.clear();
+
+                while( (h != t) && (batch.size() < settings.batch_byte_count) )
+                {
+                    swap( block, slots[h & mask] );
+
+                    ++h;
+                    ++count;
+
+                    head.store( h, std::memory_order_release );
+
+                    batch += block;
+
+                    block.clear();
+
+                    if( h == t )
+                    {
+                        t = tail.load( std::memory_order_acquire );
+                    }
+                }
+
+                if( !failedQ.load( std::memory_order_relaxed ) )
+                {
+                    TimeInterval T_write (0);
+
+                    try
+                    {
+                        WriteBatch( batch );
+                    }
+                    catch( const std::exception & e )
+                    {
+                        // After a failure we keep consuming the blocks, so that the producer never waits forever.
+                        error = e.what();
+                        failedQ.store( true, std::memory_order_release );
+                    }
+
+                    T_write.Toc();
+
+                    write_time += T_write.Duration();
+                }
+
+                written.fetch_add( count, std::memory_order_release );
+                written.notify_all();
+            }
+
+            stream.close();
+        }
+
+    public:
+
+        static std::string ClassName()
+        {
+            return std::string("AsyncCodeWriter");
+        }
+
+    }; // class AsyncCodeWriter
+
+} // namespace Knoodle
@@ -6,6 +6,16 @@
 #include "AffineTransforms/ClangAffineTransform.hpp"
 #include "AffineTransforms/ClangQuaternionTransform.hpp"
 
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// For memory-mapped checkpoints.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 
 // TODO: Rotate DOFs on load or write.
 // TODO: Recenter polygon on load or write.
@@ -15,14 +25,6 @@
 
 // TODO: _Compute_ NodeRange more efficiently.
 
-// TODO: Update(p,q) -- Could this be faster?
-// TODO:    1. Start at the pivots, walk up to the root and track all the touched nodes;
-// TODO:       We can also learn this way which nodes need an update.
-// TODO:    2. Go down again and push the transforms out of the visited nodes.
-// TODO:    3. Grab the pivot vertex positions and compute the transform.
-// TODO:    4. Walk once again top down through the visited nodes and update their transforms.
-// TODO:    5. Walk from the pivots upwards and update the balls.
-
 
 namespace Knoodle
 {
@@ -33,6 +35,9 @@ namespace Knoodle
         bool countersQ                = false;   // debugging flag
         bool witnessesQ               = false;   // debugging flag
         bool manual_stackQ            = false;   // debugging flag
+        bool soa_ballsQ               = false;   // structure-of-arrays layout for the node balls
+        bool float_ballsQ             = false;   // float32 copies of the internal balls for the broad phase
+        bool telemetryQ               = false;   // histograms of pivot moves; see ClisbyTree/Telemetry.hpp
     };
     
     
@@ -59,6 +64,13 @@ namespace Knoodle
         static constexpr bool quaternionsQ  = clang_matrixQ && targs.quaternionsQ;
         static constexpr bool manual_stackQ = targs.manual_stackQ;
         static constexpr bool witnessesQ    = targs.witnessesQ;
+        static constexpr bool soa_ballsQ    = targs.soa_ballsQ;
+        static constexpr bool float_ballsQ  = targs.float_ballsQ && !SameQ<Real,float>;
+        
+        static_assert( !(soa_ballsQ && float_ballsQ), "The structure-of-arrays layout is not implemented for float32 balls." );
+        
+        // Whether the balls can be accessed by `NodeBallPtr` and `NodeCenterPtr`. Otherwise, only the copying accessors `ReadNodeBall`, `WriteNodeBall`, etc. are available.
+        static constexpr bool ball_ptrQ     = !soa_ballsQ && !float_ballsQ;
         
         using Base_T = CompleteBinaryTree<Int,true,true>;
         using DFS = Base_T::DFS;
@@ -89,7 +101,9 @@ namespace Knoodle
             RejectedByTree   = 4
         };
     
-        using FoldFlagCounts_T         = Tiny::Vector<5,LInt,std::underlying_type_t<FoldFlag_T>>;
+        static constexpr Size_T fold_flag_count = 5;
+        
+        using FoldFlagCounts_T         = Tiny::Vector<fold_flag_count,LInt,std::underlying_type_t<FoldFlag_T>>;
         
         using WitnessVector_T          = Tiny::Vector<2,Int,Int>;
         using WitnessCollector_T       = std::vector<Tiny::Vector<4,Int,Int>>;
@@ -103,8 +117,15 @@ namespace Knoodle
         using NodeTransformContainer_T = Tiny::VectorList_AoS<TransfDim,Real,Int>;
     
         // For center and radius.
+        // With soa_ballsQ, row k holds coordinate k of all centers and row AmbDim holds all radii. So the balls of sibling nodes are adjacent in each row.
+        // With float_ballsQ, `N_float_ball` holds float32 copies of the balls of the internal nodes, which the broad phase of the collision checks reads. They are derived from `N_ball`, which stays authoritative.
         static constexpr Int BallDim   = AmbDim + 1;
-        using NodeBallContainer_T      = Tiny::VectorList_AoS<BallDim,Real,Int>;
+        using NodeBallContainer_T      = std::conditional_t<
+            soa_ballsQ,
+            Tensor2<Real,Int>,
+            Tiny::VectorList_AoS<BallDim,Real,Int>
+        >;
+        using FloatBallContainer_T     = Tiny::VectorList_AoS<BallDim,float,Int>;
     
         using NodeSplitFlagVector_T    = Tiny::Vector<2,bool,Int>;
         using NodeSplitFlagMatrix_T    = Tiny::Matrix<2,2,bool,Int>;
@@ -134,7 +155,28 @@ namespace Knoodle
         };
 
         
-        static constexpr bool countersQ = targs.countersQ;
+        static constexpr bool countersQ  = targs.countersQ;
+        static constexpr bool telemetryQ = targs.telemetryQ;
+        
+        // The telemetry needs the number of ball overlap checks per collision check.
+        static constexpr bool overlap_countersQ = countersQ || telemetryQ;
+        
+        enum class UpdateMethod_T : std::int_fast8_t
+        {
+            Subtree = 0,
+            Paths   = 1
+        };
+        
+        static constexpr Size_T update_method_count = 2;
+        
+        // The part of the counts below that is caused by calls of `Update`.
+        struct UpdateCallCounters_T
+        {
+            Size_T calls          = 0;
+            Size_T mm             = 0;
+            Size_T mv             = 0;
+            Size_T load_transform = 0;
+        };
         
         struct CallCounters_T
         {
@@ -143,9 +185,65 @@ namespace Knoodle
             Size_T mm             = 0;
             Size_T mv             = 0;
             Size_T load_transform = 0;
+            
+            // Indexed by `UpdateMethod_T`.
+            std::array<UpdateCallCounters_T,update_method_count> update {};
         };
         
         
+        // Number of bins of the logarithmic histograms; bin k holds the values v with std::bit_width(v) == k.
+        static constexpr Size_T telemetry_bin_count = 64;
+        
+        using TelemetryHistogram_T = std::array<LInt,telemetry_bin_count>;
+        
+        /*!@brief Statistics of pivot moves that are only recorded if `telemetryQ` is set. See ClisbyTree/Telemetry.hpp.
+         */
+        
+        struct Telemetry_T
+        {
+            // Fold flags by pivot distance |p-q| (modulo the vertex count); logarithmic bins.
+            std::array<std::array<LInt,fold_flag_count>,telemetry_bin_count> distance_flags {};
+            
+            // Depth of the lowest common ancestor of the two colliding leaves, for moves rejected by the tree.
+            std::array<LInt,ToSize_T(max_depth) + 1> rejection_depths {};
+            
+            // Number of ball overlap checks per collision check of the tree; logarithmic bins.
+            TelemetryHistogram_T check_overlaps {};
+            LInt                 check_count   = 0;
+            LInt                 overlap_count = 0;
+            
+            // Wall-clock time between two accepted moves (including the rejected moves in between) in nanoseconds; logarithmic bins.
+            TelemetryHistogram_T accept_nanoseconds {};
+            LInt                 accept_count = 0;
+            double               accept_time  = 0;
+            
+            Telemetry_T & operator+=( cref<Telemetry_T> other )
+            {
+                for( Size_T k = 0; k < telemetry_bin_count; ++k )
+                {
+                    for( Size_T f = 0; f < fold_flag_count; ++f )
+                    {
+                        distance_flags[k][f] += other.distance_flags[k][f];
+                    }
+                    
+                    check_overlaps[k]     += other.check_overlaps[k];
+                    accept_nanoseconds[k] += other.accept_nanoseconds[k];
+                }
+                
+                for( Size_T k = 0; k < rejection_depths.size(); ++k )
+                {
+                    rejection_depths[k] += other.rejection_depths[k];
+                }
+                
+                check_count   += other.check_count;
+                overlap_count += other.overlap_count;
+                accept_count  += other.accept_count;
+                accept_time   += other.accept_time;
+                
+                return *this;
+            }
+        };
+        
         enum class UpdateFlag_T : std::int_fast8_t
         {
             DoNothing = 0,
@@ -161,7 +259,8 @@ namespace Knoodle
         :   Base_T                      { int_cast<Int>(vertex_count_)         }
         ,   N_transform                 { InternalNodeCount()                  }
         ,   N_state                     { InternalNodeCount(), NodeFlag_T::Id  }
-        ,   N_ball                      { NodeCount()                          }
+        ,   N_ball                      { CreateNodeBallContainer()            }
+        ,   N_float_ball                { CreateFloatBallContainer()           }
         ,   hard_sphere_diam            { static_cast<Real>(hard_sphere_diam_) }
         ,   hard_sphere_squared_diam    { hard_sphere_diam * hard_sphere_diam  }
         ,   level_moves_per_node        { this->ActualDepth() + Int(1)         }
@@ -180,7 +279,8 @@ namespace Knoodle
         :   Base_T                      { int_cast<Int>(vertex_count_)         }
         ,   N_transform                 { InternalNodeCount()                  }
         ,   N_state                     { InternalNodeCount(), NodeFlag_T::Id  }
-        ,   N_ball                      { NodeCount()                          }
+        ,   N_ball                      { CreateNodeBallContainer()            }
+        ,   N_float_ball                { CreateFloatBallContainer()           }
         ,   hard_sphere_diam            { static_cast<Real>(hard_sphere_diam_) }
         ,   hard_sphere_squared_diam    { hard_sphere_diam * hard_sphere_diam  }
         ,   level_moves_per_node        { this->ActualDepth() + Int(1)         }
@@ -200,7 +300,8 @@ namespace Knoodle
         :   Base_T                      { int_cast<Int>(vertex_count_)         }
         ,   N_transform                 { InternalNodeCount()                  }
         ,   N_state                     { InternalNodeCount(), NodeFlag_T::Id  }
-        ,   N_ball                      { NodeCount()                          }
+        ,   N_ball                      { CreateNodeBallContainer()            }
+        ,   N_float_ball                { CreateFloatBallContainer()           }
         ,   hard_sphere_diam            { static_cast<Real>(hard_sphere_diam_) }
         ,   hard_sphere_squared_diam    { hard_sphere_diam * hard_sphere_diam  }
         ,   random_engine               { prng                                 }
@@ -249,11 +350,26 @@ namespace Knoodle
         NodeTransformContainer_T N_transform;
         NodeFlagContainer_T      N_state;
         NodeBallContainer_T      N_ball;
+        FloatBallContainer_T     N_float_ball;
         
         Real hard_sphere_diam           = 0;
         Real hard_sphere_squared_diam   = 0;
         Real prescribed_edge_length     = 1;
         
+        // A pivot move that is evaluated without loading it into the tree; used by the speculative sampler.
+        struct PivotMove_T
+        {
+            Int p = 0;
+            Int q = 0;
+            Int p_shifted = 0;
+            Int q_shifted = 0;
+            Real theta = 0;
+            bool reflectQ = false;
+            bool mid_changedQ = false;
+            Transform_T transform;
+            WitnessVector_T witness {{-1,-1}};
+        };
+        
         Int p = 0;                      // Lower pivot index.
         Int q = 0;                      // Greater pivot index.
         Int p_shifted = 0;              // Lower pivot index.
@@ -269,6 +385,15 @@ namespace Knoodle
         PRNG_T random_engine;
         
         mutable CallCounters_T call_counters;
+        
+        Telemetry_T telemetry;
+        std::chrono::steady_clock::time_point telemetry_mark;
+    
+        Int collision_thread_count       = 1;
+        Int parallel_collision_threshold = 131072;
+        Int speculation_batch_size       = 1;
+    
+        UpdateMethod_T update_method = UpdateMethod_T::Subtree;
     
         bool mid_changedQ       = false;
         bool reflectQ           = false; // Whether we multiply the pivot move with -1.
@@ -287,10 +412,31 @@ namespace Knoodle
             N_state[node] = NodeFlag_T::Id;
         }
         
+        NodeBallContainer_T CreateNodeBallContainer() const
+        {
+            if constexpr ( soa_ballsQ )
+            {
+                return NodeBallContainer_T( BallDim, NodeCount() );
+            }
+            else
+            {
+                return NodeBallContainer_T( NodeCount() );
+            }
+        }
+        
+        FloatBallContainer_T CreateFloatBallContainer() const
+        {
+            return FloatBallContainer_T( float_ballsQ ? InternalNodeCount() : Int(0) );
+        }
+        
         void InitializeNodeFromVertex( const Int node, cptr<Real> x )
         {
-            copy_buffer<AmbDim>( x, NodeCenterPtr(node) );
-            NodeRadius(node) = 0;
+            Real B [BallDim];
+            
+            copy_buffer<AmbDim>( x, &B[0] );
+            B[AmbDim] = 0;
+            
+            ReadNodeBall( node, &B[0] );
         }
         
         void InitializeTransforms()
@@ -388,7 +534,10 @@ namespace Knoodle
 #include "ClisbyTree/CollisionChecks_Debug.hpp"
 #include "ClisbyTree/Random.hpp"
 #include "ClisbyTree/Fold.hpp"
+#include "ClisbyTree/FoldRandom_Speculative.hpp"
 #include "ClisbyTree/FoldRandomHierarchical.hpp"
+#include "ClisbyTree/Checkpoint.hpp"
+#include "ClisbyTree/Telemetry.hpp"
 //#include "ClisbyTree/Subdvide.hpp"
     
     public:
@@ -462,7 +611,7 @@ namespace Knoodle
     
         Size_T AllocatedByteCount() const
         {
-            return N_transform.AllocatedByteCount() + N_ball.AllocatedByteCount() + N_state.AllocatedByteCount() + Base_T::N_ranges.AllocatedByteCount();
+            return N_transform.AllocatedByteCount() + N_ball.AllocatedByteCount() + N_float_ball.AllocatedByteCount() + N_state.AllocatedByteCount() + Base_T::N_ranges.AllocatedByteCount();
         }
         
         template<int t0>
@@ -473,6 +622,7 @@ namespace Knoodle
                 std::string("<|")
                 + ( "\n" + ct_tabs<t1>) + TOOLS_MEM_DUMP_STRING(N_transform)
                 + (",\n" + ct_tabs<t1>) + TOOLS_MEM_DUMP_STRING(N_ball)
+                + (",\n" + ct_tabs<t1>) + TOOLS_MEM_DUMP_STRING(N_float_ball)
                 + (",\n" + ct_tabs<t1>) + TOOLS_MEM_DUMP_STRING(N_state)
                 + (",\n" + ct_tabs<t1>) + TOOLS_MEM_DUMP_STRING(Base_T::N_ranges)
                 + ( "\n" + ct_tabs<t0> + "|>");
@@ -489,6 +639,7 @@ namespace Knoodle
                 ClassName() + " allocations \n"
                 + "\t" + TOOLS_MEM_DUMP_STRING(N_transform)
                 + "\t" + TOOLS_MEM_DUMP_STRING(N_ball)
+                + "\t" + TOOLS_MEM_DUMP_STRING(N_float_ball)
                 + "\t" + TOOLS_MEM_DUMP_STRING(N_state)
                 + "\t" + TOOLS_MEM_DUMP_STRING(Base_T::N_ranges.AllocatedByteCount());
         }
@@ -510,6 +661,8 @@ namespace Knoodle
                 + "," + Tools::ToString(countersQ)
                 + "," + Tools::ToString(manual_stackQ)
                 + "," + Tools::ToString(witnessesQ)
+                + "," + Tools::ToString(telemetryQ)
+                + "," + Tools::ToString(float_ballsQ)
                 + ">";
         }
         
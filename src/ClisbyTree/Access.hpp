@@ -73,34 +73,196 @@ mptr<Real> NodeTransformPtr( const Int node )
     return N_transform.data(node);
 }
 
+// The pointer access to the balls is only available for the array-of-structures layout without float32 balls.
+
 cptr<Real> NodeCenterPtr( const Int node ) const
 {
+    static_assert( ball_ptrQ, "" );
     return N_ball.data(node);
 }
 
 mptr<Real> NodeCenterPtr( const Int node )
 {
+    static_assert( ball_ptrQ, "" );
     return N_ball.data(node);
 }
 
 cptr<Real> NodeBallPtr( const Int node ) const
 {
+    static_assert( ball_ptrQ, "" );
     return N_ball.data(node);
 }
 
 mptr<Real> NodeBallPtr( const Int node )
 {
+    static_assert( ball_ptrQ, "" );
     return N_ball.data(node);
 }
 
 Real NodeRadius( const Int node ) const
 {
-    return N_ball(node,AmbDim);
+    if constexpr ( soa_ballsQ )
+    {
+        return N_ball(AmbDim,node);
+    }
+    else
+    {
+        return N_ball(node,AmbDim);
+    }
 }
 
 mref<Real> NodeRadius( const Int node )
 {
-    return N_ball(node,AmbDim);
+    static_assert( !float_ballsQ, "" );
+    
+    if constexpr ( soa_ballsQ )
+    {
+        return N_ball(AmbDim,node);
+    }
+    else
+    {
+        return N_ball(node,AmbDim);
+    }
+}
+
+/*!@brief Rounds the ball of internal node `node` to float32 and stores it in `N_float_ball`. The radius is enlarged by the rounding error of the center and then rounded upwards, so the float32 ball always contains the ball in `N_ball`. Hence the broad phase of the collision checks stays conservative, and only the leaf tests (which are done in `Real`) decide about collisions.
+ *
+ * The ball in `N_ball` stays authoritative: the lazy transforms and `ComputeBall` work on it, and the float32 ball is derived from it anew each time. So the float32 radius exceeds the exact radius by one rounding of the center and one rounding of the radius, no matter how often the node has been transformed.
+ */
+
+void RoundFloatBall( const Int node )
+{
+    static_assert( float_ballsQ, "" );
+    
+    cptr<Real> B = N_ball.data(node);
+    
+    mptr<float> F = N_float_ball.data(node);
+    
+    Real e2 = 0;
+    
+    for( Int k = 0; k < AmbDim; ++k )
+    {
+        F[k] = static_cast<float>(B[k]);
+        
+        const Real delta = B[k] - static_cast<Real>(F[k]);
+        
+        e2 += delta * delta;
+    }
+    
+    const Real r = B[AmbDim] + std::sqrt(e2);
+    
+    float r_f = static_cast<float>(r);
+    
+    // Also if r_f == r, so that the (tiny) rounding errors in `r` are covered.
+    if( static_cast<Real>(r_f) <= r )
+    {
+        r_f = std::nextafter( r_f, std::numeric_limits<float>::infinity() );
+    }
+    
+    F[AmbDim] = r_f;
+}
+
+/*!@brief Copies the ball that the broad phase of the collision checks uses for `node` to B[0],...,B[AmbDim]. With float_ballsQ, this is the float32 ball of an internal node; otherwise, it is the ball of `node` itself.
+ */
+
+void WriteBroadPhaseBall( const Int node, mptr<Real> B ) const
+{
+    if constexpr ( float_ballsQ )
+    {
+        if( InternalNodeQ(node) )
+        {
+            cptr<float> F = N_float_ball.data(node);
+            
+            for( Int k = 0; k < BallDim; ++k )
+            {
+                B[k] = static_cast<Real>(F[k]);
+            }
+            
+            return;
+        }
+    }
+    
+    WriteNodeBall( node, B );
+}
+
+// Copies x[0],...,x[AmbDim-1] to the center of `node`.
+void ReadNodeCenter( const Int node, cptr<Real> x )
+{
+    if constexpr ( soa_ballsQ )
+    {
+        for( Int k = 0; k < AmbDim; ++k )
+        {
+            N_ball(k,node) = x[k];
+        }
+    }
+    else
+    {
+        copy_buffer<AmbDim>( x, N_ball.data(node) );
+        
+        if constexpr ( float_ballsQ )
+        {
+            if( InternalNodeQ(node) )
+            {
+                RoundFloatBall( node );
+            }
+        }
+    }
+}
+
+// Copies the center of `node` to x[0],...,x[AmbDim-1].
+void WriteNodeCenter( const Int node, mptr<Real> x ) const
+{
+    if constexpr ( soa_ballsQ )
+    {
+        for( Int k = 0; k < AmbDim; ++k )
+        {
+            x[k] = N_ball(k,node);
+        }
+    }
+    else
+    {
+        copy_buffer<AmbDim>( N_ball.data(node), x );
+    }
+}
+
+// Copies center and radius from B[0],...,B[AmbDim] to `node`.
+void ReadNodeBall( const Int node, cptr<Real> B )
+{
+    if constexpr ( soa_ballsQ )
+    {
+        for( Int k = 0; k < BallDim; ++k )
+        {
+            N_ball(k,node) = B[k];
+        }
+    }
+    else
+    {
+        copy_buffer<BallDim>( B, N_ball.data(node) );
+        
+        if constexpr ( float_ballsQ )
+        {
+            if( InternalNodeQ(node) )
+            {
+                RoundFloatBall( node );
+            }
+        }
+    }
+}
+
+// Copies center and radius of `node` to B[0],...,B[AmbDim].
+void WriteNodeBall( const Int node, mptr<Real> B ) const
+{
+    if constexpr ( soa_ballsQ )
+    {
+        for( Int k = 0; k < BallDim; ++k )
+        {
+            B[k] = N_ball(k,node);
+        }
+    }
+    else
+    {
+        copy_buffer<BallDim>( N_ball.data(node), B );
+    }
 }
 
 
@@ -117,7 +279,7 @@ void WriteVertexCoordinates( mptr<Real> X )
     {
         const Int node = PrimitiveNode(vertex);
 
-        copy_buffer<AmbDim>( NodeCenterPtr(node), &X[AmbDim*vertex] );
+        WriteNodeCenter( node, &X[AmbDim*vertex] );
     }
 }
 
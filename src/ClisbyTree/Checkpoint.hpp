@@ -0,0 +1,363 @@
+public:
+
+/*!@brief Header of a checkpoint file. The file consists of this header, followed by the node transforms, the node states, the node balls, the float32 balls of the internal nodes (only with `float_ballsQ`), the random state (`RandomState_T`), and an opaque block of user data (e.g., the state of the sampler that owns the tree). All blocks start at multiples of 64 bytes, so a mapped file can be copied block by block into the containers.
+ */
+
+struct CheckpointHeader_T
+{
+    char           magic [16];
+    std::uint64_t  version;
+    std::uint64_t  real_byte_count;
+    std::uint64_t  int_byte_count;
+    std::uint64_t  transform_dim;
+    std::uint64_t  ball_dim;
+    std::uint64_t  soa_ballsQ;
+    std::uint64_t  float_ballsQ;
+    std::uint64_t  vertex_count;
+    std::uint64_t  transform_offset;
+    std::uint64_t  state_offset;
+    std::uint64_t  ball_offset;
+    std::uint64_t  float_ball_offset;
+    std::uint64_t  random_offset;
+    std::uint64_t  random_byte_count;
+    std::uint64_t  user_offset;
+    std::uint64_t  user_byte_count;
+    std::uint64_t  byte_count;
+    double         hard_sphere_diam;
+    double         prescribed_edge_length;
+    CallCounters_T call_counters;
+    char           prng [256]; // Decimal representation of the pcg64 state; only for inspection, the random state block is authoritative.
+};
+
+static constexpr char checkpoint_magic [16] = "KnoodleClisby";
+
+static constexpr std::uint64_t checkpoint_version = 4;
+
+// The random state is stored byte by byte; it contains the engine and the distributions (some of which cache values between draws).
+static_assert( std::is_trivially_copyable_v<RandomState_T> );
+
+/*!@brief Writes the complete state of the tree to `file`: the (lazily propagated) node transforms and node states, the node balls (which contain the vertex coordinates), the random engine together with the distributions (see `SaveRandomState`), and the call counters. The block `user_data` of size `user_byte_count` is appended verbatim.
+ *
+ * The data is first written to a temporary file which then replaces `file`. So if the process is killed while writing, the previous checkpoint stays intact.
+ */
+
+void WriteCheckpoint(
+    cref<std::filesystem::path> file,
+    cptr<std::byte> user_data     = nullptr,
+    const Size_T user_byte_count = 0
+) const
+{
+    TOOLS_PTIMER(timer,MethodName("WriteCheckpoint"));
+
+    CheckpointHeader_T h {};
+
+    std::memcpy( &h.magic[0], &checkpoint_magic[0], sizeof(h.magic) );
+
+    h.version                = checkpoint_version;
+    h.real_byte_count        = sizeof(Real);
+    h.int_byte_count         = sizeof(Int);
+    h.transform_dim          = static_cast<std::uint64_t>(TransfDim);
+    h.ball_dim               = static_cast<std::uint64_t>(BallDim);
+    h.soa_ballsQ             = soa_ballsQ;
+    h.float_ballsQ           = float_ballsQ;
+    h.vertex_count           = static_cast<std::uint64_t>(VertexCount());
+    h.random_byte_count      = sizeof(RandomState_T);
+    h.user_byte_count        = user_byte_count;
+    h.hard_sphere_diam       = static_cast<double>(hard_sphere_diam);
+    h.prescribed_edge_length = static_cast<double>(prescribed_edge_length);
+    h.call_counters          = call_counters;
+
+    SetCheckpointLayout( h );
+
+    {
+        std::stringstream s;
+
+        s << random_engine;
+
+        const std::string str = s.str();
+
+        if( str.size() >= sizeof(h.prng) )
+        {
+            throw std::runtime_error(
+                ClassName()+"::WriteCheckpoint: State of random engine is too long."
+            );
+        }
+
+        std::memcpy( &h.prng[0], str.data(), str.size() );
+    }
+
+    const RandomState_T random_state = SaveRandomState();
+
+    const std::filesystem::path tmp_file ( file.string() + ".tmp" );
+
+    {
+        std::ofstream s (
+            tmp_file, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc
+        );
+
+        if( !s )
+        {
+            throw std::runtime_error(
+                ClassName()+"::WriteCheckpoint: Failed to create file \"" + tmp_file.string() + "\"."
+            );
+        }
+
+        const char zeroes [64] = {};
+
+        std::uint64_t pos = 0;
+
+        // Pads with zeroes up to `offset`, then writes the block.
+        auto put = [&s,&zeroes,&pos](
+            const std::uint64_t offset, cptr<void> ptr, const std::uint64_t byte_count
+        )
+        {
+            while( pos < offset )
+            {
+                const std::uint64_t count = Min( std::uint64_t(64), offset - pos );
+                s.write( &zeroes[0], static_cast<std::streamsize>(count) );
+                pos += count;
+            }
+
+            if( byte_count > std::uint64_t(0) )
+            {
+                s.write(
+                    static_cast<const char *>(ptr), static_cast<std::streamsize>(byte_count)
+                );
+                pos += byte_count;
+            }
+        };
+
+        put( 0,                   &h,                  sizeof(h)                  );
+        put( h.transform_offset,  N_transform.data(),  CheckpointTransformBytes() );
+        put( h.state_offset,      N_state.data(),      CheckpointStateBytes()     );
+        put( h.ball_offset,       N_ball.data(),       CheckpointBallBytes()      );
+        put( h.float_ball_offset, N_float_ball.data(), CheckpointFloatBallBytes() );
+        put( h.random_offset,     &random_state,       h.random_byte_count        );
+        put( h.user_offset,       user_data,           user_byte_count            );
+
+        s.flush();
+
+        if( !s )
+        {
+            throw std::runtime_error(
+                ClassName()+"::WriteCheckpoint: Failed to write to file \"" + tmp_file.string() + "\"."
+            );
+        }
+    }
+
+    std::filesystem::rename( tmp_file, file );
+}
+
+/*!@brief Creates a tree from the checkpoint `file` written by `WriteCheckpoint` and writes the user data block to `user_data`. The file is mapped into memory and its blocks are copied directly into the containers; in particular, neither `ReadVertexCoordinates` nor any ball computation is run. The tree continues exactly where the writing tree stopped.
+ *
+ * Settings that are not part of the state (random methods for angles and pivots, thread counts, etc.) have to be set again by the caller. Setting a random method replaces its distribution by a fresh one; so the caller has to save the random state (`SaveRandomState`) before and restore it (`RestoreRandomState`) afterwards.
+ */
+
+static ClisbyTree ReadCheckpoint(
+    cref<std::filesystem::path> file, mref<std::vector<std::byte>> user_data
+)
+{
+    TOOLS_PTIMER(timer,MethodName("ReadCheckpoint"));
+
+    auto fail = [&file]( const std::string & reason )
+    {
+        throw std::runtime_error(
+            ClassName()+"::ReadCheckpoint: File \"" + file.string() + "\" " + reason + "."
+        );
+    };
+
+    const int fd = ::open( file.c_str(), O_RDONLY );
+
+    if( fd < 0 )
+    {
+        fail("could not be opened");
+    }
+
+    struct stat info;
+
+    if( ::fstat( fd, &info ) != 0 )
+    {
+        ::close(fd);
+        fail("could not be inspected");
+    }
+
+    const Size_T file_byte_count = static_cast<Size_T>(info.st_size);
+
+    if( file_byte_count < sizeof(CheckpointHeader_T) )
+    {
+        ::close(fd);
+        fail("is too small to be a checkpoint");
+    }
+
+    void * map = ::mmap( nullptr, file_byte_count, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    ::close(fd);
+
+    if( map == MAP_FAILED )
+    {
+        fail("could not be mapped into memory");
+    }
+
+    // Unmaps the file however we leave this function.
+    struct Unmap_T
+    {
+        void * ptr;
+        Size_T byte_count;
+
+        ~Unmap_T()
+        {
+            (void)::munmap( ptr, byte_count );
+        }
+    };
+
+    const Unmap_T unmap { map, file_byte_count };
+
+    cptr<std::byte> data = static_cast<cptr<std::byte>>(map);
+
+    CheckpointHeader_T h;
+
+    std::memcpy( &h, data, sizeof(h) );
+
+    if( std::memcmp( &h.magic[0], &checkpoint_magic[0], sizeof(h.magic) ) != 0 )
+    {
+        fail("is not a checkpoint of " + ClassName());
+    }
+
+    if( h.version != checkpoint_version )
+    {
+        fail("has unsupported version " + ToString(h.version));
+    }
+
+    if(
+        (h.real_byte_count != sizeof(Real))
+        ||
+        (h.int_byte_count  != sizeof(Int))
+        ||
+        (h.transform_dim   != static_cast<std::uint64_t>(TransfDim))
+        ||
+        (h.ball_dim        != static_cast<std::uint64_t>(BallDim))
+        ||
+        (h.soa_ballsQ      != static_cast<std::uint64_t>(soa_ballsQ))
+        ||
+        (h.float_ballsQ    != static_cast<std::uint64_t>(float_ballsQ))
+    )
+    {
+        fail("was written by an incompatible instance of " + ClassName());
+    }
+
+    if( h.random_byte_count != sizeof(RandomState_T) )
+    {
+        fail("was written by an incompatible instance of " + ClassName());
+    }
+
+    if( (h.vertex_count < std::uint64_t(2)) || (h.byte_count > file_byte_count) )
+    {
+        fail("is truncated or corrupted");
+    }
+
+    ClisbyTree T ( h );
+
+    {
+        CheckpointHeader_T g = h;
+
+        T.SetCheckpointLayout( g );
+
+        if(
+            (g.transform_offset != h.transform_offset)
+            ||
+            (g.state_offset     != h.state_offset)
+            ||
+            (g.ball_offset      != h.ball_offset)
+            ||
+            (g.float_ball_offset != h.float_ball_offset)
+            ||
+            (g.random_offset    != h.random_offset)
+            ||
+            (g.user_offset      != h.user_offset)
+            ||
+            (g.byte_count       != h.byte_count)
+        )
+        {
+            fail("is corrupted");
+        }
+    }
+
+    std::memcpy( T.N_transform.data(), data + h.transform_offset, T.CheckpointTransformBytes() );
+    std::memcpy( T.N_state.data(),     data + h.state_offset,     T.CheckpointStateBytes()     );
+    std::memcpy( T.N_ball.data(),      data + h.ball_offset,      T.CheckpointBallBytes()      );
+    
+    if constexpr ( float_ballsQ )
+    {
+        std::memcpy( T.N_float_ball.data(), data + h.float_ball_offset, T.CheckpointFloatBallBytes() );
+    }
+
+    {
+        // Trivially copyable, so we may overwrite any instance byte by byte.
+        RandomState_T random_state = T.SaveRandomState();
+
+        std::memcpy( &random_state, data + h.random_offset, sizeof(RandomState_T) );
+
+        T.RestoreRandomState( random_state );
+    }
+
+    user_data.assign(
+        data + h.user_offset, data + h.user_offset + h.user_byte_count
+    );
+
+    return T;
+}
+
+private:
+
+// Allocates the containers for the checkpoint `h`, but does not fill them.
+explicit ClisbyTree( cref<CheckpointHeader_T> h )
+:   Base_T                      { int_cast<Int>(h.vertex_count)               }
+,   N_transform                 { InternalNodeCount()                         }
+,   N_state                     { InternalNodeCount()                         }
+,   N_ball                      { CreateNodeBallContainer()                   }
+,   N_float_ball                { CreateFloatBallContainer()                  }
+,   hard_sphere_diam            { static_cast<Real>(h.hard_sphere_diam)       }
+,   hard_sphere_squared_diam    { hard_sphere_diam * hard_sphere_diam         }
+,   prescribed_edge_length      { static_cast<Real>(h.prescribed_edge_length) }
+,   call_counters               ( h.call_counters                             )
+,   level_moves_per_node        { this->ActualDepth() + Int(1)                }
+{}
+
+Size_T CheckpointTransformBytes() const
+{
+    return ToSize_T(InternalNodeCount()) * ToSize_T(TransfDim) * sizeof(Real);
+}
+
+Size_T CheckpointStateBytes() const
+{
+    return ToSize_T(InternalNodeCount()) * sizeof(NodeFlag_T);
+}
+
+Size_T CheckpointBallBytes() const
+{
+    return ToSize_T(NodeCount()) * ToSize_T(BallDim) * sizeof(Real);
+}
+
+Size_T CheckpointFloatBallBytes() const
+{
+    return ToSize_T(float_ballsQ ? InternalNodeCount() : Int(0)) * ToSize_T(BallDim) * sizeof(float);
+}
+
+// Computes the offsets of the blocks from the sizes of the containers and `h.user_byte_count`.
+void SetCheckpointLayout( mref<CheckpointHeader_T> h ) const
+{
+    auto align = []( const std::uint64_t offset )
+    {
+        constexpr std::uint64_t alignment = 64;
+
+        return ((offset + alignment - 1) / alignment) * alignment;
+    };
+
+    h.transform_offset  = align( sizeof(CheckpointHeader_T) );
+    h.state_offset      = align( h.transform_offset  + CheckpointTransformBytes() );
+    h.ball_offset       = align( h.state_offset      + CheckpointStateBytes()     );
+    h.float_ball_offset = align( h.ball_offset       + CheckpointBallBytes()      );
+    h.random_offset     = align( h.float_ball_offset + CheckpointFloatBallBytes() );
+    h.user_offset       = align( h.random_offset     + h.random_byte_count        );
+    h.byte_count        = h.user_offset + h.user_byte_count;
+}
@@ -1,6 +1,7 @@
 #include "CollisionQ_Reference.hpp"
 #include "CollisionQ_ManualStack.hpp"
 #include "SubtreesCollideQ_Recursive.hpp"
+#include "CollisionQ_Parallel.hpp"
 
 
 public:
@@ -15,7 +16,18 @@ bool CollisionQ()
         
     bool result;
     
-    if constexpr ( manual_stackQ )
+    if( ParallelCollisionQ() )
+    {
+        if( mid_changedQ )
+        {
+            result = CollisionQ_Parallel<true,full_checkQ>();
+        }
+        else
+        {
+            result = CollisionQ_Parallel<false,full_checkQ>();
+        }
+    }
+    else if constexpr ( manual_stackQ )
     {
         if( mid_changedQ )
         {
@@ -119,7 +131,23 @@ void ComputeBall( const Int node )
 {
     auto [L,R] = Children(node);
     
-    MergeBalls( NodeBallPtr(L), NodeBallPtr(R), NodeBallPtr(node) );
+    if constexpr ( !ball_ptrQ )
+    {
+        Real B_L [BallDim];
+        Real B_R [BallDim];
+        Real B   [BallDim];
+        
+        WriteNodeBall( L, &B_L[0] );
+        WriteNodeBall( R, &B_R[0] );
+        
+        MergeBalls( &B_L[0], &B_R[0], &B[0] );
+        
+        ReadNodeBall( node, &B[0] );
+    }
+    else
+    {
+        MergeBalls( NodeBallPtr(L), NodeBallPtr(R), NodeBallPtr(node) );
+    }
 }
 
 static constexpr Real NodeCenterSquaredDistance(
@@ -161,7 +189,7 @@ bool BallsCollideQ(
     const Real diam
 )
 {
-    if constexpr ( countersQ )
+    if constexpr ( overlap_countersQ )
     {
         ++call_counters.overlap;
     }
@@ -175,62 +203,176 @@ bool BallsCollideQ(
 
 bool BallsCollideQ( const Int node_0, const Int node_1) const
 {
-    if constexpr ( countersQ )
+    if constexpr ( overlap_countersQ )
     {
         ++call_counters.overlap;
     }
     
-    return BallsCollideQ( NodeBallPtr(node_0), NodeBallPtr(node_1), hard_sphere_diam );
+    if constexpr ( float_ballsQ )
+    {
+        Real B_0 [BallDim];
+        Real B_1 [BallDim];
+        
+        WriteBroadPhaseBall( node_0, &B_0[0] );
+        WriteBroadPhaseBall( node_1, &B_1[0] );
+        
+        return BallsCollideQ( &B_0[0], &B_1[0], hard_sphere_diam );
+    }
+    else if constexpr ( !ball_ptrQ )
+    {
+        const Real d2 = SquaredDistance( NodeCenter(node_0), NodeCenter(node_1) );
+        
+        const Real threshold = hard_sphere_diam + NodeRadius(node_0) + NodeRadius(node_1);
+        
+        return (d2 < threshold * threshold);
+    }
+    else
+    {
+        return BallsCollideQ( NodeBallPtr(node_0), NodeBallPtr(node_1), hard_sphere_diam );
+    }
+}
+
+/*!@brief Tests the balls of the `m` adjacent nodes `i,...,i+m-1` against the balls of the `n` adjacent nodes `j,...,j+n-1` and writes the result for the pair `(i+k,j+l)` to `C[n * k + l]`.
+ *
+ * The recursive collision check uses this to test both children of a node against both children of another node (m = n = 2) or a node against both children of another node (m = 1 or n = 1). Sibling nodes are adjacent, and with the structure-of-arrays layout their entries are adjacent in each row of `N_ball`. So each row is read by one contiguous load of `m` entries and one of `n` entries; the `m * n` pairs are formed in registers and tested in the lanes of a single vector register. This replaces `m * n` data-dependent branches by one.
+ *
+ * The recursion never uses more than 4 lanes. The balls of a node are only valid once the transforms of its ancestors have been pushed into it, and the recursion pushes only the children of the two nodes it is splitting. Testing 8 pairs at once (e.g., both children of one node against the 4 grandchildren of another) would need the pushes into both children of the other node before we know whether the recursion visits them. Each such push costs a matrix-matrix product, much more than the ball tests it would batch, and it would change which transforms are stored, so the tree would no longer agree bit for bit with the array-of-structures layout.
+ */
+
+template<Size_T m, Size_T n>
+void BallsCollideQ( const Int i, const Int j, mptr<bool> C ) const
+{
+    static_assert( (m >= Size_T(1)) && (n >= Size_T(1)), "" );
+    
+    constexpr Size_T W = m * n;
+    
+    if constexpr ( soa_ballsQ && VectorizableQ<Real> )
+    {
+        using V_T = vec_T<W,Real>;
+        
+        if constexpr ( overlap_countersQ )
+        {
+            call_counters.overlap += W;
+        }
+        
+        // Broadcasts the m entries x[i],...,x[i+m-1] and the n entries x[j],...,x[j+n-1] to the W lanes.
+        auto load = [i,j]( cptr<Real> x, mref<V_T> u, mref<V_T> v )
+        {
+            Real s [m];
+            Real t [n];
+            
+            copy_buffer<m>( &x[i], &s[0] );
+            copy_buffer<n>( &x[j], &t[0] );
+            
+            for( Size_T k = 0; k < m; ++k )
+            {
+                for( Size_T l = 0; l < n; ++l )
+                {
+                    u[n * k + l] = s[k];
+                    v[n * k + l] = t[l];
+                }
+            }
+        };
+        
+        V_T d2 = Real(0);
+        
+        for( Int k = 0; k < AmbDim; ++k )
+        {
+            V_T u;
+            V_T v;
+            
+            load( N_ball.data(k), u, v );
+            
+            const V_T delta = u - v;
+            
+            d2 += delta * delta;
+        }
+        
+        V_T r_i;
+        V_T r_j;
+        
+        load( N_ball.data(AmbDim), r_i, r_j );
+        
+        const V_T threshold = hard_sphere_diam + r_i + r_j;
+        
+        const auto mask = (d2 < threshold * threshold);
+        
+        for( Size_T w = 0; w < W; ++w )
+        {
+            C[w] = (mask[w] != 0);
+        }
+    }
+    else
+    {
+        for( Size_T k = 0; k < m; ++k )
+        {
+            for( Size_T l = 0; l < n; ++l )
+            {
+                C[n * k + l] = BallsCollideQ( i + static_cast<Int>(k), j + static_cast<Int>(l) );
+            }
+        }
+    }
 }
 
 FoldFlag_T CheckJoints()
+{
+    return CheckJoints( p, q, mid_changedQ, transform, witness );
+}
+
+FoldFlag_T CheckJoints(
+    const Int p_,
+    const Int q_,
+    const bool mid_changedQ_,
+    cref<Transform_T> transform_,
+    mref<WitnessVector_T> witness_
+) const
 {
     const Int n = VertexCount();
     
     {
-        const Int p_prev = (p == Int(0))     ? (n - Int(1)) : (p - Int(1));
-        const Int p_next = (p + Int(1) == n) ? Int(0)       : (p + Int(1));
+        const Int p_prev = (p_ == Int(0))     ? (n - Int(1)) : (p_ - Int(1));
+        const Int p_next = (p_ + Int(1) == n) ? Int(0)       : (p_ + Int(1));
         
         Vector_T X_p_prev = VertexCoordinates(p_prev);
         Vector_T X_p_next = VertexCoordinates(p_next);
         
-        if( mid_changedQ )
+        if( mid_changedQ_ )
         {
-            X_p_next = transform(X_p_next);
+            X_p_next = transform_(X_p_next);
         }
         else
         {
-            X_p_prev = transform(X_p_prev);
+            X_p_prev = transform_(X_p_prev);
         }
         
         if( SquaredDistance(X_p_next,X_p_prev) <= hard_sphere_squared_diam )
         {
-            witness[0] = p_prev;
-            witness[1] = p_next;
+            witness_[0] = p_prev;
+            witness_[1] = p_next;
             return FoldFlag_T::RejectedByJoint0;
         }
     }
     
     {
-        const Int q_prev = (q == Int(0))     ? (n - Int(1)) : (q - Int(1));
-        const Int q_next = (q + Int(1) == n) ? Int(0)       : (q + Int(1));
+        const Int q_prev = (q_ == Int(0))     ? (n - Int(1)) : (q_ - Int(1));
+        const Int q_next = (q_ + Int(1) == n) ? Int(0)       : (q_ + Int(1));
         
         Vector_T X_q_prev = VertexCoordinates(q_prev);
         Vector_T X_q_next = VertexCoordinates(q_next);
         
-        if( mid_changedQ )
+        if( mid_changedQ_ )
         {
-            X_q_prev = transform(X_q_prev);
+            X_q_prev = transform_(X_q_prev);
         }
         else
         {
-            X_q_next = transform(X_q_next);
+            X_q_next = transform_(X_q_next);
         }
         
         if( SquaredDistance(X_q_next,X_q_prev) <= hard_sphere_squared_diam )
         {
-            witness[0] = q_prev;
-            witness[1] = q_next;
+            witness_[0] = q_prev;
+            witness_[1] = q_next;
             return FoldFlag_T::RejectedByJoint1;
         }
     }
@@ -0,0 +1,451 @@
+public:
+
+void SetCollisionThreadCount( const Int thread_count_ )
+{
+    collision_thread_count = Max( Int(1), thread_count_ );
+}
+
+Int CollisionThreadCount() const
+{
+    return collision_thread_count;
+}
+
+void SetParallelCollisionThreshold( const Int threshold )
+{
+    parallel_collision_threshold = Max( Int(1), threshold );
+}
+
+Int ParallelCollisionThreshold() const
+{
+    return parallel_collision_threshold;
+}
+
+/*!@brief Decides whether `CollisionQ` uses the parallel query for the currently loaded pivot move. The work of a check grows with the size of the smaller of the two subtrees induced by the pivots, so we use the threads only if this part has at least `ParallelCollisionThreshold()` vertices.
+ */
+
+bool ParallelCollisionQ() const
+{
+    if( collision_thread_count <= Int(1) )
+    {
+        return false;
+    }
+
+    const Int mid_size = q - p - Int(1);
+    const Int rem_size = VertexCount() - mid_size - Int(2);
+
+    return Min( mid_size, rem_size ) >= parallel_collision_threshold;
+}
+
+private:
+
+// A node, the center of its ball in absolute coordinates, and the transformation that maps the data stored in its children to absolute coordinates. This allows us to traverse the tree without pushing any transformations, so that several threads can traverse it concurrently. `movedQ` tells whether the pivot transformation of a move that is not loaded into the tree has already been applied to the node.
+struct AbsoluteNode_T
+{
+    Int         node;
+    Vector_T    center;
+    Transform_T G;
+    bool        movedQ = false;
+};
+
+// A single node is checked for collisions within its subtree; a pair of nodes is checked for collisions between the two subtrees.
+struct CollisionTask_T
+{
+    AbsoluteNode_T i;
+    AbsoluteNode_T j;
+    bool pairQ;
+};
+
+PivotMove_T LoadedPivotMove() const
+{
+    PivotMove_T m;
+
+    m.p            = p;
+    m.q            = q;
+    m.p_shifted    = p_shifted;
+    m.q_shifted    = q_shifted;
+    m.theta        = theta;
+    m.reflectQ     = reflectQ;
+    m.mid_changedQ = mid_changedQ;
+    m.transform    = transform;
+
+    return m;
+}
+
+// `G_parent` must map the data stored in `node` to absolute coordinates. If `P` is not a null pointer, then `P` is applied afterwards.
+AbsoluteNode_T AbsoluteNode(
+    cref<Transform_T> G_parent, const Int node, cptr<Transform_T> P = nullptr
+) const
+{
+    AbsoluteNode_T a;
+
+    a.node   = node;
+    a.center = G_parent( NodeCenter(node) );
+    a.movedQ = (P != nullptr);
+
+    if( P != nullptr )
+    {
+        a.center = (*P)( a.center );
+    }
+
+    if( InternalNodeQ(node) )
+    {
+        Real buffer [TransfDim];
+
+        NodeFlag_T flag = NodeFlag(node);
+
+        if( flag == NodeFlag_T::NonId )
+        {
+            copy_buffer<TransfDim>( NodeTransformPtr(node), &buffer[0] );
+        }
+
+        (void)G_parent.TransformTransform( &buffer[0], flag );
+
+        if( P != nullptr )
+        {
+            (void)P->TransformTransform( &buffer[0], flag );
+        }
+
+        a.G = Transform_T( &buffer[0], flag );
+    }
+    else
+    {
+        a.G = Transform_T::IdentityTransform();
+    }
+
+    return a;
+}
+
+bool AbsoluteBallsCollideQ(
+    cref<AbsoluteNode_T> a, cref<AbsoluteNode_T> b, mref<Size_T> overlap_count
+) const
+{
+    ++overlap_count;
+
+    const Real d2 = SquaredDistance( a.center, b.center );
+
+    const Real threshold = hard_sphere_diam + NodeRadius(a.node) + NodeRadius(b.node);
+
+    return (d2 < threshold * threshold);
+}
+
+// Same as NodeSplitFlagVector<mQ>(node), but with respect to the pivot move `m`.
+template<bool mQ>
+NodeSplitFlagVector_T NodeSplitFlagVector( const Int node, cref<PivotMove_T> m ) const
+{
+    auto [begin,end] = NodeRange(node);
+
+    const bool not_only_midQ = (begin < m.p_shifted) || (end   > m.q_shifted);
+    const bool not_no_midQ   = (end   > m.p_shifted) && (begin < m.q_shifted);
+
+    if constexpr ( mQ )
+    {
+        return NodeSplitFlagVector_T({not_only_midQ,not_no_midQ});
+    }
+    else
+    {
+        return NodeSplitFlagVector_T({not_no_midQ,not_only_midQ});
+    }
+}
+
+// Writes the children of `a` to `c` and their split flags to `f`. A leaf node stands for itself.
+// f[k][0]: whether child k contains unchanged vertices.
+// f[k][1]: whether child k contains changed vertices.
+// If `virtualQ` is true, then the move `m` is not loaded into the tree; instead its transformation is applied to each child that contains only changed vertices and whose parent has not been moved yet.
+template<bool mQ, bool fcQ, bool virtualQ>
+Int SplitAbsoluteNode(
+    cref<AbsoluteNode_T> a,
+    cref<PivotMove_T>    m,
+    mptr<AbsoluteNode_T> c,
+    bool (&f) [2][2]
+) const
+{
+    static_assert( !(fcQ && virtualQ), "A full check of a move that is not loaded is not supported." );
+
+    if( InternalNodeQ(a.node) )
+    {
+        auto [L,R] = Children(a.node);
+
+        if constexpr( fcQ )
+        {
+            f[0][0] = true; f[0][1] = true;
+            f[1][0] = true; f[1][1] = true;
+        }
+        else
+        {
+            const NodeSplitFlagVector_T F_L = NodeSplitFlagVector<mQ>(L,m);
+            const NodeSplitFlagVector_T F_R = NodeSplitFlagVector<mQ>(R,m);
+
+            f[0][0] = F_L[0]; f[0][1] = F_L[1];
+            f[1][0] = F_R[0]; f[1][1] = F_R[1];
+        }
+
+        if constexpr( virtualQ )
+        {
+            const bool move_L_Q = !a.movedQ && !f[0][0] && f[0][1];
+            const bool move_R_Q = !a.movedQ && !f[1][0] && f[1][1];
+
+            c[0] = AbsoluteNode( a.G, L, move_L_Q ? &m.transform : nullptr );
+            c[1] = AbsoluteNode( a.G, R, move_R_Q ? &m.transform : nullptr );
+
+            c[0].movedQ = a.movedQ || move_L_Q;
+            c[1].movedQ = a.movedQ || move_R_Q;
+        }
+        else
+        {
+            c[0] = AbsoluteNode( a.G, L );
+            c[1] = AbsoluteNode( a.G, R );
+        }
+
+        return Int(2);
+    }
+    else
+    {
+        c[0] = a;
+
+        if constexpr( fcQ )
+        {
+            f[0][0] = true; f[0][1] = true;
+        }
+        else
+        {
+            const NodeSplitFlagVector_T F = NodeSplitFlagVector<mQ>(a.node,m);
+
+            f[0][0] = F[0]; f[0][1] = F[1];
+        }
+
+        return Int(1);
+    }
+}
+
+/*!@brief Pushes the subtasks of `task` onto `out`. Subtasks of pairs are pushed in reverse priority, so that a stack pops the pairs closest to the pivots first. Returns `true` if `task` is a pair of overlapping leaf nodes that are not neighbors; then the witness is written to `k` and `l`.
+ */
+
+template<bool mQ, bool fcQ, bool virtualQ = false>
+bool ExpandCollisionTask(
+    cref<CollisionTask_T> task,
+    cref<PivotMove_T> m,
+    mref<std::vector<CollisionTask_T>> out,
+    mref<Int> k,
+    mref<Int> l,
+    mref<Size_T> overlap_count
+) const
+{
+    AbsoluteNode_T c_i [2];
+    AbsoluteNode_T c_j [2];
+    bool f_i [2][2];
+    bool f_j [2][2];
+
+    if( !task.pairQ )
+    {
+        if( !InternalNodeQ(task.i.node) )
+        {
+            return false;
+        }
+
+        (void)SplitAbsoluteNode<mQ,fcQ,virtualQ>( task.i, m, &c_i[0], f_i );
+
+        if( ( (f_i[0][0] && f_i[1][1]) || (f_i[0][1] && f_i[1][0]) ) && AbsoluteBallsCollideQ(c_i[0],c_i[1],overlap_count) )
+        {
+            out.push_back( CollisionTask_T{ c_i[0], c_i[1], true } );
+        }
+
+        if( f_i[1][0] && f_i[1][1] )
+        {
+            out.push_back( CollisionTask_T{ c_i[1], c_i[1], false } );
+        }
+
+        if( f_i[0][0] && f_i[0][1] )
+        {
+            out.push_back( CollisionTask_T{ c_i[0], c_i[0], false } );
+        }
+
+        return false;
+    }
+
+    const bool i_internalQ = InternalNodeQ(task.i.node);
+    const bool j_internalQ = InternalNodeQ(task.j.node);
+
+    if( !i_internalQ && !j_internalQ )
+    {
+        // Nodes i and j are overlapping leaf nodes.
+
+        // Rule out that tiny distance errors of neighboring vertices cause problems.
+        const Int a = NodeBegin(task.i.node);
+        const Int b = NodeBegin(task.j.node);
+
+        const Int delta = Abs(a-b);
+
+        if( Min( delta, VertexCount() - delta ) > Int(1) )
+        {
+            k = a;
+            l = b;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    const Int i_count = SplitAbsoluteNode<mQ,fcQ,virtualQ>( task.i, m, &c_i[0], f_i );
+    const Int j_count = SplitAbsoluteNode<mQ,fcQ,virtualQ>( task.j, m, &c_j[0], f_j );
+
+    // Same priorities as in SubtreesCollideQ_Recursive, reversed: (0,1) and (1,0) take us closer to the pivots.
+    constexpr Int order [4][2] = { {1,1}, {0,0}, {1,0}, {0,1} };
+
+    for( Int r = 0; r < Int(4); ++r )
+    {
+        const Int a = order[r][0];
+        const Int b = order[r][1];
+
+        if( (a >= i_count) || (b >= j_count) )
+        {
+            continue;
+        }
+
+        if(
+            ( (f_i[a][0] && f_j[b][1]) || (f_i[a][1] && f_j[b][0]) )
+            &&
+            AbsoluteBallsCollideQ(c_i[a],c_j[b],overlap_count)
+        )
+        {
+            out.push_back( CollisionTask_T{ c_i[a], c_j[b], true } );
+        }
+    }
+
+    return false;
+}
+
+/*!@brief Task-parallel version of the collision check. The top levels of the recursion are expanded breadth-first on the calling thread until there are about 8 tasks per thread. Then the threads grab tasks from a shared counter and process them depth-first. As soon as one thread finds a witness, all threads stop. So which witness is reported depends on the timing of the threads; only the result is deterministic.
+ *
+ * In contrast to the serial checks, this traversal does not push any transformations down the tree; instead, each task carries the composed transformations of its nodes. So the tree is only read and the threads do not race.
+ */
+
+template<bool mQ, bool fcQ = false>
+bool CollisionQ_Parallel()
+{
+    TOOLS_PTIMER(timer,MethodName("CollisionQ_Parallel"));
+
+    const Size_T thread_count = ToSize_T(collision_thread_count);
+    const Size_T task_target  = Size_T(8) * thread_count;
+
+    const PivotMove_T m = LoadedPivotMove();
+
+    std::vector<CollisionTask_T> tasks;
+    tasks.reserve( Size_T(4) * task_target );
+
+    {
+        const AbsoluteNode_T root = AbsoluteNode( Transform_T::IdentityTransform(), Root() );
+
+        tasks.push_back( CollisionTask_T{ root, root, false } );
+    }
+
+    Size_T head = 0;
+    Size_T overlap_count = 0;
+
+    std::vector<CollisionTask_T> children;
+
+    while( (head < tasks.size()) && (tasks.size() - head < task_target) )
+    {
+        children.clear();
+
+        Int k = -1;
+        Int l = -1;
+
+        if( ExpandCollisionTask<mQ,fcQ>( tasks[head], m, children, k, l, overlap_count ) )
+        {
+            witness[0] = k;
+            witness[1] = l;
+
+            if constexpr ( overlap_countersQ )
+            {
+                call_counters.overlap += overlap_count;
+            }
+
+            return true;
+        }
+
+        ++head;
+
+        tasks.insert( tasks.end(), children.rbegin(), children.rend() );
+    }
+
+    const Size_T task_count = tasks.size() - head;
+
+    if( task_count == Size_T(0) )
+    {
+        if constexpr ( overlap_countersQ )
+        {
+            call_counters.overlap += overlap_count;
+        }
+
+        return false;
+    }
+
+    std::atomic<bool>   stop { false };
+    std::atomic<Size_T> next { 0 };
+
+    WitnessVector_T found {{-1,-1}};
+
+    std::vector<Size_T> overlap_counts ( thread_count, Size_T(0) );
+
+    ParallelDo(
+        [&tasks,&m,&stop,&next,&found,&overlap_counts,head,task_count,this]( const Size_T thread )
+        {
+            std::vector<CollisionTask_T> stack;
+
+            Size_T thread_overlap_count = 0;
+
+            while( !stop.load(std::memory_order_relaxed) )
+            {
+                const Size_T t = next.fetch_add( Size_T(1), std::memory_order_relaxed );
+
+                if( t >= task_count )
+                {
+                    break;
+                }
+
+                stack.clear();
+                stack.push_back( tasks[head + t] );
+
+                while( !stack.empty() && !stop.load(std::memory_order_relaxed) )
+                {
+                    const CollisionTask_T task = std::move(stack.back());
+                    stack.pop_back();
+
+                    Int k = -1;
+                    Int l = -1;
+
+                    if( this->template ExpandCollisionTask<mQ,fcQ>( task, m, stack, k, l, thread_overlap_count ) )
+                    {
+                        bool expected = false;
+
+                        if( stop.compare_exchange_strong( expected, true ) )
+                        {
+                            found[0] = k;
+                            found[1] = l;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            overlap_counts[thread] = thread_overlap_count;
+        },
+        thread_count
+    );
+
+    if constexpr ( overlap_countersQ )
+    {
+        for( Size_T count : overlap_counts )
+        {
+            overlap_count += count;
+        }
+
+        call_counters.overlap += overlap_count;
+    }
+
+    witness = found;
+
+    return stop.load();
+
+} // CollisionQ_Parallel
@@ -9,6 +9,9 @@ void ClearWitnesses()
     }
 }
 
+/*!@brief Records the pivots of the loaded move and the witness of its last collision check. If `CollisionQ` ran in parallel (see `ParallelCollisionQ`), then the witness is the first colliding pair that some thread found, so it may differ from the serial witness and between runs with the same seed; only the collision result itself is deterministic.
+ */
+
 void CollectWitnesses()
 {
     if constexpr ( witnessesQ )
@@ -43,6 +46,7 @@ FoldFlag_T Fold(
     {
         // Folding step aborted because pivots indices are too close.
         CollectWitnesses();
+        RecordTelemetry( p, q, pivot_flag, witness, false, 0 );
         return pivot_flag;
     }
     
@@ -54,28 +58,37 @@ FoldFlag_T Fold(
         {
             // Folding step failed because neighbors of pivot touch.
             CollectWitnesses();
+            RecordTelemetry( p, q, joint_flag, witness, false, 0 );
             return joint_flag;
         }
     }
     
     Update();
+    
+    const Size_T overlap_0 = call_counters.overlap;
 
     if( check_collisionsQ && this->template CollisionQ<false>() )
     {
         // Folding step failed; undo the modifications.
         UndoUpdate();
         CollectWitnesses();
+        RecordTelemetry(
+            p, q, FoldFlag_T::RejectedByTree, witness, true, call_counters.overlap - overlap_0
+        );
         return FoldFlag_T::RejectedByTree;
     }
     else
     {
         // Folding step succeeded.
         CollectPivots();
+        RecordTelemetry(
+            p, q, FoldFlag_T::Accepted, witness, check_collisionsQ, call_counters.overlap - overlap_0
+        );
         return FoldFlag_T::Accepted;
     }
 }
 
-/*!@brief Makes `attempt_count` attempts of random pivot moves.
+/*!@brief Makes `attempt_count` attempts of random pivot moves. If `SpeculationBatchSize()` is greater than 1 and collisions are checked, then this calls `FoldRandom_Speculative`.
  */
 
 FoldFlagCounts_T FoldRandom(
@@ -85,17 +98,28 @@ FoldFlagCounts_T FoldRandom(
     const bool check_jointsQ     = true
 )
 {
+    if( (speculation_batch_size > Int(1)) && check_collisionsQ )
+    {
+        return FoldRandom_Speculative( attempt_count, reflectP, check_jointsQ );
+    }
+    
     FoldFlagCounts_T flag_ctrs ( LInt(0) );
     ClearWitnesses();
+    StartTelemetryClock();
     
     const Real P = Clamp(reflectP,Real(0),Real(1));
     
     for( Int attempt = 0; attempt < attempt_count; ++attempt )
     {
+        // We fix the order of the random draws; the evaluation order of function arguments is unspecified.
+        std::pair<Int,Int> pivots = RandomPivots();
+        const Real theta_         = RandomAngle();
+        const bool reflectQ_      = RandomReflectionFlag(P);
+        
         FoldFlag_T flag = Fold(
-            RandomPivots(),
-            RandomAngle(),
-            RandomReflectionFlag(P),
+            std::move(pivots),
+            theta_,
+            reflectQ_,
             check_collisionsQ,
             check_jointsQ
         );
@@ -326,6 +350,8 @@ void RectangleFoldRandom(
     const Int c = NodeBegin(root_1);
     const Int d = NodeEnd  (root_1);
     
+    StartTelemetryClock();
+    
     for( Int attempt = 0; attempt < attempt_count; ++attempt )
     {
         auto pivots = RandomPivots(a,b,c,d);
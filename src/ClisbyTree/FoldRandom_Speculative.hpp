@@ -0,0 +1,273 @@
+public:
+
+void SetSpeculationBatchSize( const Int batch_size )
+{
+    speculation_batch_size = Max( Int(1), batch_size );
+}
+
+Int SpeculationBatchSize() const
+{
+    return speculation_batch_size;
+}
+
+private:
+
+// Same as LoadPivots, but writes the move to `m` instead of loading it into the tree.
+FoldFlag_T LoadPivotMove(
+    std::pair<Int,Int> && pivots,
+    const Real angle_theta,
+    const bool reflectQ_,
+    mref<PivotMove_T> m
+) const
+{
+    std::tie(m.p,m.q) = MinMax(pivots);
+    m.theta    = angle_theta;
+    m.reflectQ = reflectQ_;
+    m.witness[0] = -1;
+    m.witness[1] = -1;
+
+    const Int n = VertexCount() ;
+    const Int mid_size = m.q - m.p - Int(1);
+    const Int rem_size = n - mid_size - Int(2);
+
+    if( (mid_size <= Int(0)) || (rem_size <= Int(0)) ) [[unlikely]]
+    {
+        return FoldFlag_T::RejectedByPivots;
+    }
+
+    m.mid_changedQ = (mid_size <= rem_size);
+
+    m.p_shifted = m.p + m.mid_changedQ;
+    m.q_shifted = m.q + !m.mid_changedQ;
+
+    m.transform = PivotTransform(
+        VertexCoordinates(m.p), VertexCoordinates(m.q), m.theta, m.reflectQ
+    );
+
+    return FoldFlag_T::Accepted;
+}
+
+/*!@brief Checks whether the pivot move `m` would lead to a collision, without loading it into the tree. This is a depth-first traversal of the same tasks as in `CollisionQ_Parallel`; the nodes that are moved by `m` are transformed on the fly. So the tree is only read and several moves can be checked concurrently. The witness is written to `m`.
+ */
+
+template<bool mQ>
+bool PivotMoveCollisionQ(
+    mref<PivotMove_T> m,
+    mref<std::vector<CollisionTask_T>> stack,
+    mref<Size_T> overlap_count
+) const
+{
+    stack.clear();
+
+    {
+        const AbsoluteNode_T root = AbsoluteNode( Transform_T::IdentityTransform(), Root() );
+
+        stack.push_back( CollisionTask_T{ root, root, false } );
+    }
+
+    while( !stack.empty() )
+    {
+        const CollisionTask_T task = std::move(stack.back());
+        stack.pop_back();
+
+        Int k = -1;
+        Int l = -1;
+
+        if( ExpandCollisionTask<mQ,false,true>( task, m, stack, k, l, overlap_count ) )
+        {
+            m.witness[0] = k;
+            m.witness[1] = l;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+FoldFlag_T EvaluatePivotMove(
+    mref<PivotMove_T> m,
+    const bool check_jointsQ,
+    mref<std::vector<CollisionTask_T>> stack,
+    mref<Size_T> overlap_count
+) const
+{
+    if( check_jointsQ )
+    {
+        FoldFlag_T joint_flag = CheckJoints(
+            m.p, m.q, m.mid_changedQ, m.transform, m.witness
+        );
+
+        if( joint_flag != FoldFlag_T::Accepted )
+        {
+            return joint_flag;
+        }
+    }
+
+    const bool collidedQ = m.mid_changedQ
+        ? PivotMoveCollisionQ<true >( m, stack, overlap_count )
+        : PivotMoveCollisionQ<false>( m, stack, overlap_count );
+
+    return collidedQ ? FoldFlag_T::RejectedByTree : FoldFlag_T::Accepted;
+}
+
+public:
+
+/*!@brief Speculative version of `FoldRandom` that always checks for collisions. It draws a batch of `SpeculationBatchSize()` random pivot moves, checks them against the current state with `CollisionThreadCount()` threads, applies the first accepted move of the batch and discards the moves after it.
+ *
+ * Rejected moves do not change the state. So the first accepted move of a batch is the move that `FoldRandom` would accept next. Afterwards, the random engine and the distributions are reset to their state right after drawing this move (see `RandomState_T`), so the batch size and the number of threads do not change the walk. But the collision checks of the moves compose the transformations on the fly instead of pushing them into the tree, so round-off may decide a borderline move differently than `FoldRandom` does, and from then on the two walks differ. So with the same seed, this walk is statistically equivalent to the one of `FoldRandom`, but not necessarily identical to it.
+ *
+ * This pays off if most moves are rejected, e.g., for large hard sphere diameters. Because the threads are started once per batch, the batch size should be a multiple of the thread count that is large compared to the expected number of attempts per accepted move.
+ */
+
+FoldFlagCounts_T FoldRandom_Speculative(
+    const LInt attempt_count,
+    const Real reflectP,
+    const bool check_jointsQ = true
+)
+{
+    TOOLS_PTIMER(timer,MethodName("FoldRandom_Speculative"));
+
+    FoldFlagCounts_T flag_ctrs ( LInt(0) );
+    ClearWitnesses();
+    StartTelemetryClock();
+
+    const Real P = Clamp(reflectP,Real(0),Real(1));
+
+    const Size_T thread_count = ToSize_T(collision_thread_count);
+    const LInt   batch_size   = static_cast<LInt>(speculation_batch_size);
+
+    std::vector<PivotMove_T> moves   ( ToSize_T(batch_size) );
+    std::vector<FoldFlag_T>  flags   ( ToSize_T(batch_size) );
+    std::vector<RandomState_T> random_states;
+    random_states.reserve( ToSize_T(batch_size) );
+    std::vector<Size_T>      move_overlap_counts ( ToSize_T(batch_size) );
+
+    std::vector<std::vector<CollisionTask_T>> stacks ( thread_count );
+    std::vector<Size_T> overlap_counts ( thread_count, Size_T(0) );
+
+    LInt attempt = 0;
+
+    while( attempt < attempt_count )
+    {
+        const Size_T batch = ToSize_T( Min( batch_size, attempt_count - attempt ) );
+
+        random_states.clear();
+
+        // The random numbers are drawn in the same order as in FoldRandom.
+        for( Size_T b = 0; b < batch; ++b )
+        {
+            std::pair<Int,Int> pivots = RandomPivots();
+            const Real theta_         = RandomAngle();
+            const bool reflectQ_      = RandomReflectionFlag(P);
+
+            flags[b]   = LoadPivotMove( std::move(pivots), theta_, reflectQ_, moves[b] );
+            random_states.push_back( SaveRandomState() );
+        }
+
+        std::atomic<Size_T> next  { 0 };
+        std::atomic<Size_T> first { batch };
+
+        ParallelDo(
+            [&moves,&flags,&stacks,&overlap_counts,&move_overlap_counts,&next,&first,batch,check_jointsQ,this](
+                const Size_T thread
+            )
+            {
+                Size_T thread_overlap_count = 0;
+
+                while( true )
+                {
+                    // Moves are handed out in order, so once we are behind the first accepted move, all remaining moves are discarded anyway.
+                    const Size_T b = next.fetch_add( Size_T(1), std::memory_order_relaxed );
+
+                    if( (b >= batch) || (b > first.load(std::memory_order_relaxed)) )
+                    {
+                        break;
+                    }
+
+                    if( flags[b] != FoldFlag_T::Accepted )
+                    {
+                        // Pivots are invalid.
+                        continue;
+                    }
+
+                    const Size_T overlap_0 = thread_overlap_count;
+
+                    flags[b] = this->EvaluatePivotMove(
+                        moves[b], check_jointsQ, stacks[thread], thread_overlap_count
+                    );
+
+                    move_overlap_counts[b] = thread_overlap_count - overlap_0;
+
+                    if( flags[b] == FoldFlag_T::Accepted )
+                    {
+                        Size_T f = first.load();
+
+                        while( (b < f) && !first.compare_exchange_weak(f,b) )
+                        {}
+                    }
+                }
+
+                overlap_counts[thread] += thread_overlap_count;
+            },
+            Min( thread_count, batch )
+        );
+
+        const Size_T k    = first.load();
+        const Size_T done = Min( k + Size_T(1), batch );
+
+        for( Size_T b = 0; b < done; ++b )
+        {
+            ++flag_ctrs[ToUnderlying(flags[b])];
+
+            if constexpr ( witnessesQ )
+            {
+                if( flags[b] != FoldFlag_T::Accepted )
+                {
+                    cref<PivotMove_T> m = moves[b];
+
+                    witness_collector.push_back(
+                        Tiny::Vector<4,Int,Int>({m.p,m.q,m.witness[0],m.witness[1]})
+                    );
+                }
+            }
+        }
+
+        if constexpr ( telemetryQ )
+        {
+            for( Size_T b = 0; b < done; ++b )
+            {
+                cref<PivotMove_T> m = moves[b];
+
+                const bool checkedQ = (flags[b] == FoldFlag_T::Accepted) || (flags[b] == FoldFlag_T::RejectedByTree);
+
+                RecordTelemetry( m.p, m.q, flags[b], m.witness, checkedQ, move_overlap_counts[b] );
+            }
+        }
+
+        if( k < batch )
+        {
+            cref<PivotMove_T> m = moves[k];
+
+            (void)LoadPivots( std::pair<Int,Int>(m.p,m.q), m.theta, m.reflectQ );
+
+            Update();
+            CollectPivots();
+
+            RestoreRandomState( random_states[k] );
+        }
+
+        attempt += static_cast<LInt>(done);
+    }
+
+    if constexpr ( overlap_countersQ )
+    {
+        for( Size_T count : overlap_counts )
+        {
+            call_counters.overlap += count;
+        }
+    }
+
+    return flag_ctrs;
+
+} // FoldRandom_Speculative
@@ -27,6 +27,47 @@ int_unif               coin { Int(0), Int(1) };
 
 public:
 
+/*!@brief The complete state of the random number generation: the engine and the distributions. Some distributions cache values between calls (e.g., a normal distribution generates its values in pairs), so restoring the engine alone does not reproduce the subsequent draws.
+ */
+
+struct RandomState_T
+{
+    PRNG_T                 engine;
+    real_unif              prob_unif;
+    real_unif              angle_unif;
+    wrapped_gaussian       angle_gaussian;
+    discr_wrapped_gaussian pivot_gaussian;
+    discr_wrapped_laplace  pivot_laplace;
+    real_unif              pivot_clisby;
+    int_unif               coin;
+};
+
+RandomState_T SaveRandomState() const
+{
+    return RandomState_T {
+        random_engine,
+        prob_unif,
+        angle_unif,
+        angle_gaussian,
+        pivot_gaussian,
+        pivot_laplace,
+        pivot_clisby,
+        coin
+    };
+}
+
+void RestoreRandomState( cref<RandomState_T> state )
+{
+    random_engine  = state.engine;
+    prob_unif      = state.prob_unif;
+    angle_unif     = state.angle_unif;
+    angle_gaussian = state.angle_gaussian;
+    pivot_gaussian = state.pivot_gaussian;
+    pivot_laplace  = state.pivot_laplace;
+    pivot_clisby   = state.pivot_clisby;
+    coin           = state.coin;
+}
+
 
 bool RandomReflectionFlag( Real P )
 {
@@ -78,21 +78,38 @@ bool SubtreesCollideQ_Recursive( const Int i, const Int j )
             F_j = NodeSplitFlagMatrix<mQ>(c_j[0],c_j[1]);
         }
         
-        auto subdQ = [&c_i,&c_j,&F_i,&F_j,this]( const bool k, const bool l )
+        auto splitQ = [&F_i,&F_j]( const bool k, const bool l )
         {
-            return
-            ( (F_i[k][0] && F_j[l][1]) || (F_i[k][1] && F_j[l][0]) )
-            &&
-            this->BallsCollideQ(c_i[k],c_j[l]);
+            return (F_i[k][0] && F_j[l][1]) || (F_i[k][1] && F_j[l][0]);
         };
         
         // We want the compiler to generate tail calls with as little data as possible.
         // Also, we want that all the node's ball information is used right now (and not much later when the tail call is actually carried out.
         // So we enforce the collision checks right now.
-        const bool subdivideQ [2][2] = {
-            {subdQ(0,0),subdQ(0,1)},
-            {subdQ(1,0),subdQ(1,1)}
-        };
+        bool subdivideQ [2][2];
+        
+        if constexpr ( soa_ballsQ )
+        {
+            // All four ball tests at once.
+            this->template BallsCollideQ<2,2>( c_i[0], c_j[0], &subdivideQ[0][0] );
+            
+            subdivideQ[0][0] = subdivideQ[0][0] && splitQ(0,0);
+            subdivideQ[0][1] = subdivideQ[0][1] && splitQ(0,1);
+            subdivideQ[1][0] = subdivideQ[1][0] && splitQ(1,0);
+            subdivideQ[1][1] = subdivideQ[1][1] && splitQ(1,1);
+        }
+        else
+        {
+            auto subdQ = [&c_i,&c_j,&splitQ,this]( const bool k, const bool l )
+            {
+                return splitQ(k,l) && this->BallsCollideQ(c_i[k],c_j[l]);
+            };
+            
+            subdivideQ[0][0] = subdQ(0,0);
+            subdivideQ[0][1] = subdQ(0,1);
+            subdivideQ[1][0] = subdQ(1,0);
+            subdivideQ[1][1] = subdQ(1,1);
+        }
         
         // TODO: We should find a better order for these four calls.
         // TODO: E.g., we should first check nodes that contain a pivot.
@@ -135,22 +152,32 @@ bool SubtreesCollideQ_Recursive( const Int i, const Int j )
         }
         else
         {
-            f_i = NodeSplitFlagVector<mQ>(j);
+            f_i = NodeSplitFlagVector<mQ>(i);
             F_j = NodeSplitFlagMatrix<mQ>(c_j[0],c_j[1]);
         }
         
-        auto subdQ = [i,&c_j,&f_i,&F_j,this]( const bool l )
+        auto splitQ = [&f_i,&F_j]( const bool l )
         {
-            return
-                ( (f_i[0] && F_j[l][1]) || (f_i[1] && F_j[l][0]) )
-                &&
-                this->BallsCollideQ(i,c_j[l]);
+            return (f_i[0] && F_j[l][1]) || (f_i[1] && F_j[l][0]);
         };
         
         // We want the compiler to generate tail calls with as little data as possible.
         // Also, we want that all the node's ball information is used right now (and not much later when the tail call is actually carried out.
         // So we enforce the collision checks right now.
-        const bool subdivideQ [2] = { subdQ(0), subdQ(1) };
+        bool subdivideQ [2];
+        
+        if constexpr ( soa_ballsQ )
+        {
+            this->template BallsCollideQ<1,2>( i, c_j[0], &subdivideQ[0] );
+            
+            subdivideQ[0] = subdivideQ[0] && splitQ(0);
+            subdivideQ[1] = subdivideQ[1] && splitQ(1);
+        }
+        else
+        {
+            subdivideQ[0] = splitQ(0) && this->BallsCollideQ(i,c_j[0]);
+            subdivideQ[1] = splitQ(1) && this->BallsCollideQ(i,c_j[1]);
+        }
         
         // TODO: We could exploit here that we now that i, c_j[0], and c_j[1] are all leaf nodes.
         
@@ -184,18 +211,28 @@ bool SubtreesCollideQ_Recursive( const Int i, const Int j )
             f_j = NodeSplitFlagVector<mQ>(j);
         }
         
-        auto subdQ = [&c_i,&F_i,j,&f_j,this]( const bool k )
+        auto splitQ = [&F_i,&f_j]( const bool k )
         {
-            return
-                ( (F_i[k][0] && f_j[1]) || (F_i[k][1] && f_j[0]) )
-                &&
-                this->BallsCollideQ(c_i[k],j);
+            return (F_i[k][0] && f_j[1]) || (F_i[k][1] && f_j[0]);
         };
         
         // We want the compiler to generate tail calls with as little data as possible.
         // Also, we want that all the node's ball information is used right now (and not much later when the tail call is actually carried out.
         // So we enforce the collision checks right now.
-        const bool subdivideQ [2] = { subdQ(0), subdQ(1) };
+        bool subdivideQ [2];
+        
+        if constexpr ( soa_ballsQ )
+        {
+            this->template BallsCollideQ<2,1>( c_i[0], j, &subdivideQ[0] );
+            
+            subdivideQ[0] = subdivideQ[0] && splitQ(0);
+            subdivideQ[1] = subdivideQ[1] && splitQ(1);
+        }
+        else
+        {
+            subdivideQ[0] = splitQ(0) && this->BallsCollideQ(c_i[0],j);
+            subdivideQ[1] = splitQ(1) && this->BallsCollideQ(c_i[1],j);
+        }
 
         // TODO: We could exploit here that we know that i, c_j[0], and c_j[1] are all leaf nodes.
         
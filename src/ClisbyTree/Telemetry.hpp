@@ -0,0 +1,109 @@
+public:
+
+/*!@brief Returns the statistics of the pivot moves since construction or since the last call of `ClearTelemetry`. They are only recorded if `telemetryQ` is set; otherwise all counts are zero.
+ *
+ * The moves are binned by their pivot distance |p-q| (modulo the vertex count), so the histograms show directly how the acceptance rate depends on the distribution of pivots selected by `PivotRandomMethod_T`. Moves rejected by the tree also record the depth of the lowest common ancestor of the two colliding leaves; small depths mean that the collision was found between distant parts of the polygon. Together with the number of ball overlap checks per collision check and the time per accepted move, this gives the number of accepted moves per second for each pivot distribution.
+ */
+
+cref<Telemetry_T> Telemetry() const
+{
+    return telemetry;
+}
+
+void ClearTelemetry()
+{
+    telemetry = Telemetry_T();
+}
+
+private:
+
+static Size_T TelemetryBin( const Size_T value )
+{
+    return Min( ToSize_T(std::bit_width(value)), telemetry_bin_count - Size_T(1) );
+}
+
+Int LowestCommonAncestorDepth( const Int vertex_0, const Int vertex_1 ) const
+{
+    Int i = PrimitiveNode(vertex_0);
+    Int j = PrimitiveNode(vertex_1);
+
+    while( i != j )
+    {
+        if( Depth(i) >= Depth(j) )
+        {
+            i = Parent(i);
+        }
+        else
+        {
+            j = Parent(j);
+        }
+    }
+
+    return Depth(i);
+}
+
+// Starts the clock for the time per accepted move.
+void StartTelemetryClock()
+{
+    if constexpr ( telemetryQ )
+    {
+        telemetry_mark = std::chrono::steady_clock::now();
+    }
+}
+
+/*!@brief Records a pivot move with pivots `p_` and `q_` that was classified as `flag`. If `checkedQ` is set, then the tree was checked for collisions with `overlap_count` ball overlap checks.
+ */
+
+void RecordTelemetry(
+    const Int p_,
+    const Int q_,
+    const FoldFlag_T flag,
+    cref<WitnessVector_T> witness_,
+    const bool checkedQ,
+    const Size_T overlap_count
+)
+{
+    if constexpr ( telemetryQ )
+    {
+        const Int d = ModDistance( VertexCount(), p_, q_ );
+
+        ++telemetry.distance_flags[TelemetryBin(ToSize_T(d))][ToSize_T(ToUnderlying(flag))];
+
+        if( checkedQ )
+        {
+            ++telemetry.check_overlaps[TelemetryBin(overlap_count)];
+            ++telemetry.check_count;
+            telemetry.overlap_count += static_cast<LInt>(overlap_count);
+        }
+
+        if( (flag == FoldFlag_T::RejectedByTree) && (witness_[0] >= Int(0)) )
+        {
+            ++telemetry.rejection_depths[ToSize_T(LowestCommonAncestorDepth(witness_[0],witness_[1]))];
+        }
+
+        if( flag == FoldFlag_T::Accepted )
+        {
+            const auto now = std::chrono::steady_clock::now();
+
+            // The steady clock is monotonic, so this is nonnegative.
+            const Size_T nanoseconds = static_cast<Size_T>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - telemetry_mark).count()
+            );
+
+            telemetry_mark = now;
+
+            ++telemetry.accept_nanoseconds[TelemetryBin(nanoseconds)];
+            ++telemetry.accept_count;
+            telemetry.accept_time += static_cast<double>(nanoseconds) * 1e-9;
+        }
+    }
+    else
+    {
+        (void)p_;
+        (void)q_;
+        (void)flag;
+        (void)witness_;
+        (void)checkedQ;
+        (void)overlap_count;
+    }
+}
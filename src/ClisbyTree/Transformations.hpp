@@ -195,18 +195,53 @@ Transform_T NodeTransform( const Int node ) const
 
 Vector_T NodeCenter( const Int node ) const
 {
-    return Vector_T( NodeCenterPtr(node) );
+    if constexpr ( !ball_ptrQ )
+    {
+        Real x [AmbDim];
+        
+        WriteNodeCenter( node, &x[0] );
+        
+        return Vector_T( &x[0] );
+    }
+    else
+    {
+        return Vector_T( NodeCenterPtr(node) );
+    }
+}
+
+// Returns `true` if a matrix-vector multiplication was necessary.
+bool TransformNodeCenter( cref<Transform_T> f, const Int node )
+{
+    if constexpr ( !ball_ptrQ )
+    {
+        Real x [AmbDim];
+        
+        WriteNodeCenter( node, &x[0] );
+        
+        const bool info = f.TransformVector( &x[0] );
+        
+        if( info )
+        {
+            ReadNodeCenter( node, &x[0] );
+        }
+        
+        return info;
+    }
+    else
+    {
+        return f.TransformVector( NodeCenterPtr(node) );
+    }
 }
 
 void UpdateNode( cref<Transform_T> f, const Int node )
 {
     if constexpr ( countersQ )
     {
-        call_counters.mv += f.TransformVector( NodeCenterPtr(node) );
+        call_counters.mv += TransformNodeCenter( f, node );
     }
     else
     {
-        (void)f.TransformVector( NodeCenterPtr(node) );
+        (void)TransformNodeCenter( f, node );
     }
     
     // Transformation of a leaf node never needs a change.
@@ -1,4 +1,37 @@
 #include "UpdateSubtree_Recursive.hpp"
+#include "UpdatePaths.hpp"
+
+public:
+
+void UseSubtreeUpdates()
+{
+    update_method = UpdateMethod_T::Subtree;
+}
+
+void UsePathUpdates()
+{
+    update_method = UpdateMethod_T::Paths;
+}
+
+UpdateMethod_T UpdateMethod() const
+{
+    return update_method;
+}
+
+std::string ToString( const UpdateMethod_T method )
+{
+    switch( method )
+    {
+        case UpdateMethod_T::Paths:
+        {
+            return "UpdateMethod_T::Paths";
+        }
+        default:
+        {
+            return "UpdateMethod_T::Subtree";
+        }
+    }
+}
 
 private:
 
@@ -10,7 +43,38 @@ void Update( Int start_node )
         PullTransforms(Root(), start_node);
     }
     
-    UpdateSubtree_Recursive(start_node);
+    // UpdatePaths always starts at the root.
+    const UpdateMethod_T method = (start_node == Root())
+                                ? update_method
+                                : UpdateMethod_T::Subtree;
+    
+    [[maybe_unused]] const Size_T mm_0 = call_counters.mm;
+    [[maybe_unused]] const Size_T mv_0 = call_counters.mv;
+    [[maybe_unused]] const Size_T lt_0 = call_counters.load_transform;
+    
+    switch( method )
+    {
+        case UpdateMethod_T::Paths:
+        {
+            UpdatePaths();
+            break;
+        }
+        default:
+        {
+            UpdateSubtree_Recursive(start_node);
+            break;
+        }
+    }
+    
+    if constexpr ( countersQ )
+    {
+        mref<UpdateCallCounters_T> c = call_counters.update[ToSize_T(ToUnderlying(method))];
+        
+        ++c.calls;
+        c.mm             += call_counters.mm             - mm_0;
+        c.mv             += call_counters.mv             - mv_0;
+        c.load_transform += call_counters.load_transform - lt_0;
+    }
 }
 
 void Update()
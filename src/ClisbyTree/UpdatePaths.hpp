@@ -0,0 +1,118 @@
+private:
+
+/*!@brief Does the same as `UpdateSubtree_Recursive(Root())`, but it does not recurse and it does not compute the ranges of the nodes that have to be split.
+ *
+ * A node has to be split if and only if it contains two consecutive leaves of which exactly one is moved. There are at most two such pairs of leaves, one at each pivot. So the split nodes form at most two paths from the lowest common ancestors of these pairs to the root. We proceed as follows:
+ *
+ *  1. Walk up from both pairs of leaves and collect the nodes on the paths.
+ *  2. Walk down through the collected nodes, push their transforms into their children, and apply `transform` to the children that are not on a path and that are moved.
+ *  3. Walk up through the collected nodes and recompute their balls.
+ */
+
+void UpdatePaths()
+{
+    // Each path has at most one node per level.
+    constexpr Int max_path_size = Int(2) * max_depth + Int(2);
+    
+    Int path [max_path_size];
+    Int path_size = 0;
+    
+    CollectSplitPath( p_shifted, &path[0], path_size );
+    CollectSplitPath( q_shifted, &path[0], path_size );
+    
+    if( path_size <= Int(0) ) [[unlikely]]
+    {
+        // No node has to be split; so either all or no leaves are moved.
+        if( LeafMovedQ( Int(0) ) )
+        {
+            UpdateNode( transform, Root() );
+        }
+        return;
+    }
+    
+    // Parents have smaller indices than their children. So this order is top-down.
+    std::sort( &path[0], &path[path_size] );
+    
+    auto on_pathQ = [&path,path_size]( const Int node )
+    {
+        return std::binary_search( &path[0], &path[path_size], node );
+    };
+    
+    for( Int i = 0; i < path_size; ++i )
+    {
+        const Int node = path[i];
+        
+        auto [L,R] = Children(node);
+        
+        PushTransform(node,L,R);
+        
+        if( !on_pathQ(L) && LeafMovedQ( NodeBegin(L) ) )
+        {
+            UpdateNode( transform, L );
+        }
+        
+        if( !on_pathQ(R) && LeafMovedQ( NodeBegin(R) ) )
+        {
+            UpdateNode( transform, R );
+        }
+    }
+    
+    for( Int i = path_size; i --> Int(0); )
+    {
+        ComputeBall( path[i] );
+    }
+}
+
+// Whether the leaf with index `leaf` (in the order of the vertices) is moved by the loaded pivot move.
+bool LeafMovedQ( const Int leaf ) const
+{
+    return ((p_shifted <= leaf) && (leaf < q_shifted)) == mid_changedQ;
+}
+
+// Appends the common ancestors of the leaves `boundary - 1` and `boundary` to `path`, unless they are already there.
+void CollectSplitPath( const Int boundary, mptr<Int> path, mref<Int> path_size ) const
+{
+    if( (boundary <= Int(0)) || (boundary >= LeafNodeCount()) )
+    {
+        // Only one side of the boundary exists; so nothing needs to be split here.
+        return;
+    }
+    
+    Int a = PrimitiveNode( boundary - Int(1) );
+    Int b = PrimitiveNode( boundary          );
+    
+    // In a heap-ordered tree the node with the greater index is never an ancestor of the other.
+    while( a != b )
+    {
+        if( a > b )
+        {
+            a = Parent(a);
+        }
+        else
+        {
+            b = Parent(b);
+        }
+    }
+    
+    const Int old_path_size = path_size;
+    
+    Int node = a;
+    
+    while( true )
+    {
+        // The paths join at some node; from there on, the ancestors are already collected.
+        if( std::find( path, path + old_path_size, node ) != path + old_path_size )
+        {
+            break;
+        }
+        
+        path[path_size++] = node;
+        
+        if( node == Root() )
+        {
+            break;
+        }
+        
+        node = Parent(node);
+    }
+}
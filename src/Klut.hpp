@@ -1,5 +1,11 @@
 #pragma once
 
+#include <bit>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 // TODO: Make example.
 
 
@@ -26,9 +32,13 @@ namespace Knoodle
 //        using ID_T   = UInt16;
         
         // There are 1388705 knots with 16 crossings.
-        static constexpr Size_T max_crossing_count = 13;
+        // This is also the most that fits into `Key_T` with one byte per crossing.
+        static constexpr Size_T max_crossing_count = 16;
         // So, an UInt32 should suffice for enumerating them.
         
+        /*!@brief Subtables with more crossings than this are served only from prebuilt table files. Their text tables are far too big to be parsed into a hash map; `WriteTableFile` converts them by streaming.*/
+        static constexpr Size_T max_text_crossing_count = 13;
+        
         /*!@brief An integral type to store IDs for all knot classes in the lookup table.*/
         using ID_T   = UInt32;
         
@@ -60,15 +70,45 @@ namespace Knoodle
 //        using LUT_T  = ankerl::unordered_dense::map<Key_T,ID_T,Hash_T>;
 //        using LUT_T =  boost::unordered_flat_map<Key_T,ID_T,Hash_T>;
         
+        /*!@brief Header of a prebuilt table file `Klut_Table_??.bin`. The file consists of this header, followed by the packed keys (see `PackKey`) in ascending order, the IDs belonging to these keys, `knot_count + 1` offsets into the name pool, and the name pool itself. All blocks start at multiples of 64 bytes. So the file can be mapped into memory read-only and queried by binary search without any deserialization.
+         *
+         * Each key takes `key_byte_count = PackedKeyByteCount(crossing_count)` bytes, e.g., 12 bytes for 13 and 14 bytes for 16 crossings instead of the 16 bytes of `Key_T`.
+         */
+        struct TableHeader_T
+        {
+            char   magic [16];
+            UInt64 version;
+            UInt64 byte_order; // Must read as `table_byte_order`; the keys are stored in native byte order.
+            UInt64 key_byte_count;
+            UInt64 id_byte_count;
+            UInt64 crossing_count;
+            UInt64 key_count;
+            UInt64 knot_count;
+            UInt64 key_offset;
+            UInt64 id_offset;
+            UInt64 name_offset;
+            UInt64 pool_offset;
+            UInt64 pool_byte_count;
+            UInt64 byte_count;
+        };
+        
+        static constexpr char table_magic [16] = "KnoodleKlut";
+        
+        // Version 1 stored unpacked `Key_T` keys.
+        static constexpr UInt64 table_version    = 2;
+        
+        static constexpr UInt64 table_byte_order = 0x0102030405060708;
+        
+        static constexpr Size_T table_alignment = 64;
+        
 #include "Klut/Subtable.hpp"
         
     private:
         
         Path_T data_directory;
         
-        std::vector<Subtable> subtables {1};
-        
-        Tensor1<CodeInt,Size_T> s_mac_leod_buffer { max_crossing_count };
+        // Mutable because the subtables are loaded lazily, also from const lookups. Each subtable synchronizes its loading with a once-flag, and the lookups use scratch space on the stack. So one instance of `Klut` can be queried from many threads at once.
+        mutable std::vector<Subtable> subtables {1};
         
     public:
         
@@ -78,13 +118,18 @@ namespace Knoodle
          *
          * The tables can be a bit big; so we hesitate to load them already by the constructor. Instead, we do lazy-loading: a subtable is loaded only the first time it is needed.  In principle, this allows one to inspect the files for the subtables through the class's interface (e.g., find out their file sizes) and take appropriate measures.
          *
-         * @param data_directory_ A path to a directory containing files with names of the form `Klut_Keys_??.bin` and `Klut_Values_??.bin`. These files hold the relevant information of the lookup tables and thei content will be loaded.
+         * If a prebuilt table file `Klut_Table_??.bin` exists (see `WriteTableFiles`), then it is preferred over the text tables: it is mapped into memory read-only instead of being parsed into a hash map. So loading is almost free, and several processes share one copy of the table in the page cache.
+         *
+         * @param data_directory_ A path to a directory containing files with names of the form `Klut_Keys_??.bin` and `Klut_Values_??.bin` and/or `Klut_Table_??.bin`. These files hold the relevant information of the lookup tables and thei content will be loaded.
          *
          * @param crossing_count Provide tables for prime knots of up to this many crossings (if the corresponding files exist).
+         *
+         * @param table_filesQ Whether to use prebuilt table files if they exist.
          */
         Klut(
             cref<Path_T> data_directory_,
-            Size_T crossing_count = max_crossing_count // build up to this number of crossings.
+            Size_T crossing_count = max_crossing_count, // build up to this number of crossings.
+            bool table_filesQ = true
         )
         :   data_directory (data_directory_)
         {
@@ -96,7 +141,9 @@ namespace Knoodle
             
             for( Size_T c = 3; c <= c_count; ++c )
             {
-                subtables[c] = Subtable(c, KeyFile(c), ValueFile(c));
+                subtables[c] = Subtable(
+                    c, KeyFile(c), ValueFile(c), table_filesQ ? TableFile(c) : Path_T()
+                );
             }
         }
         
@@ -106,11 +153,21 @@ namespace Knoodle
             return subtables.size() - Size_T(1);
         }
         
+        /*!@brief Return the largest `c` such that the subtables for 3,...,c crossings can be served (judged by the files that were present at construction). Diagrams with more crossings than this are out of range, even if `CrossingCount()` is larger.*/
+        Size_T AvailableCrossingCount() const
+        {
+            Size_T c = 2;
+            
+            while( (c + 1 < subtables.size()) && subtables[c + 1].AvailableQ() ) { ++c; }
+            
+            return c;
+        }
+        
         /*!@brief Ensure that all subtables are loaded.
          *
-         *  The user should make sure to call this before any concurrent calls from several threads arrive at this instance of `Klut`; otherwise the lazy loading might incur a data race.
+         *  Lazy loading is thread-safe, so this is not required before concurrent lookups. But it moves the loading time out of the first lookups, e.g., out of timed sections.
          */
-        void RequireSubtables()
+        void RequireSubtables() const
         {
             for( Size_T c = 3; c < subtables.size(); ++c )
             {
@@ -120,7 +177,7 @@ namespace Knoodle
         
         /*!@brief Same as `RequireSubtables`. Only kept for backward compatibility.*/
         [[deprecated("Use RequireSubtables instead. That provides a better description on what is going on.")]]
-        void LoadSubtables()
+        void LoadSubtables() const
         {
             RequireSubtables();
         }
@@ -139,6 +196,12 @@ namespace Knoodle
             return data_directory / ("Klut_Values_" + StringWithLeadingZeroes(crossing_count,Size_T(2)) + ".tsv");
         }
         
+        /*!@brief Return the path to the prebuilt table file for all prime knots of exactly `crossing_count` crossings.*/
+        Path_T TableFile( Size_T crossing_count ) const
+        {
+            return data_directory / ("Klut_Table_" + StringWithLeadingZeroes(crossing_count,Size_T(2)) + ".bin");
+        }
+        
     public:
         
 #include "Klut/Key.hpp"
@@ -7,14 +7,10 @@ std::vector<std::string> SubtableNames( const Int n )
     
     if( std::cmp_less(n,0) || std::cmp_greater(c,CrossingCount()) )
     {
-        std::vector<std::string>();
+        return std::vector<std::string>();
     }
     
-    Subtable & s = subtables[c];
-    
-    s.RequireTable();
-    
-    return s.knot_names;
+    return subtables[c].KnotNames();
 }
 
 //cref<LUT_T> LookupTable()
@@ -49,11 +45,12 @@ Tensor2<T,Size_T> SubtableCodes( const Int n )
     Tensor2<T,Size_T> codes ( s.KeyCount(), c );
     
     Size_T j = 0;
-    for( const auto & [key,id] : s.lut )
+    s.ForEachKey( [&codes,&j]( cref<Key_T> key, const ID_T id )
     {
+        (void)id;
         Klut::KeyToMacLeodCode(key,codes.data(j));
         ++j;
-    }
+    });
     
     return codes;
 }
@@ -75,11 +72,12 @@ Tensor1<ID_T,Size_T> SubtableIDs( const Int n )
     Tensor1<ID_T,Size_T> ids ( s.KeyCount() );
     
     Size_T j = 0;
-    for( const auto & [key,id] : s.lut )
+    s.ForEachKey( [&ids,&j]( cref<Key_T> key, const ID_T id )
     {
+        (void)key;
         ids[j] = id;
         ++j;
-    }
+    });
     
     return ids;
 }
@@ -120,16 +118,236 @@ void WriteSubtableToFile( cref<Path_T> file, const Int n )
     // Codes how c_count entries with up to 3 digits.
     // We need another byte per entry for the separators `\t`.
     // We need another byte per code for '\n'.
-    OutString s ( subtable.lut.size() * (3 * c + 23 + 1) );
+    OutString s ( subtable.KeyCount() * (3 * c + 23 + 1) );
     
-    for( const auto & [key,id] : subtable.lut )
+    subtable.ForEachKey( [&s,&code,&subtable,c]( cref<Key_T> key, const ID_T id )
     {
         Klut::KeyToMacLeodCode(key,code.data());
         s.template PutVectorFun<Format::Vector::TSV>(code.ReadAccess(),c);
         s.PutChar('\t');
-        s.PutChars(subtable.knot_names[id]);
+        s.PutChars(Name_T(subtable.KnotName(id)));
         s.PutChar('\n');
-    }
+    });
     
     stream << s;
 }
+
+/*!@brief Write the subtable for `n`-crossing knots as prebuilt table file to `file` (see `TableHeader_T`). Returns `true` on success.
+ *
+ * If the text tables exist, they are streamed directly into the packed keys; no hash map is built. This is the only way to convert the subtables with more than `max_text_crossing_count` crossings. Otherwise the keys are taken from the loaded subtable.
+ *
+ * The data is first written to a temporary file which then replaces `file`. So processes that have mapped an older version of `file` are not disturbed.
+ *
+ * Throws if a key does not fit into `PackedKeyBitCount(n)` bits per crossing (see `PackableKeyQ`) or if two keys are equal after packing, because then the binary search in the table file would return wrong or arbitrary IDs. The message names the numbers of the offending keys in the source (counted from 1), i.e., their positions in the key file of the text tables.
+ */
+template<IntQ Int>
+bool WriteTableFile( cref<Path_T> file, const Int n )
+{
+    [[maybe_unused]] auto tag = [](){ return MethodName("WriteTableFile"); };
+    
+    TOOLS_PTIMER(timer,tag());
+    
+    Size_T c = ToSize_T(n);
+    
+    if( std::cmp_less(n,3) || std::cmp_greater(c,CrossingCount()) )
+    {
+        wprint(tag() + ": There is no subtable for " + ToString(n) +"-crossing diagrams to export. Aborting.");
+        return false;
+    }
+    
+    Subtable & subtable = subtables[c];
+    
+    const Size_T w = PackedKeyByteCount(c);
+    
+    // Packed key, its ID, and its number in the source (for error messages). The records are sorted by the keys with `std::memcmp`.
+    struct Record_T
+    {
+        std::array<UInt8,sizeof(Key_T)> key;
+        ID_T   id;
+        Size_T number;
+    };
+    
+    std::vector<Record_T> entries;
+    std::vector<Name_T>   names;
+    
+    const bool textQ = subtable.TextFilesQ();
+    
+    const std::string source = textQ
+        ? "key file " + subtable.k_file.string()
+        : "loaded subtable for " + ToString(n) + "-crossing diagrams";
+    
+    auto push = [&entries,&source,&tag,c]( cref<Key_T> key, const ID_T id )
+    {
+        const Size_T number = entries.size() + Size_T(1);
+        
+        if( !PackableKeyQ( key, c ) )
+        {
+            throw std::runtime_error(
+                tag() + ": Key number " + ToString(number) + " in " + source + " is not a MacLeod code of a " + ToString(c) + "-crossing diagram; it does not fit into " + ToString(PackedKeyBitCount(c)) + " bits per crossing."
+            );
+        }
+        
+        Record_T r {};
+        PackKey( key, c, r.key.data() );
+        r.id     = id;
+        r.number = number;
+        entries.push_back( r );
+    };
+    
+    if( textQ )
+    {
+        if( !subtable.ScanTextTables( push, names ) )
+        {
+            eprint(tag() + ": Text tables for " + ToString(n) +"-crossing diagrams could not be read. Aborting.");
+            return false;
+        }
+    }
+    else
+    {
+        subtable.RequireTable();
+        
+        if( subtable.FailedQ() )
+        {
+            eprint(tag() + ": Subtable for " + ToString(n) +"-crossing diagrams could not be loaded. Aborting.");
+            return false;
+        }
+        
+        entries.reserve( subtable.KeyCount() );
+        subtable.ForEachKey( push );
+        names = subtable.KnotNames();
+    }
+    
+    // Sort the keys so that lookups can use binary search.
+    std::sort( entries.begin(), entries.end(),
+        [w]( cref<Record_T> a, cref<Record_T> b )
+        {
+            return std::memcmp( a.key.data(), b.key.data(), w ) < 0;
+        }
+    );
+    
+    const Size_T key_count  = entries.size();
+    const Size_T knot_count = names.size();
+    
+    // The binary search would find either of two equal keys; so we reject duplicates instead of picking one.
+    for( Size_T k = 1; k < key_count; ++k )
+    {
+        cref<Record_T> a = entries[k - Size_T(1)];
+        cref<Record_T> b = entries[k];
+        
+        if( std::memcmp( a.key.data(), b.key.data(), w ) == 0 )
+        {
+            auto name = [&names,knot_count]( const ID_T id )
+            {
+                return (ToSize_T(id) < knot_count) ? std::string(names[ToSize_T(id)]) : ToString(id);
+            };
+            
+            throw std::runtime_error(
+                tag() + ": Keys number " + ToString(Min(a.number,b.number)) + " and " + ToString(Max(a.number,b.number)) + " in " + source + " are equal (knots " + name(a.id) + " and " + name(b.id) + ")."
+            );
+        }
+    }
+    
+    std::vector<UInt64> name_offsets ( knot_count + Size_T(1) );
+    std::string         name_pool;
+    
+    for( Size_T id = 0; id < knot_count; ++id )
+    {
+        name_offsets[id] = name_pool.size();
+        name_pool += names[id];
+    }
+    name_offsets[knot_count] = name_pool.size();
+    
+    auto align = []( const UInt64 offset )
+    {
+        return ((offset + table_alignment - 1) / table_alignment) * table_alignment;
+    };
+    
+    TableHeader_T h {};
+    
+    std::memcpy( &h.magic[0], &table_magic[0], sizeof(h.magic) );
+    
+    h.version         = table_version;
+    h.byte_order      = table_byte_order;
+    h.key_byte_count  = w;
+    h.id_byte_count   = sizeof(ID_T);
+    h.crossing_count  = c;
+    h.key_count       = key_count;
+    h.knot_count      = knot_count;
+    h.key_offset      = align( sizeof(TableHeader_T) );
+    h.id_offset       = align( h.key_offset  + key_count * w );
+    h.name_offset     = align( h.id_offset   + key_count * sizeof(ID_T) );
+    h.pool_offset     = align( h.name_offset + name_offsets.size() * sizeof(UInt64) );
+    h.pool_byte_count = name_pool.size();
+    h.byte_count      = h.pool_offset + h.pool_byte_count;
+    
+    Path_T temp_file = file;
+    temp_file += ".tmp";
+    
+    {
+        std::ofstream stream ( temp_file, std::ios::binary | std::ios::trunc );
+        
+        // The blocks are written one after another, so that the largest subtables need not be held in memory twice.
+        UInt64 position = 0;
+        
+        auto put = [&stream,&position]( cptr<void> ptr, const UInt64 byte_count )
+        {
+            stream.write( static_cast<const char *>(ptr), static_cast<std::streamsize>(byte_count) );
+            position += byte_count;
+        };
+        
+        auto pad_to = [&put,&position]( const UInt64 offset )
+        {
+            constexpr char zeroes [table_alignment] = {};
+            put( &zeroes[0], offset - position );
+        };
+        
+        put( &h, sizeof(h) );
+        
+        pad_to( h.key_offset );
+        for( cref<Record_T> r : entries ) { put( r.key.data(), w ); }
+        
+        pad_to( h.id_offset );
+        for( cref<Record_T> r : entries ) { put( &r.id, sizeof(ID_T) ); }
+        
+        pad_to( h.name_offset );
+        put( name_offsets.data(), name_offsets.size() * sizeof(UInt64) );
+        
+        pad_to( h.pool_offset );
+        put( name_pool.data(), name_pool.size() );
+        
+        if( !stream )
+        {
+            eprint(tag() + ": Could not write file " + temp_file.string() +". Aborting." );
+            return false;
+        }
+    }
+    
+    std::error_code ec;
+    
+    std::filesystem::rename( temp_file, file, ec );
+    
+    if( ec )
+    {
+        eprint(tag() + ": Could not rename " + temp_file.string() + " to " + file.string() + ": " + ec.message() + ". Aborting." );
+        return false;
+    }
+    
+    return true;
+}
+
+/*!@brief Write prebuilt table files `Klut_Table_??.bin` for all subtables whose text tables or table files exist into the data directory. This is the offline conversion of the text tables; later instances of `Klut` map these files instead of parsing the text tables. Returns `true` if all subtables could be written.
+ */
+bool WriteTableFiles()
+{
+    bool succeededQ = true;
+    
+    for( Size_T c = 3; c <= CrossingCount(); ++c )
+    {
+        // Nothing to convert; e.g., the tables for more than 13 crossings are optional downloads.
+        if( !subtables[c].TextFilesQ() && !subtables[c].AvailableQ() ) { continue; }
+        
+        succeededQ = WriteTableFile( TableFile(c), c ) && succeededQ;
+    }
+    
+    return succeededQ;
+}
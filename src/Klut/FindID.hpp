@@ -1,7 +1,7 @@
 private:
 
 template<bool testQ = true, IntQ Int>
-std::pair<Size_T,ID_T> FindID_impl( cref<Key_T> key, Int n )
+std::pair<Size_T,ID_T> FindID_impl( cref<Key_T> key, Int n ) const
 {
     const Size_T c = static_cast<Size_T>(n);
     
@@ -20,14 +20,14 @@ std::pair<Size_T,ID_T> FindID_impl( cref<Key_T> key, Int n )
 public:
 
 template<IntQ Int>
-std::pair<Size_T,ID_T> FindID( cref<Key_T> key )
+std::pair<Size_T,ID_T> FindID( cref<Key_T> key ) const
 {
     return FindID_impl<true>(key,MacLeodCodeLength(key));
 }
 
 
 template<typename T, IntQ Int>
-std::pair<Size_T,ID_T> FindID( cptr<T> s_mac_leod, Int n )
+std::pair<Size_T,ID_T> FindID( cptr<T> s_mac_leod, Int n ) const
 {
     const Size_T c = static_cast<Size_T>(n);
     
@@ -42,26 +42,26 @@ std::pair<Size_T,ID_T> FindID( cptr<T> s_mac_leod, Int n )
 
 /*!@brief Return the number of crossings and the ID of the knot class belonging to the MacLeodCode `s_mac_leod`; ID will be `not_found` if it is not found in the lookup table.*/
 template<typename T, IntQ Int>
-std::pair<Size_T,ID_T> FindID( cref<Tensor1<T,Int>> s_mac_leod )
+std::pair<Size_T,ID_T> FindID( cref<Tensor1<T,Int>> s_mac_leod ) const
 {
     return FindID( &s_mac_leod[0], static_cast<Size_T>(s_mac_leod.Size()) );
 }
 
 /*!@brief Return the number of crossings and the ID of the knot class belonging to the MacLeodCode `s_mac_leod`; ID will be `not_found` if it is not found in the lookup table.*/
 template<typename T, IntQ Int>
-std::pair<Size_T,ID_T> FindID( cref<std::vector<T,Int>> s_mac_leod )
+std::pair<Size_T,ID_T> FindID( cref<std::vector<T,Int>> s_mac_leod ) const
 {
     return FindID( &s_mac_leod[0], s_mac_leod.size() );
 }
 
-std::pair<Size_T,ID_T> FindID( std::string_view s_mac_leod )
+std::pair<Size_T,ID_T> FindID( std::string_view s_mac_leod ) const
 {
     return FindID( &s_mac_leod[0], s_mac_leod.size() );
 }
 
 /*!@brief Return the number of crossings and the ID of the knot class belonging to the `PlanarDiagram` `pd`; ID will be `not_found` if it is not found in the lookup table.*/
 template<IntQ Int>
-std::pair<Size_T,ID_T> FindID( cref<PlanarDiagram<Int>> pd )
+std::pair<Size_T,ID_T> FindID( cref<PlanarDiagram<Int>> pd ) const
 {
     if( pd.InvalidQ() ) { return {invalid,invalid}; }
     
@@ -71,7 +71,119 @@ std::pair<Size_T,ID_T> FindID( cref<PlanarDiagram<Int>> pd )
     
     if( pd.LinkComponentCount() > Int(1) ) { return {c,not_found}; }
     
-    pd.template WriteMacLeodCode<CodeInt>(s_mac_leod_buffer.data());
+    // Scratch space on the stack keeps this reentrant.
+    std::array<CodeInt,max_crossing_count> s_mac_leod {};
     
-    return FindID( &s_mac_leod_buffer[0], c );
+    pd.template WriteMacLeodCode<CodeInt>(s_mac_leod.data());
+    
+    return FindID( s_mac_leod.data(), c );
+}
+
+
+/*!@brief Look up the `count` keys `keys` at once and write the number of crossings and the ID of `keys[i]` to `result[i]`.
+ *
+ * The keys are grouped by crossing count, and each group is resolved by `Subtable::FindIDs`, which interleaves the lookups so that their memory accesses overlap. This pays off if many keys are queued, e.g., thousands from a pipeline stage. For a single key, use `FindID`.
+ */
+void FindIDs( cptr<Key_T> keys, const Size_T count, mptr<std::pair<Size_T,ID_T>> result ) const
+{
+    const Size_T c_max = CrossingCount();
+    
+    // Counting sort of the positions by crossing count; keys out of range are answered right away.
+    std::vector<Size_T> c_ptr ( c_max + Size_T(2), Size_T(0) );
+    
+    for( Size_T i = 0; i < count; ++i )
+    {
+        const Size_T c = MacLeodCodeLength(keys[i]);
+        
+        if( (c < Size_T(3)) || (c > c_max) )
+        {
+            result[i] = {c, not_found};
+        }
+        else
+        {
+            ++c_ptr[c + Size_T(1)];
+        }
+    }
+    
+    for( Size_T c = 0; c <= c_max; ++c )
+    {
+        c_ptr[c + Size_T(1)] += c_ptr[c];
+    }
+    
+    std::vector<Size_T> pos   ( c_ptr[c_max + Size_T(1)] );
+    std::vector<Key_T>  group ( pos.size() );
+    std::vector<ID_T>   ids   ( pos.size() );
+    
+    {
+        std::vector<Size_T> fill ( c_ptr.begin(), c_ptr.end() - 1 );
+        
+        for( Size_T i = 0; i < count; ++i )
+        {
+            const Size_T c = MacLeodCodeLength(keys[i]);
+            
+            if( (c < Size_T(3)) || (c > c_max) ) { continue; }
+            
+            const Size_T j = fill[c]++;
+            pos  [j] = i;
+            group[j] = keys[i];
+        }
+    }
+    
+    for( Size_T c = 3; c <= c_max; ++c )
+    {
+        const Size_T begin = c_ptr[c];
+        const Size_T end   = c_ptr[c + Size_T(1)];
+        
+        if( begin == end ) { continue; }
+        
+        subtables[c].FindIDs( &group[begin], end - begin, &ids[begin] );
+        
+        for( Size_T j = begin; j < end; ++j )
+        {
+            result[pos[j]] = {c, ids[j]};
+        }
+    }
+}
+
+/*!@brief Look up `count` MacLeod codes of `n` crossings each, stored one after another in `s_mac_leods`, and write the number of crossings and the ID of code `i` to `result[i]`. See `FindIDs` for keys.
+ */
+template<IntQ T>
+void FindIDs( cptr<T> s_mac_leods, const Size_T n, const Size_T count, mptr<std::pair<Size_T,ID_T>> result ) const
+{
+    if( (n < Size_T(3)) || (n > CrossingCount()) )
+    {
+        std::fill_n( result, count, std::pair<Size_T,ID_T>{n, not_found} );
+        return;
+    }
+    
+    std::vector<Key_T> keys ( count );
+    std::vector<ID_T>  ids  ( count );
+    
+    for( Size_T i = 0; i < count; ++i )
+    {
+        keys[i] = MacLeodCodeToKey( &s_mac_leods[n * i], n );
+    }
+    
+    subtables[n].FindIDs( keys.data(), count, ids.data() );
+    
+    for( Size_T i = 0; i < count; ++i )
+    {
+        result[i] = {n, ids[i]};
+    }
+}
+
+// Syntax sugar.
+
+/*!@brief Return the number of crossings and the ID for each row of `s_mac_leods`, which holds one MacLeod code per row. See `FindIDs` for keys.
+ */
+template<IntQ T, IntQ Int>
+std::vector<std::pair<Size_T,ID_T>> FindIDs( cref<Tensor2<T,Int>> s_mac_leods ) const
+{
+    const Size_T count = static_cast<Size_T>(s_mac_leods.Dim(0));
+    
+    std::vector<std::pair<Size_T,ID_T>> result ( count );
+    
+    FindIDs( s_mac_leods.data(), static_cast<Size_T>(s_mac_leods.Dim(1)), count, result.data() );
+    
+    return result;
 }
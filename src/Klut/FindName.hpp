@@ -1,7 +1,7 @@
 private:
 
 template<bool testQ = true, IntQ Int>
-std::string FindName_impl( cref<Key_T> key, Int n  )
+std::string FindName_impl( cref<Key_T> key, Int n  ) const
 {
     const Size_T c = static_cast<Size_T>(n);
     
@@ -18,7 +18,7 @@ std::string FindName_impl( cref<Key_T> key, Int n  )
 public:
 
 template<IntQ Int>
-std::string FindName( cref<Key_T> key, Int n  )
+std::string FindName( cref<Key_T> key, Int n  ) const
 {
     const Size_T c = static_cast<Size_T>(n);
     
@@ -29,7 +29,7 @@ std::string FindName( cref<Key_T> key, Int n  )
     return FindName_impl<false>(key,c);
 }
 
-std::string FindName( cref<Key_T> key )
+std::string FindName( cref<Key_T> key ) const
 {
     const Size_T c = static_cast<Size_T>(CrossingCount(key));
     
@@ -42,7 +42,7 @@ std::string FindName( cref<Key_T> key )
 
 
 template<typename T, IntQ Int>
-std::string FindName( cptr<T> s_mac_leod, Int n )
+std::string FindName( cptr<T> s_mac_leod, Int n ) const
 {
     const Size_T c = static_cast<Size_T>(n);
     
@@ -55,26 +55,26 @@ std::string FindName( cptr<T> s_mac_leod, Int n )
 
 /*!@brief Return the name of the knot class belonging to the MacLeodCode `s_mac_leod`; returns `std::string("NotFound")` if it is not found in the lookup table.*/
 template<typename T, IntQ Int>
-std::string FindName( cref<Tensor1<T,Int>> s_mac_leod )
+std::string FindName( cref<Tensor1<T,Int>> s_mac_leod ) const
 {
     return FindName( &s_mac_leod[0], static_cast<Size_T>(s_mac_leod.Size()) );
 }
 
 /*!@brief Return the name of the knot class belonging to the MacLeodCode `s_mac_leod`; returns `std::string("NotFound")` if it is not found in the lookup table.*/
 template<typename T, IntQ Int>
-std::string FindName( cref<std::vector<T,Int>> s_mac_leod )
+std::string FindName( cref<std::vector<T,Int>> s_mac_leod ) const
 {
     return FindName( &s_mac_leod[0], s_mac_leod.size() );
 }
 
-std::string FindName( std::string_view s_mac_leod )
+std::string FindName( std::string_view s_mac_leod ) const
 {
     return FindName( &s_mac_leod[0], s_mac_leod.size() );
 }
 
 /*!@brief Return the name of the knot class belonging to the `PlanarDiagram` `pd`; returns `std::string("NotFound")` if it is not found in the lookup table.*/
 template<IntQ Int>
-std::string FindName( cref<PlanarDiagram<Int>> pd )
+std::string FindName( cref<PlanarDiagram<Int>> pd ) const
 {
     if( pd.InvalidQ() ) { return "Invalid"; }
     
@@ -84,13 +84,16 @@ std::string FindName( cref<PlanarDiagram<Int>> pd )
     
     if( pd.LinkComponentCount() > Int(1) ) { return "NotFound"; }
     
-    pd.template WriteMacLeodCode<CodeInt>(s_mac_leod_buffer.data());
+    // Scratch space on the stack keeps this reentrant.
+    std::array<CodeInt,max_crossing_count> s_mac_leod {};
     
-    return FindName( &s_mac_leod_buffer[0], c );
+    pd.template WriteMacLeodCode<CodeInt>(s_mac_leod.data());
+    
+    return FindName( s_mac_leod.data(), c );
 }
 
 
-std::string FindName( cref<std::pair<Size_T,ID_T>> id )
+std::string FindName( cref<std::pair<Size_T,ID_T>> id ) const
 {
     const Size_T c = id.first;
     const ID_T   i = id.second;
@@ -111,8 +114,12 @@ std::string FindName( cref<std::pair<Size_T,ID_T>> id )
     {
         return "NotFound";
     }
+    else if( std::cmp_greater_equal(i,subtables[c].KnotCount()) )
+    {
+        return "Error";
+    }
     else
     {
-        return subtables[c].knot_names[i];
+        return Name_T(subtables[c].KnotName(i));
     }
 }
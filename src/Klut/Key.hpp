@@ -45,3 +45,87 @@ static Key_T MacLeodCodeToKey( cref<std::vector<T>> s_mac_leod )
 {
     return MacLeodCodeToKey( &s_mac_leod[0], s_mac_leod.size() );
 }
+
+/*!@brief Return the number of bits per crossing in a packed key of an `n`-crossing MacLeod code. Each entry is `(leap << 2) | over | right` with `leap` in [1,2n[; so it fits into `bit_width(2n-1) + 2` bits, e.g., 7 bits for up to 16 crossings.*/
+static constexpr Size_T PackedKeyBitCount( const Size_T n )
+{
+    return (n < Size_T(1)) ? Size_T(0) : ToSize_T(std::bit_width(Size_T(2) * n - Size_T(1))) + Size_T(2);
+}
+
+/*!@brief Return the number of bytes of a packed key of an `n`-crossing MacLeod code.*/
+static constexpr Size_T PackedKeyByteCount( const Size_T n )
+{
+    return (n * PackedKeyBitCount(n) + Size_T(7)) / Size_T(8);
+}
+
+/*!@brief Whether each of the first `n` entries of `key` fits into `PackedKeyBitCount(n)` bits. This holds for every MacLeod code of an `n`-crossing diagram, but not necessarily for arbitrary input.*/
+static bool PackableKeyQ( cref<Key_T> key, const Size_T n )
+{
+    cptr<CodeInt> ptr = reinterpret_cast<const CodeInt *>(&key[0]);
+    
+    const Size_T b = PackedKeyBitCount(n);
+    
+    for( Size_T i = 0; i < n; ++i )
+    {
+        if( (Size_T(ptr[i]) >> b) != Size_T(0) ) { return false; }
+    }
+    
+    return true;
+}
+
+/*!@brief Write the first `n` entries of `key` with `PackedKeyBitCount(n)` bits each to `packed`, most significant bit first. So `std::memcmp` on packed keys of the same length orders them like the MacLeod codes. The last byte is padded with zeroes. A packed key is never longer than `Key_T`.*/
+static void PackKey( cref<Key_T> key, const Size_T n, mptr<UInt8> packed )
+{
+    cptr<CodeInt> ptr = reinterpret_cast<const CodeInt *>(&key[0]);
+    
+    const Size_T b = PackedKeyBitCount(n);
+    
+    UInt64 buffer = 0; // Holds less than 8 + b bits.
+    Size_T bits   = 0;
+    Size_T j      = 0;
+    
+    for( Size_T i = 0; i < n; ++i )
+    {
+        buffer = (buffer << b) | UInt64(ptr[i]);
+        bits  += b;
+        
+        while( bits >= Size_T(8) )
+        {
+            bits -= Size_T(8);
+            packed[j++] = static_cast<UInt8>(buffer >> bits);
+        }
+    }
+    
+    if( bits > Size_T(0) )
+    {
+        packed[j] = static_cast<UInt8>(buffer << (Size_T(8) - bits));
+    }
+}
+
+/*!@brief Inverse of `PackKey`.*/
+static Key_T UnpackKey( cptr<UInt8> packed, const Size_T n )
+{
+    Key_T key = {};
+    mptr<CodeInt> ptr = reinterpret_cast<CodeInt *>(&key[0]);
+    
+    const Size_T b    = PackedKeyBitCount(n);
+    const UInt64 mask = (UInt64(1) << b) - UInt64(1);
+    
+    UInt64 buffer = 0;
+    Size_T bits   = 0;
+    Size_T j      = 0;
+    
+    for( Size_T i = 0; i < n; ++i )
+    {
+        while( bits < b )
+        {
+            buffer = (buffer << 8) | UInt64(packed[j++]);
+            bits  += Size_T(8);
+        }
+        
+        bits  -= b;
+        ptr[i] = static_cast<CodeInt>((buffer >> bits) & mask);
+    }
+    
+    return key;
+}
@@ -8,15 +8,60 @@ class Subtable
     
 private:
     
+    // Unmaps the table file when the last copy of the subtable is destroyed.
+    struct TableMap_T
+    {
+        void * ptr        = nullptr;
+        Size_T byte_count = 0;
+        
+        ~TableMap_T()
+        {
+            if( ptr != nullptr ) { (void)::munmap( ptr, byte_count ); }
+        }
+    };
+    
+    // A once-flag that can be copied and assigned, so that `Subtable` stays a regular type. A copy starts unset; this is fine because the copied `loadedQ` and `failedQ` make a second call of `Read` a no-op.
+    struct LoadFlag_T
+    {
+        std::once_flag flag;
+        
+        LoadFlag_T() = default;
+        
+        LoadFlag_T( const LoadFlag_T & ) {}
+        
+        LoadFlag_T & operator=( const LoadFlag_T & )
+        {
+            std::destroy_at( &flag );
+            std::construct_at( &flag );
+            return *this;
+        }
+    };
+    
     Size_T c_count = 0;
     Path_T k_file;
     Path_T v_file;
+    Path_T t_file;
     
     LUT_T lut;
     std::vector<Name_T> knot_names;
     
-    bool loadedQ = false;
-    bool failedQ = false;
+    // Only used if the subtable was loaded from `t_file`; they point into `table_map`.
+    std::shared_ptr<TableMap_T> table_map;
+    cptr<UInt8>  t_keys         = nullptr; // packed, `t_key_byte_count` bytes each
+    cptr<ID_T>   t_ids          = nullptr;
+    cptr<UInt64> t_name_offsets = nullptr;
+    cptr<char>   t_name_pool    = nullptr;
+    Size_T       t_key_byte_count = 0;
+    Size_T       t_key_count    = 0;
+    Size_T       t_knot_count   = 0;
+    
+    bool loadedQ  = false;
+    bool failedQ  = false;
+    bool tableQ   = false;
+    bool textQ    = false; // Whether the text tables may be loaded into `lut`.
+    bool presentQ = false; // Whether a usable source was present at construction. Never changes afterwards.
+    
+    LoadFlag_T load_flag;
     
 public:
     
@@ -25,11 +70,13 @@ public:
     Subtable(
         const Size_T crossing_count,
         cref<Path_T> key_file,
-        cref<Path_T> value_file
+        cref<Path_T> value_file,
+        cref<Path_T> table_file = Path_T()
     )
     :   c_count { crossing_count }
     ,   k_file  { key_file       }
     ,   v_file  { value_file     }
+    ,   t_file  { table_file     }
     {
         if( crossing_count > max_crossing_count )
         {
@@ -38,7 +85,16 @@ public:
             return;
         }
 //        failedQ = (!ifstream(k_file).good()) || (!ifstream(v_file).good());
-        failedQ = (!std::filesystem::exists(k_file)) || (!std::filesystem::exists(v_file));
+        tableQ  = !t_file.empty() && std::filesystem::exists(t_file);
+        textQ   = (crossing_count <= max_text_crossing_count) && TextFilesQ();
+        failedQ = !tableQ && !textQ;
+        
+        if( !tableQ && !textQ && !t_file.empty() && TextFilesQ() )
+        {
+            wprint(ClassName() + ": Text tables for more than " + ToString(max_text_crossing_count) + " crossings are not loaded into memory, and there is no table file " + t_file.string() + ". Convert them with Klut::WriteTableFiles.");
+        }
+        
+        presentQ = !failedQ;
     }
     
     
@@ -52,9 +108,28 @@ public:
         return loadedQ;
     }
     
+    /*!@brief Whether a table file or loadable text tables were present at construction. Unlike `FailedQ` this does not depend on whether the table has been loaded yet; so it may be queried while other threads perform lookups.*/
+    bool AvailableQ() const
+    {
+        return presentQ;
+    }
+    
+    /*!@brief Whether both text tables exist.*/
+    bool TextFilesQ() const
+    {
+        return std::filesystem::exists(k_file) && std::filesystem::exists(v_file);
+    }
+    
+    /*!@brief Whether the subtable is (or will be) served from a memory-mapped table file.*/
+    bool TableFileQ()
+    {
+        return tableQ;
+    }
+    
+    /*!@brief Load the table if this has not happened yet. This is thread-safe: concurrent callers wait until the first one has finished loading, and all of them see the loaded table afterwards.*/
     void RequireTable()
     {
-        if( !loadedQ && !failedQ ) { Read(); }
+        std::call_once( load_flag.flag, [this](){ Read(); } );
     }
         
 private:
@@ -68,24 +143,58 @@ private:
         if( failedQ ) { return; }
         if( loadedQ ) { return; }
         
-        // TODO: Check that c_count is small enough so that we can use bytes!
+        if( tableQ )
+        {
+            if( ReadTableFile() )
+            {
+                loadedQ = true;
+                return;
+            }
+            
+            if( textQ )
+            {
+                wprint(tag() + ": Falling back to " + k_file.string() + " and " + v_file.string() + "." );
+            }
+        }
+        
+        if( !textQ )
+        {
+            failedQ = true;
+            return;
+        }
+        
         lut.clear();
         knot_names.clear();
         
+        failedQ = !ScanTextTables(
+            [this]( cref<Key_T> key, const ID_T id ) { lut.insert( std::pair{key, id} ); },
+            knot_names
+        );
+        
+        loadedQ = !failedQ;
+    }
+    
+    /*!@brief Parse the text tables `k_file` and `v_file`: call `fun(key,id)` for every key and append the knot names to `names`. Returns false (after printing an error) if the files cannot be read completely.
+     *
+     * This does not touch `lut`; so `WriteTableFile` can convert text tables that are too big to be held in a hash map.
+     */
+    template<typename F>
+    bool ScanTextTables( F && fun, mref<std::vector<Name_T>> names ) const
+    {
+        [[maybe_unused]] auto tag = [this](){ return MethodName("ScanTextTables"); };
+        
         std::ifstream v_stream ( v_file, std::ios::in );
         if( !v_stream )
         {
             eprint(tag() + ": Could not open " + v_file.string() +". Aborting with incomplete table." );
-            failedQ = true;
-            return;
+            return false;
         }
         
         std::ifstream k_stream ( k_file, std::ios::binary );
         if( !k_stream )
         {
             eprint(tag() + ": Could not open " + k_file.string() +". Aborting with incomplete table." );
-            failedQ = true;
-            return;
+            return false;
         }
         
         // v_file is supposed to contain pairs of knot_name and knot_count, separated by whitespace . Here  knot_name is a string identifier for the knot and knot_count is the number of times the knot occurs in the file.
@@ -105,7 +214,7 @@ private:
             
             v_stream >> knot_count;
             
-            knot_names.push_back( std::move(knot_name) );
+            names.push_back( std::move(knot_name) );
             
             for( Size_T i = 0; i < knot_count; ++i )
             {
@@ -117,8 +226,7 @@ private:
                     TOOLS_LOGDUMP(k_stream.fail());
                     TOOLS_LOGDUMP(k_stream.bad());
                     TOOLS_LOGDUMP(k_stream.eof());
-                    failedQ = true;
-                    return;
+                    return false;
                 }
                 
                 Key_T key = {};
@@ -126,7 +234,7 @@ private:
                 k_stream.read( reinterpret_cast<char *>(&key[0]),
                               static_cast<std::streamsize>(c_count) );
 
-                lut.insert( std::pair{std::move(key), id} );
+                fun( key, id );
                 
                 ++counter;
                 
@@ -135,7 +243,136 @@ private:
             ++id;
         }
 
-        loadedQ = !failedQ;
+        return true;
+    }
+    
+    // Maps `t_file` into memory and sets the pointers into it. Returns false if the file cannot be used; then the subtable is left unchanged.
+    bool ReadTableFile()
+    {
+        [[maybe_unused]] auto tag = [this](){ return MethodName("ReadTableFile"); };
+        
+        auto fail = [&tag,this]( const std::string & reason )
+        {
+            eprint(tag() + ": Table file " + t_file.string() + " " + reason + "." );
+            tableQ = false;
+            return false;
+        };
+        
+        const int fd = ::open( t_file.c_str(), O_RDONLY );
+        
+        if( fd < 0 ) { return fail("could not be opened"); }
+        
+        struct stat info;
+        
+        if( ::fstat( fd, &info ) != 0 )
+        {
+            ::close(fd);
+            return fail("could not be inspected");
+        }
+        
+        const Size_T file_byte_count = static_cast<Size_T>(info.st_size);
+        
+        if( file_byte_count < sizeof(TableHeader_T) )
+        {
+            ::close(fd);
+            return fail("is too small to be a table file");
+        }
+        
+        void * ptr = ::mmap( nullptr, file_byte_count, PROT_READ, MAP_SHARED, fd, 0 );
+        
+        ::close(fd);
+        
+        if( ptr == MAP_FAILED ) { return fail("could not be mapped into memory"); }
+        
+        std::shared_ptr<TableMap_T> map ( new TableMap_T{ ptr, file_byte_count } );
+        
+        cptr<std::byte> data = static_cast<cptr<std::byte>>(ptr);
+        
+        TableHeader_T h;
+        
+        std::memcpy( &h, data, sizeof(h) );
+        
+        if( std::memcmp( &h.magic[0], &table_magic[0], sizeof(h.magic) ) != 0 )
+        {
+            return fail("is not a table file of Klut");
+        }
+        
+        if( (h.version < table_version) && (h.byte_order == table_byte_order) )
+        {
+            // Not an error: the file is just stale. Rebuilding it is cheap.
+            wprint(tag() + ": Table file " + t_file.string() + " has the outdated version " + ToString(h.version) + "; rebuild it with Klut::WriteTableFiles.");
+            tableQ = false;
+            return false;
+        }
+        
+        if( (h.version != table_version) || (h.byte_order != table_byte_order) )
+        {
+            return fail("has unsupported version or byte order");
+        }
+        
+        if(
+            (h.key_byte_count != PackedKeyByteCount(c_count))
+            ||
+            (h.id_byte_count  != sizeof(ID_T))
+            ||
+            (h.crossing_count != c_count)
+        )
+        {
+            return fail("does not match this subtable");
+        }
+        
+        // Checks that a block of `count` entries of `size` bytes each fits into the file.
+        auto block_okQ = [&h]( const UInt64 offset, const UInt64 count, const UInt64 size )
+        {
+            return (offset % table_alignment == 0)
+                && (offset >= sizeof(TableHeader_T))
+                && (offset <= h.byte_count)
+                && (count <= (h.byte_count - offset) / size);
+        };
+        
+        if(
+            (h.byte_count > file_byte_count)
+            ||
+            (h.knot_count >= UInt64(not_found))
+            ||
+            !block_okQ( h.key_offset , h.key_count     , h.key_byte_count )
+            ||
+            !block_okQ( h.id_offset  , h.key_count     , sizeof(ID_T)     )
+            ||
+            !block_okQ( h.name_offset, h.knot_count + 1, sizeof(UInt64)   )
+            ||
+            !block_okQ( h.pool_offset, h.pool_byte_count, 1               )
+        )
+        {
+            return fail("is truncated or corrupted");
+        }
+        
+        cptr<UInt64> name_offsets = reinterpret_cast<cptr<UInt64>>(data + h.name_offset);
+        
+        // The names must be consecutive, so that `KnotName` never reads outside the pool.
+        for( Size_T id = 0; id < h.knot_count; ++id )
+        {
+            if( name_offsets[id] > name_offsets[id + 1] )
+            {
+                return fail("is corrupted");
+            }
+        }
+        
+        if( (name_offsets[0] != 0) || (name_offsets[h.knot_count] != h.pool_byte_count) )
+        {
+            return fail("is truncated or corrupted");
+        }
+        
+        table_map      = std::move(map);
+        t_keys         = reinterpret_cast<cptr<UInt8>>(data + h.key_offset);
+        t_ids          = reinterpret_cast<cptr<ID_T>>(data + h.id_offset);
+        t_name_offsets = name_offsets;
+        t_name_pool    = reinterpret_cast<cptr<char>>(data + h.pool_offset);
+        t_key_byte_count = h.key_byte_count;
+        t_key_count    = h.key_count;
+        t_knot_count   = h.knot_count;
+        
+        return true;
     }
     
 public:
@@ -148,13 +385,13 @@ public:
     Size_T KeyCount()
     {
         RequireTable();
-        return lut.size();
+        return tableQ ? t_key_count : lut.size();
     }
     
     Size_T KnotCount()
     {
         RequireTable();
-        return knot_names.size();
+        return tableQ ? t_knot_count : knot_names.size();
     }
     
     ID_T FindID( cref<Key_T> key )
@@ -162,6 +399,46 @@ public:
         RequireTable();
         if( failedQ ) { return error; }
         
+        if( tableQ )
+        {
+            // Such a key cannot be in the table, and it would not pack faithfully.
+            if( !PackableKeyQ( key, c_count ) ) { return not_found; }
+            
+            const Size_T w = t_key_byte_count;
+            
+            // Scratch space on the stack keeps this reentrant.
+            std::array<UInt8,sizeof(Key_T)> packed;
+            PackKey( key, c_count, packed.data() );
+            
+            // Binary search over the packed keys; they are sorted by `std::memcmp`.
+            Size_T lo = 0;
+            Size_T hi = t_key_count;
+            
+            while( lo < hi )
+            {
+                const Size_T mid = lo + (hi - lo) / 2;
+                
+                if( std::memcmp( t_keys + mid * w, packed.data(), w ) < 0 )
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            
+            if( (lo == t_key_count) || (std::memcmp( t_keys + lo * w, packed.data(), w ) != 0) )
+            {
+                return not_found;
+            }
+            
+            const ID_T id = t_ids[lo];
+            
+            // We do not validate all IDs when mapping the file; so we check them here.
+            return (static_cast<Size_T>(id) < t_knot_count) ? id : error;
+        }
+        
         auto it = lut.find(key);
 
         if( it == lut.end() ) { return not_found; }
@@ -169,6 +446,117 @@ public:
         return it->second;
     }
     
+    /*!@brief Write the IDs of the `count` keys `keys` to `ids`; this is `FindID` for many keys at once.
+     *
+     * For a memory-mapped subtable, the binary searches for `batch_lane_count` keys run in lockstep: In each step, the probed keys of all lanes are prefetched before any of them is compared. So the cache misses of the lanes overlap instead of being paid one after another. With the hash map of a text subtable, the keys are looked up one after another.
+     */
+    void FindIDs( cptr<Key_T> keys, const Size_T count, mptr<ID_T> ids )
+    {
+        RequireTable();
+        if( failedQ ) { fill_buffer( ids, error, count ); return; }
+        
+        if( !tableQ )
+        {
+            for( Size_T i = 0; i < count; ++i )
+            {
+                auto it = lut.find(keys[i]);
+                
+                ids[i] = (it == lut.end()) ? not_found : it->second;
+            }
+            return;
+        }
+        
+        for( Size_T i = 0; i < count; i += batch_lane_count )
+        {
+            FindIDs_Lanes( &keys[i], Min( batch_lane_count, count - i ), &ids[i] );
+        }
+    }
+    
+private:
+    
+    static constexpr Size_T batch_lane_count = 16;
+    
+    static void Prefetch( const void * ptr )
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch( ptr, 0, 0 );
+#else
+        (void)ptr;
+#endif
+    }
+    
+    // Interleaved binary search over the packed keys for `lane_count <= batch_lane_count` keys. Each search is the branchless lower bound: it halves the range in every step, so all lanes take the same number of steps.
+    void FindIDs_Lanes( cptr<Key_T> keys, const Size_T lane_count, mptr<ID_T> ids ) const
+    {
+        const Size_T w = t_key_byte_count;
+        
+        // Scratch space on the stack keeps this reentrant.
+        std::array<std::array<UInt8,sizeof(Key_T)>,batch_lane_count> packed;
+        std::array<Size_T,batch_lane_count> base;
+        std::array<bool,batch_lane_count> packableQ;
+        
+        for( Size_T k = 0; k < lane_count; ++k )
+        {
+            // Such a key cannot be in the table, and it would not pack faithfully.
+            packableQ[k] = PackableKeyQ( keys[k], c_count );
+            packed[k].fill( UInt8(0) );
+            
+            if( packableQ[k] ) { PackKey( keys[k], c_count, packed[k].data() ); }
+            
+            base[k] = 0;
+        }
+        
+        if( t_key_count == Size_T(0) ) { fill_buffer( ids, not_found, lane_count ); return; }
+        
+        // Invariant: the lower bound of lane k lies in [base[k], base[k] + n].
+        Size_T n = t_key_count;
+        
+        while( n > Size_T(1) )
+        {
+            const Size_T half = n / Size_T(2);
+            
+            for( Size_T k = 0; k < lane_count; ++k )
+            {
+                Prefetch( t_keys + (base[k] + half) * w );
+            }
+            
+            for( Size_T k = 0; k < lane_count; ++k )
+            {
+                if( std::memcmp( t_keys + (base[k] + half) * w, packed[k].data(), w ) < 0 )
+                {
+                    base[k] += half;
+                }
+            }
+            
+            n -= half;
+        }
+        
+        for( Size_T k = 0; k < lane_count; ++k )
+        {
+            if( std::memcmp( t_keys + base[k] * w, packed[k].data(), w ) < 0 ) { ++base[k]; }
+            
+            if( base[k] < t_key_count ) { Prefetch( &t_ids[base[k]] ); }
+        }
+        
+        for( Size_T k = 0; k < lane_count; ++k )
+        {
+            const Size_T i = base[k];
+            
+            if( !packableQ[k] || (i == t_key_count) || (std::memcmp( t_keys + i * w, packed[k].data(), w ) != 0) )
+            {
+                ids[k] = not_found;
+                continue;
+            }
+            
+            const ID_T id = t_ids[i];
+            
+            // We do not validate all IDs when mapping the file; so we check them here.
+            ids[k] = (static_cast<Size_T>(id) < t_knot_count) ? id : error;
+        }
+    }
+    
+public:
+    
     std::string FindName( cref<Key_T> key )
     {
         RequireTable();
@@ -179,9 +567,63 @@ public:
         if( id == error     ) { return "Error"; };
         if( id == not_found ) { return "NotFound"; };
         
+        return Name_T(KnotName(static_cast<ID_T>(id)));
+    }
+    
+    /*!@brief Return the name of the knot with ID `id`. The table must be loaded and `id` must be smaller than `KnotCount()`.*/
+    std::string_view KnotName( const ID_T id ) const
+    {
+        if( tableQ )
+        {
+            const UInt64 begin = t_name_offsets[id];
+            const UInt64 end   = t_name_offsets[id + ID_T(1)];
+            
+            return std::string_view( t_name_pool + begin, end - begin );
+        }
+        
         return knot_names[id];
     }
     
+    /*!@brief Return the names of all knots, ordered by ID.*/
+    std::vector<Name_T> KnotNames()
+    {
+        RequireTable();
+        
+        if( !tableQ ) { return knot_names; }
+        
+        std::vector<Name_T> names;
+        names.reserve( t_knot_count );
+        
+        for( Size_T id = 0; id < t_knot_count; ++id )
+        {
+            names.emplace_back( KnotName(static_cast<ID_T>(id)) );
+        }
+        
+        return names;
+    }
+    
+    /*!@brief Call `fun(key,id)` for all keys in the subtable. The order is unspecified.*/
+    template<typename F>
+    void ForEachKey( F && fun )
+    {
+        RequireTable();
+        
+        if( tableQ )
+        {
+            for( Size_T i = 0; i < t_key_count; ++i )
+            {
+                fun( UnpackKey( t_keys + i * t_key_byte_count, c_count ), t_ids[i] );
+            }
+        }
+        else
+        {
+            for( const auto & [key,id] : lut )
+            {
+                fun( key, id );
+            }
+        }
+    }
+    
 public:
     
     std::string MethodName( const std::string & tag ) const
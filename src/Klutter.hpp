@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 namespace Knoodle
 {
     /*!@brief The purpose of this class is to load pd diagrams generated by plantri and to filter out only those that are already minimal. This helps to generate the data underlying PrimeKnotLookupTable.
@@ -45,6 +47,8 @@ namespace Knoodle
         Path_T target_directory;
         Int crossing_count = 0;
         Size_T thread_count = 1;
+        // Number of plantri diagrams per shard of the coarse sieving; see LoadPlantriPDCodes.
+        Size_T shard_size = 64;
         
         // After sieving has finished, these two subsets contain all the Keys for diagrams that belong to a prime knot with crossing_count crossings.
         KeySet_T unidentified_ralt_keys;
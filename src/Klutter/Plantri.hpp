@@ -64,97 +64,95 @@ void LoadPlantriPDCodes(
 //        toc("Reading inputs");
     }
     
-    std::vector<KeySet_T> thread_survivors (thread_count);
+    // A checkpoint is only valid for the inputs that it was sieved from.
+    const SieveFingerprint_T fingerprint = InputFingerprint( input, input_count );
     
-    // The plantri codes are sorted in a way that many simple diagrams come first and many difficult come last.
-    // For the sake of load balancing, we randomly permute the inputs during reading.
+    // The inputs are cut into shards of `shard_size` consecutive diagrams. The workers take the next unprocessed shard from a shared counter. The plantri codes are sorted in a way that many simple diagrams come first and many difficult come last; with small shards handed out on demand, no worker is left with a block of difficult ones.
+    // Each shard's survivors are saved as a checkpoint (see `SieveShardFile`). A rerun after a crash loads the finished shards instead of sieving them again.
     
-    auto perm = Permutation<Size_T,Sequential>::RandomPermutation(
-        input_count, ID_T(1), R.RandomEngine()
-    );
+    const Size_T shard_count = (input_count + shard_size - Size_T(1)) / shard_size;
+    
+    std::vector<std::vector<Key_T>> shard_survivors (shard_count);
     
-//    valprint("elements to sieve", (Size_T(1) << crossing_count) * input_count );
+    std::atomic<Size_T> next_shard   {0};
+    std::atomic<Size_T> resumed_count {0};
+    
+    {
+        std::error_code ec;
+        std::filesystem::create_directories( SieveDirectory(), ec );
+        
+        if( ec )
+        {
+            wprint(tag() + ": Could not create " + SieveDirectory().string() + "; sieving without checkpoints.");
+        }
+    }
     
     tic("Coarse sieving");
     ParallelDo(
-        [&thread_survivors, &tag, &perm, &input, input_count, this]( Size_T thread )
+        [&shard_survivors, &next_shard, &resumed_count, &tag, &input, &fingerprint, input_count, shard_count, this]( Size_T thread )
         {
             TimeInterval thread_timer;
             thread_timer.Tic();
             
             Reapr_T reapr (R.Settings());
-            KeySet_T survivors;
-            
-            Size_T job_begin = JobPointer(input_count, thread_count, thread    );
-            Size_T job_end   = JobPointer(input_count, thread_count, thread + 1);
-            
-            const UInt64 i_max = (UInt64(1) << crossing_count );
             typename PD_T::CrossingStateContainer_T C_state (crossing_count);
             
-            for( Size_T job = job_begin; job < job_end; ++job )
+            Size_T job_count = 0;
+            
+            while( true )
             {
-                Size_T p = perm.GetPermutation()[job];
+                const Size_T shard = next_shard.fetch_add( Size_T(1), std::memory_order_relaxed );
                 
-                PD_T pd_0 = PD_T::template FromPDCode<{.signQ = false,.colorQ = false}>(
-                    input.data(p), crossing_count, false, false
-                );
+                if( shard >= shard_count ) { break; }
                 
-                if( pd_0.LinkComponentCount() > Int(1) )
+                const Size_T job_begin = shard_size * shard;
+                const Size_T job_end   = Min( input_count, job_begin + shard_size );
+                
+                if( ReadSieveShard( job_begin, job_end, fingerprint, shard_survivors[shard] ) )
                 {
-        //            wprint(tag() + ": Found diagram with more than one link component.");
+                    resumed_count.fetch_add( Size_T(1), std::memory_order_relaxed );
                     continue;
                 }
                 
-                for( UInt64 i = 0; i < i_max; ++i )
+                KeySet_T survivors;
+                
+                for( Size_T job = job_begin; job < job_end; ++job )
                 {
-                    for( Int j = 0; j < crossing_count; ++j )
-                    {
-                        C_state [j] = BooleanToCrossingState(get_bit(i,j));
-                    }
-
-                    PD_T pd (
-                        crossing_count,
-                        pd_0.Crossings().data(),
-                        C_state.data(),
-                        pd_0.Arcs().data(),
-                        pd_0.ArcStates().data()
-                    );
-                    
-                    PDC_T pdc( pd.CachelessCopy() );
-                    
-                    // We only accept pass-reduced diagrams. But we don't run Reapr.
-                    pdc.Simplify(reapr, {.embedding_trials = 0});
-                    
-                    // TODO: Make sure that pdc does not contain any spurious invalid diagrams.
-
-                    // We only collect diagrams that can be prime knots with crossing_count crossings.
-                    if ( (pdc.DiagramCount() > Int(1)) || (pdc[0].CrossingCount() < crossing_count) )
-                    {
-                        continue;
-                    }
-                    
-                    // TODO: If we knew that lut contains with every key also its chiral transformed siblings, then we could use lut to cull already here.
-                    
-                    survivors.insert(ToKey(pd));
+                    SieveDiagram( reapr, C_state, input.data(job), survivors );
                 }
                 
-            } // for( Size_T job = job_begin; job < job_end; ++job )
-            
-            thread_survivors[thread] = std::move(survivors);
+                std::vector<Key_T> keys ( survivors.begin(), survivors.end() );
+                std::sort( keys.begin(), keys.end() );
+                
+                WriteSieveShard( job_begin, job_end, fingerprint, keys );
+                
+                shard_survivors[shard] = std::move(keys);
+                
+                job_count += job_end - job_begin;
+            }
             
             thread_timer.Toc();
-            logprint(tag() + ": thread " + ToString(thread) + " time = " + ToString(thread_timer.Duration()) + "; job_count = " + ToString(job_end - job_begin)+ "." );
+            logprint(tag() + ": thread " + ToString(thread) + " time = " + ToString(thread_timer.Duration()) + "; job_count = " + ToString(job_count)+ "." );
         },
         thread_count
     );
     
-    KeySet_T survivors = std::move(thread_survivors[0]);
+    if( resumed_count > Size_T(0) )
+    {
+        logprint(tag() + ": Resumed " + ToString(resumed_count.load()) + " of " + ToString(shard_count) + " shards from " + SieveDirectory().string() + ".");
+    }
+    
+    // Merge the shards in their order and sort the result. So the fine sieving below visits the survivors in an order that does not depend on the thread count or on the scheduling.
+    std::vector<Key_T> survivors;
     
-    for( Size_T thread = 1; thread < thread_count; ++thread )
+    for( std::vector<Key_T> & keys : shard_survivors )
     {
-        survivors.merge(thread_survivors[thread]);
+        survivors.insert( survivors.end(), keys.begin(), keys.end() );
+        keys = std::vector<Key_T>();
     }
-    thread_survivors = std::vector<KeySet_T>();
+    
+    std::sort( survivors.begin(), survivors.end() );
+    survivors.erase( std::unique( survivors.begin(), survivors.end() ), survivors.end() );
     
     toc("Coarse sieving");
     
@@ -206,4 +204,196 @@ void LoadPlantriPDCodes(
     
     plantri_loadedQ = true;
     
+    // The checkpoints are only needed to resume an interrupted run.
+    {
+        std::error_code ec;
+        std::filesystem::remove_all( SieveDirectory(), ec );
+    }
+    
 } // LoadPlantriPDCodes
+
+/*!@brief Return the directory for the checkpoints of the coarse sieving.
+ *
+ * A checkpoint records the crossing count, the range of inputs that it covers, and a fingerprint of the plantri file (see `InputFingerprint`). Checkpoints of a different plantri file are ignored and overwritten.
+ */
+Path_T SieveDirectory() const
+{
+    return working_directory / ("PlantriSieve_" + StringWithLeadingZeroes(crossing_count,Size_T(2)));
+}
+
+/*!@brief Return the checkpoint file for the survivors of the plantri diagrams with indices in `[job_begin,job_end)`.*/
+Path_T SieveShardFile( const Size_T job_begin, const Size_T job_end ) const
+{
+    return SieveDirectory() / ("Shard_" + ToString(job_begin) + "_" + ToString(job_end) + ".bin");
+}
+
+Size_T ShardSize() const
+{
+    return shard_size;
+}
+
+/*!@brief Set the number of plantri diagrams per shard of the coarse sieving. Changing it invalidates existing checkpoints.*/
+void SetShardSize( const Size_T shard_size_ )
+{
+    shard_size = Max( Size_T(1), shard_size_ );
+}
+
+private:
+
+// Runs all `2^crossing_count` crossing signs over the unsigned plantri diagram `pd_code` and inserts the keys of those that survive pass-simplification with all crossings into `survivors`.
+void SieveDiagram(
+    mref<Reapr_T> reapr,
+    mref<typename PD_T::CrossingStateContainer_T> C_state,
+    cptr<Int> pd_code,
+    mref<KeySet_T> survivors
+) const
+{
+    PD_T pd_0 = PD_T::template FromPDCode<{.signQ = false,.colorQ = false}>(
+        pd_code, crossing_count, false, false
+    );
+    
+    if( pd_0.LinkComponentCount() > Int(1) ) { return; }
+    
+    const UInt64 i_max = (UInt64(1) << crossing_count );
+    
+    for( UInt64 i = 0; i < i_max; ++i )
+    {
+        for( Int j = 0; j < crossing_count; ++j )
+        {
+            C_state [j] = BooleanToCrossingState(get_bit(i,j));
+        }
+
+        PD_T pd (
+            crossing_count,
+            pd_0.Crossings().data(),
+            C_state.data(),
+            pd_0.Arcs().data(),
+            pd_0.ArcStates().data()
+        );
+        
+        PDC_T pdc( pd.CachelessCopy() );
+        
+        // We only accept pass-reduced diagrams. But we don't run Reapr.
+        pdc.Simplify(reapr, {.embedding_trials = 0});
+        
+        // TODO: Make sure that pdc does not contain any spurious invalid diagrams.
+
+        // We only collect diagrams that can be prime knots with crossing_count crossings.
+        if ( (pdc.DiagramCount() > Int(1)) || (pdc[0].CrossingCount() < crossing_count) )
+        {
+            continue;
+        }
+        
+        // TODO: If we knew that lut contains with every key also its chiral transformed siblings, then we could use lut to cull already here.
+        
+        survivors.insert(ToKey(pd));
+    }
+}
+
+// Byte count of the plantri file and a hash of the parsed PD codes.
+using SieveFingerprint_T = std::array<UInt64,2>;
+
+SieveFingerprint_T InputFingerprint( cref<Tensor3<Int,Int>> input, const Size_T input_count ) const
+{
+    std::error_code ec;
+    const auto byte_count = std::filesystem::file_size( PlantriPDCodeFile(), ec );
+    
+    Size_T hash = input_count;
+    
+    cptr<Int> a = input.data();
+    
+    const Size_T entry_count = input_count * ToSize_T(crossing_count) * Size_T(4);
+    
+    for( Size_T i = 0; i < entry_count; ++i )
+    {
+        HashCombine( hash, a[i] );
+    }
+    
+    return SieveFingerprint_T{ ec ? UInt64(0) : static_cast<UInt64>(byte_count), static_cast<UInt64>(hash) };
+}
+
+// A checkpoint starts with crossing_count, job_begin, job_end, the two words of the input fingerprint, and the number of keys as `UInt64`; the keys follow. It is written to a temporary file that is renamed when complete, so a crash cannot leave a truncated checkpoint under the final name.
+bool ReadSieveShard(
+    const Size_T job_begin, const Size_T job_end, cref<SieveFingerprint_T> fingerprint, mref<std::vector<Key_T>> keys
+) const
+{
+    const Path_T file = SieveShardFile(job_begin,job_end);
+    
+    std::ifstream stream ( file, std::ios::binary );
+    
+    if( !stream ) { return false; }
+    
+    std::array<UInt64,6> header {};
+    
+    stream.read( reinterpret_cast<char *>(header.data()), sizeof(header) );
+    
+    std::error_code ec;
+    const auto byte_count = std::filesystem::file_size( file, ec );
+    
+    if(
+        !stream || ec
+        || (header[0] != static_cast<UInt64>(crossing_count))
+        || (header[1] != job_begin)
+        || (header[2] != job_end)
+        || (byte_count != sizeof(header) + header[5] * sizeof(Key_T))
+    )
+    {
+        wprint(MethodName("ReadSieveShard") + ": Ignoring malformed checkpoint " + file.string() + ".");
+        return false;
+    }
+    
+    if( (header[3] != fingerprint[0]) || (header[4] != fingerprint[1]) )
+    {
+        wprint(MethodName("ReadSieveShard") + ": Ignoring checkpoint " + file.string() + " because it was written for a different " + PlantriPDCodeFile().string() + ".");
+        return false;
+    }
+    
+    keys.resize( header[5] );
+    
+    stream.read( reinterpret_cast<char *>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(Key_T)) );
+    
+    if( !stream )
+    {
+        wprint(MethodName("ReadSieveShard") + ": Ignoring malformed checkpoint " + file.string() + ".");
+        keys.clear();
+        return false;
+    }
+    
+    return true;
+}
+
+void WriteSieveShard(
+    const Size_T job_begin, const Size_T job_end, cref<SieveFingerprint_T> fingerprint, cref<std::vector<Key_T>> keys
+) const
+{
+    const Path_T file = SieveShardFile(job_begin,job_end);
+    Path_T temp_file = file;
+    temp_file += ".tmp";
+    
+    {
+        std::ofstream stream ( temp_file, std::ios::binary );
+        
+        const std::array<UInt64,6> header {
+            static_cast<UInt64>(crossing_count), job_begin, job_end, fingerprint[0], fingerprint[1], keys.size()
+        };
+        
+        stream.write( reinterpret_cast<const char *>(header.data()), sizeof(header) );
+        stream.write( reinterpret_cast<const char *>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(Key_T)) );
+        
+        if( !stream )
+        {
+            wprint(MethodName("WriteSieveShard") + ": Could not write checkpoint " + temp_file.string() + ".");
+            return;
+        }
+    }
+    
+    std::error_code ec;
+    std::filesystem::rename( temp_file, file, ec );
+    
+    if( ec )
+    {
+        wprint(MethodName("WriteSieveShard") + ": Could not rename " + temp_file.string() + " to " + file.string() + ".");
+    }
+}
+
+public:
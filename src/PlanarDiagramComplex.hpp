@@ -1,5 +1,9 @@
 #pragma  once
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
 namespace Knoodle
 {
     /*!@brief A class for storing and manipulating several planar diagrams. Its `Simplify` routine attempts to compute a prime link decomposition. Edge colors are used to track how the links have to be glued back to one connected link diagram.
@@ -44,6 +48,8 @@ namespace Knoodle
         
         using PassSimplifier_T      = PassSimplifier<Int>;
         using Dijkstra_T            = PassSimplifier_T::Dijkstra_T;
+        /*!@brief Alias for `SimplifyWorkspace`.*/
+        using Workspace_T           = SimplifyWorkspace<Int>;
         
         /*!@brief Alias for `OrthoDraw`.*/
         using OrthoDraw_T           = OrthoDraw<PD_T>;
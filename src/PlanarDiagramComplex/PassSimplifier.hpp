@@ -6,9 +6,12 @@ namespace Knoodle
     {
         Unidirectional = 0,
         Alternating    = 1,
-        Bidirectional  = 2
+        Bidirectional  = 2,
+        Guided         = 3  // Bidirectional; each layer is swept in the order of landmark (ALT) bounds.
     };
     
+    static constexpr Size_T DijkstraStrategyCount = 4;
+    
     std::string ToString( const DijkstraStrategy_T strategy )
     {
         switch( strategy )
@@ -16,6 +19,7 @@ namespace Knoodle
             case DijkstraStrategy_T::Unidirectional : return "Unidirectional";
             case DijkstraStrategy_T::Alternating    : return "Alternating";
             case DijkstraStrategy_T::Bidirectional  : return "Bidirectional";
+            case DijkstraStrategy_T::Guided         : return "Guided";
             default                                 : return "Unknown";
         }
     }
@@ -97,7 +101,8 @@ namespace Knoodle
         
     private:
 
-        PDC_T & TOOLS_RESTRICT pdc;
+        // Receives the unlinks and Hopf links that are split off; see `Bind`.
+        PDC_T * TOOLS_RESTRICT pdc;
 
         PD_T  * TOOLS_RESTRICT pd = nullptr;
 
@@ -132,10 +137,10 @@ namespace Knoodle
     public:
         
         PassSimplifier( PDC_T & pdc_, DijkstraStrategy_T strategy_ )
-        :   pdc                { pdc_      }
+        :   pdc                { &pdc_     }
         ,   strategy           { strategy_ }
         {
-            Allocate(pdc.MaxMaxCrossingCount());
+            Allocate(pdc->MaxMaxCrossingCount());
         }
         
         // No default constructor
@@ -219,6 +224,9 @@ namespace Knoodle
                 Allocate(pd->max_crossing_count);
             }
 
+            // The landmark distances belong to the previous diagram (or to an older state of this one).
+            landmarks_validQ = false;
+
             if( current_mark >= static_cast<Int>(max_mark/Int(2)) )
             {
                 ResetMarks();
@@ -290,6 +298,17 @@ namespace Knoodle
             
             return *this;
         }
+        
+        /*!@brief Attach this instance to the complex `pdc_`, which then receives the unlinks and Hopf links split off during simplification. All buffers are kept, so one instance can serve many complexes in turn (see `SimplifyWorkspace`). Must not be called while a diagram is loaded.
+         */
+        mref<PassSimplifier> Bind( PDC_T & pdc_ )
+        {
+            PD_ASSERT( pd == nullptr );
+            
+            pdc = &pdc_;
+            
+            return *this;
+        }
 
 #include "PassSimplifier/DualArcs.hpp"
 #include "PassSimplifier/Marks.hpp"
@@ -300,6 +319,7 @@ namespace Knoodle
 #include "PassSimplifier/CollapseArcRange.hpp"
 #include "PassSimplifier/RerouteLoopPass.hpp"
 #include "PassSimplifier/FindShortestPath.hpp"
+#include "PassSimplifier/Landmarks.hpp"
 #include "PassSimplifier/Reroute.hpp"
 #include "PassSimplifier/Reidemeister.hpp"
 #include "PassSimplifier/Strings.hpp"
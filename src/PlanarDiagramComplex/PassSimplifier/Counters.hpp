@@ -23,6 +23,22 @@ void ResetCounters()
     post_strand_size_aggregator.clear();
 }
 
+/*!@brief Appends the recorded values of `other` to the ones of this instance. Used to collect the counters of the workers of a parallel `Simplify`.
+ */
+void MergeCounters( cref<PassSimplifier> other )
+{
+    auto append = []( mref<std::vector<Int>> a, cref<std::vector<Int>> b )
+    {
+        a.insert( a.end(), b.begin(), b.end() );
+    };
+    
+    append( dual_arc_aggregator,          other.dual_arc_aggregator          );
+    append( face_size_aggregator,         other.face_size_aggregator         );
+    append( initial_face_size_aggregator, other.initial_face_size_aggregator );
+    append( pre_strand_size_aggregator,   other.pre_strand_size_aggregator   );
+    append( post_strand_size_aggregator,  other.post_strand_size_aggregator  );
+}
+
 private:
 
 void RecordDualArc( const Int de ) const
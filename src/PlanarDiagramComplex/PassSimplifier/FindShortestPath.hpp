@@ -118,6 +118,8 @@ bool FindShortestPath(
     PD_VALPRINT("a",a);
     PD_VALPRINT("b",b);
     
+    ++CurrentDijkstraCounts().search_count;
+    
     // Two-sided graph Dijkstra to find shortest path.
     
     // Instead of two queues we use two stacks: to hold the next fronts (X_front, Y_front).
@@ -265,6 +267,7 @@ bool FindShortestPath(
         switch( strategy )
         {
             case DijkstraStrategy_T::Bidirectional:
+            case DijkstraStrategy_T::Guided:
             {
                 XQ = (X_front.Size() <= Y_front.Size());
                 break;
@@ -293,11 +296,11 @@ bool FindShortestPath(
         
         if( XQ )
         {
-            stopQ = SweepFront( Head, a_0, b_0, X_r, X_front, dual_mark, hiddenQ, forbiddenQ );
+            stopQ = SweepFront( Head, a_0, b_0, X_r, Y_r, X_front, dual_mark, hiddenQ, forbiddenQ );
         }
         else
         {
-            stopQ = SweepFront( Tail, b_0, a_0, Y_r, Y_front, dual_mark, hiddenQ, forbiddenQ );
+            stopQ = SweepFront( Tail, b_0, a_0, Y_r, X_r, Y_front, dual_mark, hiddenQ, forbiddenQ );
         }
         
         if( stopQ ) { goto Exit; }
@@ -438,6 +441,8 @@ TOOLS_FORCE_INLINE bool SweepFace(
         de = LeftDarc(de_0);
     }
     
+    ++CurrentDijkstraCounts().face_count;
+    
     do
     {
         auto [e,d] = FromDarc(de);
@@ -485,6 +490,7 @@ TOOLS_FORCE_INLINE bool SweepFace(
             
             // Beware that dual arcs with forwardQ == false have to be traversed in reverse way when the path is rerouted. This is why we may have to flip left_to_rightQ here.
             SetDualArc(e,d,forwardQ,from,dual_mark);
+            ++CurrentDijkstraCounts().dual_arc_count;
             
             Int de_next = ReverseDarc(de);
             PD_PRINT("Pushing darc de_next = " + ToString(de_next) + " to stack." );
@@ -532,7 +538,7 @@ TOOLS_FORCE_INLINE bool SweepFace(
 
 template<typename HiddenFun_T, typename ForbiddenFun_T>
 bool SweepFront(
-    const bool forwardQ, mref<Int> a_0, mref<Int> b_0, mref<Int> r, mref<Stack<Int,Int>> next_front,
+    const bool forwardQ, mref<Int> a_0, mref<Int> b_0, mref<Int> r, const Int other_r, mref<Stack<Int,Int>> next_front,
     const Int dual_mark, cref<HiddenFun_T> hiddenQ, cref<ForbiddenFun_T> forbiddenQ
 )
 {
@@ -547,6 +553,9 @@ bool SweepFront(
     swap( prev_front, next_front );
     next_front.Reset();
     
+    // Only the order within the layer changes; see Landmarks.hpp. Here b_0 is still the arc we are heading for.
+    if( strategy == DijkstraStrategy_T::Guided ) { OrderFrontByLandmarks( prev_front, b_0, r, other_r ); }
+    
     PD_VALPRINT("prev_front", prev_front);
     PD_VALPRINT("next_front", next_front);
     
@@ -125,10 +125,10 @@ static constexpr Int ReverseDarc( Int da )
 
 void CreateUnlinkFromArc( const Int a )
 {
-    pdc.CreateUnlinkFromArc(*pd,a);
+    pdc->CreateUnlinkFromArc(*pd,a);
 }
 
 void CreateHopfLinkFromArcs( const Int a, const Int b, const CrossingState_T c_state )
 {
-    pdc.CreateHopfLinkFromArcs(*pd,a,b,c_state);
+    pdc->CreateHopfLinkFromArcs(*pd,a,b,c_state);
 }
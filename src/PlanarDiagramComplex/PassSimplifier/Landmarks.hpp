@@ -0,0 +1,236 @@
+public:
+
+/*!@brief Work done by `FindShortestPath`, accumulated per `DijkstraStrategy_T`. The faces are the vertices and the marked dual arcs are the edges of the dual graph that the searches visited. `ordered_layer_count` counts the layers that `OrderFrontByLandmarks` sorted.
+ */
+struct DijkstraCounts_T
+{
+    Size_T search_count         = 0;
+    Size_T face_count           = 0;
+    Size_T dual_arc_count       = 0;
+    Size_T landmark_build_count = 0;
+    Size_T ordered_layer_count  = 0;
+
+    DijkstraCounts_T & operator+=( cref<DijkstraCounts_T> other )
+    {
+        search_count         += other.search_count;
+        face_count           += other.face_count;
+        dual_arc_count       += other.dual_arc_count;
+        landmark_build_count += other.landmark_build_count;
+        ordered_layer_count  += other.ordered_layer_count;
+
+        return *this;
+    }
+
+    friend std::string ToString( cref<DijkstraCounts_T> c )
+    {
+        return std::string("{ ")
+             +   ".search_count = "         + ToString(c.search_count)
+             + ", .face_count = "           + ToString(c.face_count)
+             + ", .dual_arc_count = "       + ToString(c.dual_arc_count)
+             + ", .landmark_build_count = " + ToString(c.landmark_build_count)
+             + ", .ordered_layer_count = "  + ToString(c.ordered_layer_count)
+             + " }";
+    }
+};
+
+cref<DijkstraCounts_T> DijkstraCounts( const DijkstraStrategy_T strategy_ ) const
+{
+    return dijkstra_counts[static_cast<Size_T>(strategy_)];
+}
+
+void ResetDijkstraCounts()
+{
+    dijkstra_counts.fill( DijkstraCounts_T() );
+}
+
+private:
+
+std::array<DijkstraCounts_T,DijkstraStrategyCount> dijkstra_counts;
+
+mref<DijkstraCounts_T> CurrentDijkstraCounts()
+{
+    return dijkstra_counts[static_cast<Size_T>(strategy)];
+}
+
+
+// Landmarks for `DijkstraStrategy_T::Guided`.
+//
+// For a few landmark faces L, we store the distance from L to every face in the full dual graph (nothing hidden, nothing forbidden), indexed by the darcs of the face. By the triangle inequality, max_L |d(L,F) - d(L,T)| is a lower bound for d(F,T) in that graph (the "ALT" bound of A* search).
+//
+// During a search, the bound is not a lower bound any more: hiding the strand merges faces, and every reroute changes the graph. So we never prune with it. We only use it to sort the faces of the last layer of the breadth-first search, so that the faces closest to the target are swept first and the search tends to stop early in that layer. The order of the other layers does not matter: a layer that does not meet the other front is swept completely, and the next layer is the same set of faces in any order. So we sort a layer only if the bounds say that it may meet the other front. Any order of a layer gives a shortest path; so `Guided` finds paths of the same length as the other strategies, even with stale landmarks.
+//
+// The distances are computed by the first guided search after `LoadDiagram`. They are recomputed once the reroutes since then have touched more than a quarter of the arcs.
+
+static constexpr Int landmark_count = 4;
+
+Tensor2<Int,Int> L_dist;  // L_dist(l,da) is the distance from landmark l to the face left of darc da, or -1.
+Tensor1<Int,Int> L_queue;
+std::vector<std::pair<Int,Int>> L_front;
+
+Int  landmark_darc_capacity   = 0;
+Int  landmark_stale_arc_count = 0;
+bool landmarks_validQ         = false;
+
+void RequireLandmarks()
+{
+    if( landmarks_validQ ) { return; }
+
+    PD_TIMER(timer,MethodName("RequireLandmarks"));
+
+    const Int m          = pd->MaxArcCount();
+    const Int darc_count = Int(2) * m;
+
+    if( landmark_darc_capacity < darc_count )
+    {
+        landmark_darc_capacity = Int(2) * max_arc_count;
+        L_dist  = Tensor2<Int,Int>( landmark_count, landmark_darc_capacity );
+        L_queue = Tensor1<Int,Int>( landmark_darc_capacity );
+    }
+
+    landmarks_validQ         = true;
+    landmark_stale_arc_count = 0;
+    ++CurrentDijkstraCounts().landmark_build_count;
+
+    Int source = -1;
+
+    for( Int a = 0; a < m; ++a )
+    {
+        if( ArcActiveQ(a) ) { source = ToDarc(a,Head); break; }
+    }
+
+    for( Int l = 0; l < landmark_count; ++l )
+    {
+        mptr<Int> dist = L_dist.data(l);
+
+        fill_buffer( &dist[0], Int(-1), darc_count );
+
+        if( source < Int(0) ) { continue; }
+
+        LandmarkDistances( source, dist );
+
+        // The next landmark is the face farthest away from all landmarks so far.
+        Int max_d = -1;
+
+        for( Int da = 0; da < darc_count; ++da )
+        {
+            Int d = dist[da];
+
+            for( Int j = 0; j < l; ++j ) { d = Min( d, L_dist(j,da) ); }
+
+            if( d > max_d ) { max_d = d; source = da; }
+        }
+    }
+}
+
+// Breadth-first search over the faces, starting at the face left of `da_0`.
+void LandmarkDistances( const Int da_0, mptr<Int> dist )
+{
+    Int q_begin = 0;
+    Int q_end   = 0;
+
+    auto enter = [this,dist,&q_end]( const Int de_0, const Int d )
+    {
+        Int de = de_0;
+        do
+        {
+            dist[de] = d;
+            de = LeftDarc(de);
+        }
+        while( de != de_0 );
+
+        L_queue[q_end++] = de_0;
+    };
+
+    enter( da_0, Int(0) );
+
+    while( q_begin < q_end )
+    {
+        const Int de_0 = L_queue[q_begin++];
+        const Int d    = dist[de_0] + Int(1);
+
+        Int de = de_0;
+        do
+        {
+            const Int de_r = ReverseDarc(de);
+
+            if( dist[de_r] < Int(0) ) { enter( de_r, d ); }
+
+            de = LeftDarc(de);
+        }
+        while( de != de_0 );
+    }
+}
+
+// The ALT bound for the distance between the face left of `da` and the nearer of the two faces of arc `target`. 0 if some face has not been reached by the landmark searches.
+Int LandmarkBound( const Int da, const Int target ) const
+{
+    const Int t_0 = ToDarc(target,Head);
+    const Int t_1 = ReverseDarc(t_0);
+
+    Int h = 0;
+
+    for( Int l = 0; l < landmark_count; ++l )
+    {
+        const Int d   = L_dist(l,da);
+        const Int d_0 = L_dist(l,t_0);
+        const Int d_1 = L_dist(l,t_1);
+
+        if( (d < Int(0)) || (d_0 < Int(0)) || (d_1 < Int(0)) ) { return Int(0); }
+
+        h = Max( h, Min( Abs(d - d_0), Abs(d - d_1) ) );
+    }
+
+    return h;
+}
+
+// Reorders `front` so that it pops the darcs with the smallest bound towards `target` first; ties go to the smaller darc, so the order is deterministic. The other front has swept `other_r` layers around `target`; if no bound is at most `other_r + 1`, then this layer is unlikely to meet it, and `front` keeps its order.
+//
+// The faces of `front` have distance `r` from the start face, so two of them are at most `2 * r` apart, and their bounds differ by at most that much. So the bound of the top face alone tells us that most layers cannot meet the other front, and we compute the bounds of all faces only for the last few layers.
+void OrderFrontByLandmarks( mref<Stack_T> front, const Int target, const Int r, const Int other_r )
+{
+    if( front.EmptyQ() ) { return; }
+
+    RequireLandmarks();
+
+    if( LandmarkBound(front.Top(),target) > other_r + Int(1) + Int(2) * r ) { return; }
+
+    L_front.clear();
+
+    Int min_bound = Scalar::Max<Int>;
+
+    while( !front.EmptyQ() )
+    {
+        const Int de = front.Pop();
+        const Int h  = LandmarkBound(de,target);
+
+        min_bound = Min( min_bound, h );
+        L_front.push_back( { h, de } );
+    }
+
+    if( min_bound > other_r + Int(1) )
+    {
+        // Push back in the original order.
+        for( auto p = L_front.rbegin(); p != L_front.rend(); ++p ) { front.Push(p->second); }
+
+        return;
+    }
+
+    ++CurrentDijkstraCounts().ordered_layer_count;
+
+    std::sort( L_front.begin(), L_front.end(), std::greater<std::pair<Int,Int>>() );
+
+    for( cref<std::pair<Int,Int>> p : L_front ) { front.Push(p.second); }
+}
+
+// Called after each successful reroute with the number of arcs it touched.
+void NoteLandmarkChange( const Int touched_arc_count )
+{
+    if( !landmarks_validQ ) { return; }
+
+    landmark_stale_arc_count += touched_arc_count;
+
+    if( Int(4) * landmark_stale_arc_count > pd->ArcCount() )
+    {
+        landmarks_validQ = false;
+    }
+}
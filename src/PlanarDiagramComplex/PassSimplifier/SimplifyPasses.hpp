@@ -259,7 +259,7 @@ Size_T SimplifyPasses( mref<PD_T> pd_input, cref<SimplifyPasses_Args> args )
     
     if( pd_input.ValidQ() && (pd_input.CrossingCount() <= Int(1)) )
     {
-        pdc.CreateUnlink( pd_input.FirstColor() );
+        pdc->CreateUnlink( pd_input.FirstColor() );
         pd_input = PD_T::InvalidDiagram();
     }
     
@@ -311,5 +311,7 @@ bool RerouteToShortestPath( mref<Pass_T> pass, const Int max_dist, mref<Path_T>
     
     bool successQ = Reroute(pass,path);
     
+    if( successQ ) { NoteLandmarkChange( pass.arc_count + path.Size() ); }
+    
     return successQ;
 }
@@ -19,6 +19,8 @@ struct Simplify_Args_T
     
     Size_T              embedding_trials         = 0;
     Size_T              rotation_trials          = 25;
+    Size_T              rattle_thread_count      = 1;
+    Size_T              worklist_thread_count    = 1;
     bool                permute_randomQ          = true;
     Energy_T            energy                   = Energy_T::TV;
     double              scaling                  = 1.;
@@ -46,6 +48,8 @@ friend std::string ToString( cref<Simplify_Args_T> args )
     
             + ", embedding_trials = " + ToString(args.embedding_trials)
             + ", rotation_trials = " + ToString(args.rotation_trials)
+            + ", rattle_thread_count = " + ToString(args.rattle_thread_count)
+            + ", worklist_thread_count = " + ToString(args.worklist_thread_count)
             + ", permute_randomQ = " + ToString(args.permute_randomQ)
             + ", energy = " + ToString(args.energy)
     
@@ -81,6 +85,28 @@ Size_T Simplify( cref<Simplify_Args_T> args = Simplify_Args_T() )
  */
 template<PassSimplifier_T::SimplifyPasses_TArgs targs = typename PassSimplifier_T::SimplifyPasses_TArgs()>
 Size_T Simplify( mref<Reapr_T> reapr, cref<Simplify_Args_T> args = Simplify_Args_T() )
+{
+    return Simplify_Dispatch<targs>( reapr, nullptr, args );
+}
+
+/*!@brief Apply diagrammatic simplifications. If `arg.embedding_trials` and `arg.rotation_trials` are set to positive values, then also Reapr (construction of a 3D grid embedding, rotation, projection) is employed.
+ *
+ * In contrast to the overload without `workspace`, the `PassSimplifier` and the scratch complexes of the parallel helpers are taken from `workspace`, so their buffers are reused by the next call. This is meant for callers that simplify many complexes in a row; keep one `Workspace_T` per thread.
+ *
+ * Beware: The options of the `Reapr` instance `reapr` override some of the options in `args`.
+ */
+template<PassSimplifier_T::SimplifyPasses_TArgs targs = typename PassSimplifier_T::SimplifyPasses_TArgs()>
+Size_T Simplify(
+    mref<Reapr_T> reapr, mref<Workspace_T> workspace, cref<Simplify_Args_T> args = Simplify_Args_T()
+)
+{
+    return Simplify_Dispatch<targs>( reapr, &workspace, args );
+}
+
+private:
+
+template<PassSimplifier_T::SimplifyPasses_TArgs targs>
+Size_T Simplify_Dispatch( mref<Reapr_T> reapr, Workspace_T * workspace, cref<Simplify_Args_T> args )
 {
     TOOLS_PTIMER(timer,MethodName("Simplify"));
     
@@ -90,23 +116,23 @@ Size_T Simplify( mref<Reapr_T> reapr, cref<Simplify_Args_T> args = Simplify_Args
     {
         case 0:
         {
-            return Simplify_impl<0,targs>(reapr,args);
+            return Simplify_impl<0,targs>(reapr,workspace,args);
         }
         case 1:
         {
-            return Simplify_impl<1,targs>(reapr,args);
+            return Simplify_impl<1,targs>(reapr,workspace,args);
         }
         case 2:
         {
-            return Simplify_impl<2,targs>(reapr,args);
+            return Simplify_impl<2,targs>(reapr,workspace,args);
         }
         case 3:
         {
-            return Simplify_impl<3,targs>(reapr,args);
+            return Simplify_impl<3,targs>(reapr,workspace,args);
         }
         case 4:
         {
-            return Simplify_impl<4,targs>(reapr,args);
+            return Simplify_impl<4,targs>(reapr,workspace,args);
         }
         default:
         {
@@ -118,6 +144,7 @@ Size_T Simplify( mref<Reapr_T> reapr, cref<Simplify_Args_T> args = Simplify_Args
     return 0;
 }
 
+public:
 
 // Allows be to define and run several imlementation variants to test them
 Size_T Simplify_Variant( cref<Simplify_Args_T> args = Simplify_Args_T(), Size_T variant = 0 )
@@ -184,7 +211,7 @@ Size_T Simplify_Variant( cref<Simplify_Args_T> args = Simplify_Args_T(), Size_T
 private:
 
 template<UInt8 local_opt_level, PassSimplifier_T::SimplifyPasses_TArgs targs>
-Size_T Simplify_impl( mref<Reapr_T> reapr, cref<Simplify_Args_T> args )
+Size_T Simplify_impl( mref<Reapr_T> reapr, Workspace_T * workspace, cref<Simplify_Args_T> args )
 {
 //    constexpr bool debugQ = true;
     
@@ -205,7 +232,10 @@ Size_T Simplify_impl( mref<Reapr_T> reapr, cref<Simplify_Args_T> args )
     if constexpr (debugQ) { wprint(tag()+": Debug mode active."); }
     
     // By intializing S here, it will have enough internal memory for all planar diagrams.
-    mref<PassSimplifier_T> S = GetPassSimplifier(args.strategy);
+    // With a workspace, S lives outside of the cache, which `Canonicalize` clears at the end.
+    mref<PassSimplifier_T> S = (workspace != nullptr)
+                             ? workspace->PassSimplifierFor(*this,args.strategy)
+                             : GetPassSimplifier(args.strategy);
     
 #ifdef PD_COUNTERS
     S.ResetCounters();
@@ -229,149 +259,332 @@ Size_T Simplify_impl( mref<Reapr_T> reapr, cref<Simplify_Args_T> args )
         for( PD_T & pd : pd_todo ) { pd.Compress(); }
     }
 
-    PD_List_T reapr_list;
-    
-    while( !pd_todo.empty() )
+    if( args.worklist_thread_count > Size_T(1) )
+    {
+        change_count += this->template Simplify_Worklist_Parallel<local_opt_level,targs>( S, reapr, workspace, args );
+    }
+    else
     {
-        PD_T pd = std::move(pd_todo.back());
-        pd_todo.pop_back();
+        PD_List_T reapr_list;
         
-        // We allow local pattern optimization only in the very first pass for each diagram. It won't help at all in Rattle.
-        if( args.local_opt_level > UInt8(0) )
+        while( !pd_todo.empty() )
         {
-            change_count += ArcSimplifier<Int,local_opt_level,true>( *this, pd,
-                {
-                    .compression_threshold = args.compression_threshold,
-                    .compressQ             = args.compressQ
-                }
-            )();
+            PD_T pd = std::move(pd_todo.back());
+            pd_todo.pop_back();
+            
+            change_count += this->template Simplify_Diagram<local_opt_level,targs>( S, workspace, reapr, std::move(pd), reapr_list, args );
         }
+    }
+    
+    if constexpr (debugQ)
+    {
+        if( !pd_list.empty() ) { pd_eprint("!pd_list.empty()"); };
+        if( !pd_todo.empty() ) { pd_eprint("!pd_todo.empty()"); };
+    }
 
-        auto [pass_change_count, disconnect_count] = this->template SimplifyDiagrammatically<debugQ,targs>( S, pd, args );
-        change_count += pass_change_count;
-        change_count += disconnect_count;
-        
-        if( pd.InvalidQ() ) { continue; }
+    swap( pd_list, pd_done );
+    
+#ifdef PD_COUNTERS
+    // We need to save the counters from being erased by Canonicalize().
+    auto S_buffer = std::move(this->GetCache<PassSimplifier_T>("PassSimplifier"));
+#endif
+    
+    if( args.canonicalizeQ )
+    {
+        Canonicalize();
+    }
 
-        // If the StrandSimplifier did not find anything, then Disconnect produces a reduced diagram.
-        const bool proven_reducedQ = args.disconnectQ && (pass_change_count == Size_T(0));
-        
-        
-        if constexpr (debugQ)
-        {
-            if( proven_reducedQ && !pd.ReducedQ() )
+#ifdef PD_COUNTERS
+    this->SetCache("PassSimplifier",std::move(S_buffer));
+#endif
+    
+    if constexpr (debugQ)
+    {
+        if( !CheckAll() ) { pd_eprint(tag() + ": !CheckAll()."); }
+    }
+    
+    return change_count;
+}
+
+
+
+/*!@brief One step of the worklist of `Simplify_impl`: Simplifies the diagram `pd` diagrammatically and, if that got stuck, with `Rattle`. Whatever comes out is pushed to `pd_todo` (more work) or to `pd_done` (finished); `reapr_list` is scratch space for the split summands that go to `Rattle`. `workspace` may be `nullptr`; see `Rattle_Parallel`.
+ */
+template<UInt8 local_opt_level, PassSimplifier_T::SimplifyPasses_TArgs targs>
+Size_T Simplify_Diagram(
+    mref<PassSimplifier_T> S, Workspace_T * workspace, mref<Reapr_T> reapr, PD_T && pd,
+    mref<PD_List_T> reapr_list, cref<Simplify_Args_T> args
+)
+{
+    [[maybe_unused]] auto tag = [this]()
+    {
+        return this->MethodName("Simplify_Diagram") + "<" + ToString(local_opt_level) + ">";
+    };
+    
+    Size_T change_count = 0;
+    
+    // We allow local pattern optimization only in the very first pass for each diagram. It won't help at all in Rattle.
+    if( args.local_opt_level > UInt8(0) )
+    {
+        change_count += ArcSimplifier<Int,local_opt_level,true>( *this, pd,
             {
-                eprint(tag()+": proven_reducedQ && !pd.ReducedQ().");
+                .compression_threshold = args.compression_threshold,
+                .compressQ             = args.compressQ
             }
+        )();
+    }
+
+    auto [pass_change_count, disconnect_count] = this->template SimplifyDiagrammatically<debugQ,targs>( S, pd, args );
+    change_count += pass_change_count;
+    change_count += disconnect_count;
+    
+    if( pd.InvalidQ() ) { return change_count; }
+
+    // If the StrandSimplifier did not find anything, then Disconnect produces a reduced diagram.
+    const bool proven_reducedQ = args.disconnectQ && (pass_change_count == Size_T(0));
+    
+    
+    if constexpr (debugQ)
+    {
+        if( proven_reducedQ && !pd.ReducedQ() )
+        {
+            eprint(tag()+": proven_reducedQ && !pd.ReducedQ().");
         }
-        
-        // Split the diagrams into diagram components and push them to pd_todo for further simplification.
+    }
+    
+    // Split the diagrams into diagram components and push them to pd_todo for further simplification.
 
-        // Caution: Split is allowed to push minimal diagrams to pd_done.
-        if( (pass_change_count > Size_T(0)) || (disconnect_count > Size_T(0)) )
+    // Caution: Split is allowed to push minimal diagrams to pd_done.
+    if( (pass_change_count > Size_T(0)) || (disconnect_count > Size_T(0)) )
+    {
+        // If anything upstream changed, then we should better continue working on the split diagrams.
+        if( args.splitQ )
         {
-            // If anything upstream changed, then we should better continue working on the split diagrams.
-            if( args.splitQ )
-            {
-                change_count += Split( std::move(pd), pd_todo, proven_reducedQ );
-                continue;
-            }
-            else
-            {
-                if( proven_reducedQ && pd.AlternatingQ() ) { pd.proven_minimalQ = true; }
-                
-                PushDiagramToDo( std::move(pd) );
-                
-                continue;
-            }
+            change_count += Split( std::move(pd), pd_todo, proven_reducedQ );
+            return change_count;
         }
-        
-        // No changes were found so far. We can try reapr or we have to stop here.
-        if( args.rerouteQ && (args.embedding_trials > Size_T(0)) && (args.rotation_trials > Size_T(0)) )
+        else
+        {
+            if( proven_reducedQ && pd.AlternatingQ() ) { pd.proven_minimalQ = true; }
+            
+            PushDiagramToDo( std::move(pd) );
+            
+            return change_count;
+        }
+    }
+    
+    // No changes were found so far. We can try reapr or we have to stop here.
+    if( args.rerouteQ && (args.embedding_trials > Size_T(0)) && (args.rotation_trials > Size_T(0)) )
+    {
+        if( args.splitQ )
         {
-            if( args.splitQ )
+            if constexpr (debugQ)
             {
-                if constexpr (debugQ)
-                {
-                    if( !reapr_list.empty() ) { eprint(tag() +": !reapr_list.empty() before calling Split."); }
-                }
-                
-                change_count += Split( std::move(pd), reapr_list, proven_reducedQ );
-                
-                // If proven_reducedQ, then Split already filtered out minimal diagrams.
-                while( !reapr_list.empty() )
-                {
-                    PD_T pd_reapr = std::move(reapr_list.back());
-                    reapr_list.pop_back();
-                    
-                    change_count += this->template Rattle<debugQ,targs>( S, reapr, std::move(pd_reapr), args );
-                }
+                if( !reapr_list.empty() ) { eprint(tag() +": !reapr_list.empty() before calling Split."); }
+            }
+            
+            change_count += Split( std::move(pd), reapr_list, proven_reducedQ );
+            
+            // If proven_reducedQ, then Split already filtered out minimal diagrams.
+            while( !reapr_list.empty() )
+            {
+                PD_T pd_reapr = std::move(reapr_list.back());
+                reapr_list.pop_back();
                 
-                if constexpr (debugQ)
-                {
-                    if( !reapr_list.empty() ) { eprint(tag() +": !reapr_list.empty() after calling Split."); }
-                }
+                change_count += this->template Rattle<debugQ,targs>( S, workspace, reapr, std::move(pd_reapr), args );
             }
-            else
+            
+            if constexpr (debugQ)
             {
-                if( pd.DiagramComponentCount() <= Int(1) )
-                {
-                    change_count += this->template Rattle<debugQ,targs>( S, reapr, std::move(pd), args );
-                }
-                else
-                {
-                    // We are not allowed to split; so we cannot do better than pushing this onto the "done" pile.
-                    PushDiagramDone( std::move(pd) );
-                }
+                if( !reapr_list.empty() ) { eprint(tag() +": !reapr_list.empty() after calling Split."); }
             }
         }
         else
         {
-            // If no changes were found and if we do not want reapr, then we cannot do better than splittinh and pushing to pd_done.
-            if( args.splitQ )
+            if( pd.DiagramComponentCount() <= Int(1) )
             {
-                change_count += Split( std::move(pd), pd_done, proven_reducedQ );
+                change_count += this->template Rattle<debugQ,targs>( S, workspace, reapr, std::move(pd), args );
             }
             else
             {
+                // We are not allowed to split; so we cannot do better than pushing this onto the "done" pile.
                 PushDiagramDone( std::move(pd) );
             }
         }
-        
-    }  // while( !pd_todo.empty() )
-    
-    if constexpr (debugQ)
+    }
+    else
     {
-        if( !pd_list.empty() ) { pd_eprint("!pd_list.empty()"); };
-        if( !pd_todo.empty() ) { pd_eprint("!pd_todo.empty()"); };
+        // If no changes were found and if we do not want reapr, then we cannot do better than splittinh and pushing to pd_done.
+        if( args.splitQ )
+        {
+            change_count += Split( std::move(pd), pd_done, proven_reducedQ );
+        }
+        else
+        {
+            PushDiagramDone( std::move(pd) );
+        }
     }
+    
+    return change_count;
+}
 
-    swap( pd_list, pd_done );
+/*!@brief The parallel scheduler for the worklist of `Simplify_impl`, used if `args.worklist_thread_count > 1`.
+ *
+ * The diagrams in `pd_todo` are independent: after `Split` and `Disconnect`, each is a connected summand that carries its own arc colors. So `worklist_thread_count` workers take diagrams from a shared list and run `Simplify_Diagram` on them. Each worker owns a `Reapr` (with its own random stream, seeded from `reapr`) and a scratch complex that catches what `Simplify_Diagram` pushes. The worker's `PassSimplifier` comes from the child number `t` of `workspace` (or of a temporary workspace if `workspace` is `nullptr`). After each diagram, the worker hands its new `pd_todo` entries back to the shared list; its `pd_done` entries stay with it until all workers are idle and the list is empty. Then they are appended to `pd_done` in worker order, before `Canonicalize` runs. The colors are never touched here, so the color bookkeeping is the same as in the serial loop. The order of `pd_done` depends on the scheduling; `Canonicalize` sorts it.
+ *
+ * If a worker throws, the other workers stop after their current diagram, and the first exception is rethrown once all workers have been joined. With `PD_COUNTERS`, the counters of the workers' `PassSimplifier`s are merged into those of `S`, the `PassSimplifier` of the caller.
+ */
+template<UInt8 local_opt_level, PassSimplifier_T::SimplifyPasses_TArgs targs>
+Size_T Simplify_Worklist_Parallel(
+    mref<PassSimplifier_T> S, mref<Reapr_T> reapr, Workspace_T * workspace, cref<Simplify_Args_T> args
+)
+{
+    [[maybe_unused]] auto tag = [this]() { return this->MethodName("Simplify_Worklist_Parallel"); };
     
-#ifdef PD_COUNTERS
-    // We need to save the counters from being erased by Canonicalize().
-    auto S_buffer = std::move(this->GetCache<PassSimplifier_T>("PassSimplifier"));
-#endif
+    TOOLS_PTIMER(timer,tag());
     
-    if( args.canonicalizeQ )
+    using PRNG_T  = Reapr_T::PRNG_T;
+    using State_T = typename PRNG_T::state_type;
+    
+    const Size_T thread_count = args.worklist_thread_count;
+    
+    struct Worker_T
     {
-        Canonicalize();
+        Reapr_T       reapr;
+        PDC_T         sink;
+        Workspace_T * workspace;
+        PD_List_T     reapr_list;
+        Size_T        change_count = 0;
+    };
+    
+    Workspace_T local_workspace;
+    mref<Workspace_T> ws = (workspace != nullptr) ? *workspace : local_workspace;
+    
+    // One seed per call; the streams of the workers are 2^96 steps apart.
+    mref<PRNG_T> engine = reapr.RandomEngine();
+    const State_T seed = (State_T(engine()) << 64) | State_T(engine());
+    
+    // The workers must not move once their PassSimplifiers point to their sinks.
+    std::vector<Worker_T> workers;
+    workers.reserve(thread_count);
+    for( Size_T t = 0; t < thread_count; ++t )
+    {
+        workers.push_back(
+            Worker_T{ Reapr_T(reapr.Settings()), PDC_T(), &ws.Child(t), PD_List_T(), Size_T(0) }
+        );
+        
+        PRNG_T prng ( seed );
+        prng.advance( State_T(t) << 96 );
+        workers.back().reapr.RandomEngine() = prng;
     }
-
+    
+    PD_List_T worklist;
+    
+    using std::swap;
+    swap( worklist, pd_todo );
+    
+    std::mutex              mutex;
+    std::condition_variable cv;
+    Size_T                  busy_count = 0;   // Workers that hold a diagram.
+    std::exception_ptr      error;            // The first exception thrown by a worker.
+    
+    // Releases a diagram: decrements `busy_count` and wakes the waiting workers, also if `Simplify_Diagram` throws. Otherwise, the others would wait for `busy_count == 0` forever.
+    struct BusyGuard_T
+    {
+        std::mutex              & mutex;
+        std::condition_variable & cv;
+        Size_T                  & busy_count;
+        
+        ~BusyGuard_T()
+        {
+            {
+                const std::lock_guard<std::mutex> lock ( mutex );
+                --busy_count;
+            }
+            cv.notify_all();
+        }
+    };
+    
+    ParallelDo(
+        [&workers,&worklist,&mutex,&cv,&busy_count,&error,&args]( const Size_T thread )
+        {
+            mref<Worker_T> W = workers[thread];
+            
+            try
+            {
+                mref<PassSimplifier_T> S = W.workspace->PassSimplifierFor(W.sink,args.strategy);
+                
 #ifdef PD_COUNTERS
-    this->SetCache("PassSimplifier",std::move(S_buffer));
+                S.ResetCounters();
 #endif
+                
+                while( true )
+                {
+                    PD_T pd;
+                    {
+                        std::unique_lock<std::mutex> lock ( mutex );
+                        
+                        // Wait for work; stop when there is none and nobody can produce more, or when some worker failed.
+                        cv.wait( lock, [&worklist,&busy_count,&error]()
+                        {
+                            return !worklist.empty() || (busy_count == Size_T(0)) || error;
+                        });
+                        
+                        if( worklist.empty() || error ) { break; }
+                        
+                        pd = std::move(worklist.back());
+                        worklist.pop_back();
+                        ++busy_count;
+                    }
+                    
+                    BusyGuard_T guard { mutex, cv, busy_count };
+                    
+                    W.change_count += W.sink.template Simplify_Diagram<local_opt_level,targs>(
+                        S, W.workspace, W.reapr, std::move(pd), W.reapr_list, args
+                    );
+                    
+                    {
+                        const std::lock_guard<std::mutex> lock ( mutex );
+                        
+                        for( PD_T & pd_new : W.sink.pd_todo ) { worklist.push_back( std::move(pd_new) ); }
+                        W.sink.pd_todo.clear();
+                    }
+                }
+            }
+            catch( ... )
+            {
+                {
+                    const std::lock_guard<std::mutex> lock ( mutex );
+                    
+                    if( !error ) { error = std::current_exception(); }
+                }
+                cv.notify_all();
+            }
+        },
+        thread_count
+    );
     
-    if constexpr (debugQ)
+    if( error ) { std::rethrow_exception(error); }
+    
+    Size_T change_count = 0;
+    
+    for( mref<Worker_T> W : workers )
     {
-        if( !CheckAll() ) { pd_eprint(tag() + ": !CheckAll()."); }
+        change_count += W.change_count;
+        
+        for( PD_T & pd_finished : W.sink.pd_done ) { pd_done.push_back( std::move(pd_finished) ); }
+        
+#ifdef PD_COUNTERS
+        S.MergeCounters( W.workspace->PassSimplifierFor(W.sink,args.strategy) );
+#else
+        (void)S;
+#endif
     }
     
     return change_count;
 }
 
 
-
 /*!@brief Write everything needed to reproduce a `Rattle` projection failure.
  *
  * When `FindIntersections` keeps failing, `Rattle` gives up and returns a diagram
@@ -468,7 +681,8 @@ void DumpRattleFailure(
 
 template<bool debugQ, PassSimplifier_T::SimplifyPasses_TArgs targs>
 Size_T Rattle(
-    mref<PassSimplifier_T> S, mref<Reapr_T> reapr, PD_T && pd, cref<Simplify_Args_T> args
+    mref<PassSimplifier_T> S, Workspace_T * workspace, mref<Reapr_T> reapr, PD_T && pd,
+    cref<Simplify_Args_T> args
 )
 {
     [[maybe_unused]] auto tag = [this]() { return this->MethodName("Rattle"); };
@@ -497,6 +711,11 @@ Size_T Rattle(
     // For some reason, reapr.Embedding(pd) will break if args.permute_randomQ == false and args.compressQ == false. So, let's compress here.
     if( !args.permute_randomQ ) { pd.Compress(); }
     
+    if( (args.rattle_thread_count > Size_T(1)) && (args.embedding_trials * args.rotation_trials > Size_T(1)) )
+    {
+        return this->template Rattle_Parallel<debugQ,targs>( workspace, reapr, std::move(pd), args );
+    }
+    
     PD_T pd_1;
     
     Size_T pass_change_count = 0;
@@ -591,6 +810,22 @@ Size_T Rattle(
         if( progressQ ) { break; }
     }
     
+    return this->template Rattle_Finish<debugQ>(
+        std::move(pd), std::move(pd_1), progressQ, pass_change_count, disconnect_count, args
+    );
+}
+
+/*!@brief Hands the outcome of a `Rattle` on to the lists: On progress, the simplified diagram `pd_1` is split into `pd_todo` (or pushed there); otherwise, the original diagram `pd` goes to `pd_done`.
+ */
+template<bool debugQ>
+Size_T Rattle_Finish(
+    PD_T && pd, PD_T && pd_1, const bool progressQ,
+    const Size_T pass_change_count, const Size_T disconnect_count,
+    cref<Simplify_Args_T> args
+)
+{
+    [[maybe_unused]] auto tag = [this]() { return this->MethodName("Rattle_Finish"); };
+    
     // There are a few ways in which pd_1.InvalidQ() == true can happen:
     //  1. args.embedding_trials == 0 or args.rotation_trials == 0. But this is ruled out by an if statement above.
     //  2. pdc_new.pd_list[0] was invalid. This can happen, for example, if the generated link embedding is a multiple "eight" that can be recognized only as unlink when looking from the side. Indeed, quitting here might be correct.
@@ -635,6 +870,221 @@ Size_T Rattle(
     return pass_change_count + disconnect_count + split_count;
 }
 
+/*!@brief The parallel variant of `Rattle`, used if `args.rattle_thread_count > 1`.
+ *
+ * It works through the embedding trials in batches of `rattle_thread_count`. First the embeddings of a batch are computed concurrently. Then all their `rotation_trials` reprojections are handed out to the threads, each followed by `SimplifyDiagrammatically`. Each thread owns a `Reapr`, a copy of `pd`, and a scratch complex; its `PassSimplifier` comes from the child number `t` of `workspace` (or of a temporary workspace if `workspace` is `nullptr`). The scratch complex collects the diagrams that a trial pushes aside (unlinks from the projection, summands from `Disconnect`). Each trial draws from its own random stream, which is derived from its trial index and from a single seed drawn from `reapr`.
+ *
+ * In contrast to `Rattle`, which stops at the first trial that makes progress, all trials of a batch are evaluated. Among those that made progress, the one with the fewest remaining crossings wins, and ties are broken by the lower trial index. Only the winner's side products are merged into this complex. Hence the outcome does not depend on the scheduling of the threads; it depends only on the seed and on `rattle_thread_count`. A projection failure aborts `Rattle_Parallel` only if no trial of its batch made progress.
+ */
+template<bool debugQ, PassSimplifier_T::SimplifyPasses_TArgs targs>
+Size_T Rattle_Parallel(
+    Workspace_T * workspace, mref<Reapr_T> reapr, PD_T && pd, cref<Simplify_Args_T> args
+)
+{
+    [[maybe_unused]] auto tag = [this]() { return this->MethodName("Rattle_Parallel"); };
+    
+    TOOLS_PTIMER(timer,tag());
+    
+    using PRNG_T  = Reapr_T::PRNG_T;
+    using State_T = typename PRNG_T::state_type;
+    using Real    = typename LinkEmbedding_T::Real;
+    
+    constexpr Size_T max_projection_iter = 10;
+    constexpr Size_T no_trial            = Scalar::Max<Size_T>;
+    
+    const Size_T thread_count = args.rattle_thread_count;
+    const Size_T rot_count    = args.rotation_trials;
+    const Int    crossing_count = pd.CrossingCount();
+    
+    // One seed per call; the streams of the trials are 2^64 steps apart.
+    mref<PRNG_T> engine = reapr.RandomEngine();
+    const State_T seed = (State_T(engine()) << 64) | State_T(engine());
+    
+    auto stream = [seed,rot_count]( const Size_T embedding, const Size_T slot )
+    {
+        PRNG_T prng ( seed );
+        prng.advance( State_T(embedding * (rot_count + Size_T(1)) + slot) << 64 );
+        return prng;
+    };
+    
+    struct Trial_T
+    {
+        Size_T    index             = no_trial;
+        Int       crossing_count    = 0;
+        Size_T    pass_change_count = 0;
+        Size_T    disconnect_count  = 0;
+        PD_T      pd;
+        PD_List_T done;
+        PD_List_T todo;
+    };
+    
+    struct Worker_T
+    {
+        Reapr_T       reapr;
+        PD_T          pd;
+        PDC_T         sink;
+        Workspace_T * workspace;
+        Trial_T       best;
+    };
+    
+    Workspace_T local_workspace;
+    mref<Workspace_T> ws = (workspace != nullptr) ? *workspace : local_workspace;
+    
+    // The workers must not move once their PassSimplifiers point to their sinks.
+    std::vector<Worker_T> workers;
+    workers.reserve(thread_count);
+    for( Size_T t = 0; t < thread_count; ++t )
+    {
+        workers.push_back( Worker_T{ Reapr_T(reapr.Settings()), pd, PDC_T(), &ws.Child(t), Trial_T() } );
+    }
+    
+    std::vector<LinkEmbedding_T>   embs   ( thread_count );
+    std::vector<Tensor2<Real,Int>> coords ( thread_count );
+    
+    std::atomic<int> failed_flag { 0 };
+    
+    for( Size_T e_0 = 0; e_0 < args.embedding_trials; e_0 += thread_count )
+    {
+        const Size_T batch = Min( thread_count, args.embedding_trials - e_0 );
+        
+        ParallelDo(
+            [&workers,&embs,&coords,&stream,e_0]( const Size_T thread )
+            {
+                mref<Worker_T> W = workers[thread];
+                
+                W.reapr.RandomEngine() = stream( e_0 + thread, Size_T(0) );
+                embs[thread] = W.reapr.Embedding(W.pd);
+                coords[thread].template RequireSize<false>( embs[thread].EdgeCount(), Int(3) );
+                embs[thread].WriteVertexCoordinates( coords[thread].data() );
+            },
+            batch
+        );
+        
+        const Size_T trial_count = batch * rot_count;
+        std::atomic<Size_T> next { 0 };
+        
+        ParallelDo(
+            [&workers,&embs,&coords,&stream,&next,&failed_flag,&args,e_0,trial_count,rot_count,crossing_count,this](
+                const Size_T thread
+            )
+            {
+                mref<Worker_T> W = workers[thread];
+                mref<PassSimplifier_T> S = W.workspace->PassSimplifierFor(W.sink,args.strategy);
+                
+                while( true )
+                {
+                    const Size_T k = next.fetch_add( Size_T(1), std::memory_order_relaxed );
+                    
+                    if( k >= trial_count ) { break; }
+                    
+                    const Size_T b   = k / rot_count;
+                    const Size_T rot = k % rot_count;
+                    
+                    W.reapr.RandomEngine() = stream( e_0 + b, rot + Size_T(1) );
+                    
+                    LinkEmbedding_T emb = embs[b];
+                    
+                    int projection_flag = 0;
+                    
+                    for( Size_T pr_iter = 0; pr_iter < max_projection_iter; ++pr_iter )
+                    {
+                        emb.SetTransformationMatrix(W.reapr.RandomRotation());
+                        emb.template ReadVertexCoordinates<true>(coords[b].data());
+                        projection_flag = emb.RequireIntersections();
+                        
+                        if( projection_flag == 0 ) { break; }
+                        
+                        this->DumpRattleFailure( W.pd, emb, W.reapr, args, projection_flag );
+                    }
+                    
+                    if( projection_flag != 0 )
+                    {
+                        failed_flag.store( projection_flag, std::memory_order_relaxed );
+                        continue;
+                    }
+                    
+                    PDC_T pdc_new ( emb );
+                    
+                    // Unlinks from the projection go to the sink, like everything else this trial pushes aside.
+                    for( Size_T i = 1; i < pdc_new.pd_list.size(); ++i )
+                    {
+                        W.sink.PushDiagramDone( std::move(pdc_new.pd_list[i]) );
+                    }
+                    
+                    PD_T pd_1 = std::move(pdc_new.pd_list[0]);
+                    
+                    auto [pass_change_count,disconnect_count] = W.sink.template SimplifyDiagrammatically<debugQ,targs>(S, pd_1, args);
+                    
+                    const bool progressQ = ( pd_1.CrossingCount() < crossing_count )
+                                           ||
+                                           (disconnect_count > Size_T(0))
+                                           ||
+                                           (pd_1.DiagramComponentCount() > Int(1));
+                    
+                    // Each worker sees its trials in increasing order, so a tie never replaces an earlier trial.
+                    if( progressQ && ( (W.best.index == no_trial) || (pd_1.CrossingCount() < W.best.crossing_count) ) )
+                    {
+                        W.best.index             = (e_0 + b) * rot_count + rot;
+                        W.best.crossing_count    = pd_1.CrossingCount();
+                        W.best.pass_change_count = pass_change_count;
+                        W.best.disconnect_count  = disconnect_count;
+                        W.best.pd                = std::move(pd_1);
+                        
+                        using std::swap;
+                        swap( W.best.done, W.sink.pd_done );
+                        swap( W.best.todo, W.sink.pd_todo );
+                    }
+                    
+                    W.sink.pd_done.clear();
+                    W.sink.pd_todo.clear();
+                }
+            },
+            Min( thread_count, trial_count )
+        );
+        
+        Trial_T * winner = nullptr;
+        
+        for( mref<Worker_T> W : workers )
+        {
+            if( W.best.index == no_trial ) { continue; }
+            
+            if(
+                (winner == nullptr)
+                ||
+                (W.best.crossing_count < winner->crossing_count)
+                ||
+                ((W.best.crossing_count == winner->crossing_count) && (W.best.index < winner->index))
+            )
+            {
+                winner = &W.best;
+            }
+        }
+        
+        if( winner != nullptr )
+        {
+            for( PD_T & pd_aside : winner->done ) { pd_done.push_back( std::move(pd_aside) ); }
+            for( PD_T & pd_aside : winner->todo ) { pd_todo.push_back( std::move(pd_aside) ); }
+            
+            return this->template Rattle_Finish<debugQ>(
+                std::move(pd), std::move(winner->pd), true,
+                winner->pass_change_count, winner->disconnect_count, args
+            );
+        }
+        
+        if( failed_flag.load(std::memory_order_relaxed) != 0 )
+        {
+            eprint(tag() + ": " + LinkEmbedding_T::ClassName() + "::FindIntersections returned invalid status flag for " + ToString(max_projection_iter) + " random rotation matrices. Something must be wrong. Returning an invalid diagram. Check your results carefully.");
+            
+            PushDiagramDone( std::move(pd) );
+            return Size_T(0);
+        }
+    }
+    
+    PushDiagramDone( std::move(pd) );
+    
+    return Size_T(0);
+}
+
 
 
 // Caution: SimplifyDiagrammatically is non-exhaustive! It ends with Disconnect, and this may unlock new pass moves.
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <optional>
+
+namespace Knoodle
+{
+    /*!@brief Reusable scratch memory for `PlanarDiagramComplex::Simplify`, meant to be owned by one thread.
+     *
+     * A complex keeps its `PassSimplifier` in its cache, and `Canonicalize` clears that cache. So each call of `Simplify` reallocates the marks, the dual-arc data, the Dijkstra fronts, and the path buffer of a fresh `PassSimplifier`; in a stream of many small diagrams, this dominates the allocator traffic. A `SimplifyWorkspace` owns one `PassSimplifier` instead and lends it to whichever complex is being simplified. Its buffers only grow, to the largest diagram seen so far, and are reused afterwards.
+     *
+     * The parallel helpers of `Simplify` (`Rattle_Parallel`, `Simplify_Worklist_Parallel`) take the workspaces of their threads from `Child`, so their buffers survive the call, too.
+     *
+     * A workspace must not be used by two threads at once. It is not tied to a complex between two calls; one workspace per thread serves any number of complexes.
+     */
+    template<IntQ Int_>
+    class SimplifyWorkspace final
+    {
+    public:
+
+        using Int              = Int_;
+        using PDC_T            = PlanarDiagramComplex<Int>;
+        using PassSimplifier_T = PassSimplifier<Int>;
+        using Dijkstra_T       = DijkstraStrategy_T;
+
+        SimplifyWorkspace() = default;
+
+        ~SimplifyWorkspace() = default;
+
+        // Copying a workspace would copy scratch memory only; there is no use for it.
+        SimplifyWorkspace( const SimplifyWorkspace & other ) = delete;
+
+        SimplifyWorkspace & operator=( const SimplifyWorkspace & other ) = delete;
+
+        SimplifyWorkspace( SimplifyWorkspace && other ) = default;
+
+        SimplifyWorkspace & operator=( SimplifyWorkspace && other ) = default;
+
+    private:
+
+        std::optional<PassSimplifier_T> S;
+
+        // Behind pointers, so that the children do not move when more are added.
+        std::vector<std::unique_ptr<SimplifyWorkspace>> children;
+
+    public:
+
+        /*!@brief Returns the `PassSimplifier` of this workspace, attached to `pdc` and set to `strategy`. It is allocated on first use; afterwards, `PassSimplifier::LoadDiagram` grows its buffers whenever a bigger diagram comes along.
+         */
+        mref<PassSimplifier_T> PassSimplifierFor( mref<PDC_T> pdc, const Dijkstra_T strategy )
+        {
+            if( S.has_value() )
+            {
+                S->Bind(pdc);
+            }
+            else
+            {
+                S.emplace(pdc,strategy);
+            }
+
+            return S->SetDijkstraStrategy(strategy);
+        }
+
+        /*!@brief Returns the child workspace number `i`; it is created if necessary. The children live as long as this workspace.
+         *
+         * Not thread-safe: Parallel callers have to request all children they need before they fork.
+         */
+        mref<SimplifyWorkspace> Child( const Size_T i )
+        {
+            while( children.size() <= i )
+            {
+                children.push_back( std::make_unique<SimplifyWorkspace>() );
+            }
+
+            return *children[i];
+        }
+
+        /*!@brief The number of child workspaces created so far.
+         */
+        Size_T ChildCount() const
+        {
+            return children.size();
+        }
+
+        /*!@brief The work done by the shortest-path searches with `strategy`, summed over this workspace and its children.
+         */
+        typename PassSimplifier_T::DijkstraCounts_T DijkstraCounts( const Dijkstra_T strategy ) const
+        {
+            typename PassSimplifier_T::DijkstraCounts_T counts;
+
+            if( S.has_value() ) { counts += S->DijkstraCounts(strategy); }
+
+            for( cref<std::unique_ptr<SimplifyWorkspace>> child : children )
+            {
+                counts += child->DijkstraCounts(strategy);
+            }
+
+            return counts;
+        }
+
+        /*!@brief Releases all memory held by this workspace and its children.
+         */
+        void Clear()
+        {
+            S.reset();
+            children.clear();
+        }
+
+    public:
+
+        static constexpr std::string ClassName()
+        {
+            return std::string("SimplifyWorkspace")
+                + "<" + TypeName<Int>
+                + ">";
+        }
+
+    }; // class SimplifyWorkspace
+
+} // namespace Knoodle
@@ -3,13 +3,18 @@
 #define KNOODLE_POLYFOLD_HPP
 
 #include "ClisbyTree.hpp"
+#include "AsyncCodeWriter.hpp"
 
 // Fix for some warnings because boost uses std::numeric_limits<T>::infinity;  compiler migth throw warnings if we are in -ffast-math mode.
 #pragma float_control(precise, on, push)
 #include <boost/program_options.hpp>
 #pragma float_control(pop)
 
+#include <condition_variable>
 #include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace Knoodle
 {    
@@ -48,7 +53,17 @@ namespace Knoodle
 #else
                 .witnessesQ = 0,
 #endif
-                .manual_stackQ = 0
+                .manual_stackQ = 0,
+#ifdef POLYFOLD_FLOAT_BALLS
+                .float_ballsQ = 1,
+#else
+                .float_ballsQ = 0,
+#endif
+#ifdef POLYFOLD_TELEMETRY
+                .telemetryQ = 1
+#else
+                .telemetryQ = 0
+#endif
             }
         >;
         
@@ -63,6 +78,7 @@ namespace Knoodle
         using PD_T                      = PDC_T::PD_T;
         using IntersectionFlagCounts_T  = Link_T::IntersectionFlagCounts_T;
         using FoldFlagCounts_T          = Clisby_T::FoldFlagCounts_T;
+        using Telemetry_T               = Clisby_T::Telemetry_T;
         using PRNG_T                    = Clisby_T::PRNG_T;
         
         
@@ -78,6 +94,35 @@ namespace Knoodle
         
     private:
         
+        // State of the sampler that is stored along with the Clisby tree in a checkpoint.
+        struct CheckpointState_T
+        {
+            std::uint64_t version      = 2;
+            LInt n                     = 0;
+            LInt N                     = 0;
+            LInt burn_in               = 0;
+            LInt skip                  = 0;
+            LInt burn_in_done          = 0; // Number of burn-in attempts made by the stored tree.
+            LInt sample                = 0; // Sample that starts from the stored tree; 0 during burn-in.
+            LInt total_attempt_count   = 0;
+            LInt total_accept_count    = 0;
+            LInt burn_in_attempt_count = 0;
+            LInt burn_in_accept_count  = 0;
+            LInt unknot_counter        = 0;
+            LInt T_p_counter           = 0;
+            LInt T_m_counter           = 0;
+            LInt F8_counter            = 0;
+            LInt print_ctr             = 0;
+            FoldFlagCounts_T burn_in_counts { LInt(0) };
+            IntersectionFlagCounts_T acc_intersec_counts { Size_T(0) };
+            std::uint64_t pd_byte_count      = 0;
+            std::uint64_t gauss_byte_count   = 0;
+            std::uint64_t macleod_byte_count = 0;
+            std::uint64_t analysis_byte_count = 0;
+            std::uint64_t witness_byte_count  = 0;
+            std::uint64_t pivot_byte_count    = 0;
+        };
+        
         Real hard_sphere_diam         = 1;
         Real hard_sphere_squared_diam = 1;
         Real prescribed_edge_length   = 1;
@@ -89,6 +134,24 @@ namespace Knoodle
 
         int verbosity = 1;
         
+        Int  collision_thread_count       = 1;
+        Int  parallel_collision_threshold = 131072;
+        Int  speculation_batch_size       = 1;
+        
+        double checkpoint_interval = -1; // Seconds between checkpoints; negative means no checkpoints.
+        LInt   checkpoint_count    = 0;
+        std::filesystem::path checkpoint_file;
+        std::filesystem::path resume_file;
+        bool resumeQ = false; // Whether the tree stored in `resume_tree` still has to be used.
+        CheckpointState_T resume_state;
+        double resume_load_time = 0;
+        Clisby_T resume_tree;
+        TimeInterval T_checkpoint;
+        
+        Int  chain_count = 1;
+        Int  chain       = -1; // Index of this chain in multi-chain mode; -1 for the process itself.
+        std::string chain_prefix; // Prepended to the names of all files written by a chain.
+        
         std::filesystem::path path;
         std::filesystem::path log_file;
         std::filesystem::path pd_file;
@@ -103,6 +166,27 @@ namespace Knoodle
         std::ofstream gauss_stream;
         std::ofstream macleod_stream;
         
+        // Only used with asynchronous output; then they replace the streams above.
+        std::unique_ptr<AsyncCodeWriter> pd_writer;
+        std::unique_ptr<AsyncCodeWriter> gauss_writer;
+        std::unique_ptr<AsyncCodeWriter> macleod_writer;
+        
+        // Pipelined analysis; see PolyFold/Pipeline.hpp.
+        struct AnalysisPipeline_T;
+        
+        Int    analysis_thread_count = 0; // 0 means that samples are analyzed by the sampling thread.
+        std::unique_ptr<AnalysisPipeline_T> pipeline;
+        std::filesystem::path analysis_file;
+        std::ofstream analysis_log;
+        bool   analysis_log_appendQ          = false;
+        double total_pipelined_analysis_time = 0;
+        LInt   pipeline_stall_count          = 0;
+        double pipeline_stall_time           = 0;
+        
+        bool   async_outputQ     = false;
+        int    compression_level = 0;
+        LInt   rotate_mib        = 0;
+        
         PolygonContainer_T x;
         
         Tensor1<LInt,Int> curvature_hist;
@@ -129,6 +213,10 @@ namespace Knoodle
 
         IntersectionFlagCounts_T acc_intersec_counts;
         
+        // Only recorded with POLYFOLD_TELEMETRY.
+        Telemetry_T burn_in_telemetry;
+        Telemetry_T sample_telemetry;
+        
         TimeInterval T_run;
         
         double total_timing  = 0;
@@ -136,6 +224,7 @@ namespace Knoodle
         double total_sampling_time = 0;
         double total_analysis_time = 0;
         double total_snapshot_time = 0;
+        double total_checkpoint_time = 0;
         
         double allocation_time = 0;
         double deallocation_time = 0;
@@ -150,6 +239,7 @@ namespace Knoodle
         bool checksQ            = true;
         bool check_jointsQ      = false;
         bool hierarchicalQ      = false;
+        bool path_updatesQ      = false;
         
         bool anglesQ            = false;
         bool squared_gyradiusQ  = false;
@@ -217,6 +307,11 @@ print(R"(
                         wprint("\nOperation counters are active. You probably do not want to use this build in production!\n");
                     }
                     
+                    if constexpr ( Clisby_T::telemetryQ )
+                    {
+                        wprint("\nPivot telemetry is active. It reads the clock after each accepted move, so timings are slightly slower than in production builds.\n");
+                    }
+                    
                     if constexpr ( Clisby_T::witnessesQ )
                     {
                         wprint("\nCollection of pivots and witnesses is active. You almost certainly do not want to use this build in production as it gathers A LOT of data!\n");
@@ -275,6 +370,10 @@ print(R"(
 #include "PolyFold/Analyze.hpp"
 #include "PolyFold/FinalReport.hpp"
 #include "PolyFold/Run.hpp"
+#include "PolyFold/Chains.hpp"
+#include "PolyFold/Checkpoint.hpp"
+#include "PolyFold/CodeOutput.hpp"
+#include "PolyFold/Pipeline.hpp"
         
     public:
 
@@ -5,51 +5,159 @@ private:
 
 void WriteUnknots()
 {
+    const std::string s = "u " + ToString(unknot_counter) + "\n";
+    
     if( pdQ )
     {
-        pd_stream << "u " << unknot_counter << "\n";
-        pd_stream << std::flush;
+        WriteCode( pd_stream, pd_writer, pd_file, std::string(s) );
     }
     if( gaussQ )
     {
-        gauss_stream << "u " << unknot_counter << "\n";
-        gauss_stream << std::flush;
+        WriteCode( gauss_stream, gauss_writer, gauss_file, std::string(s) );
     }
     if( macleodQ )
     {
-        macleod_stream << "u " << unknot_counter << "\n";
-        macleod_stream << std::flush;
+        WriteCode( macleod_stream, macleod_writer, macleod_file, std::string(s) );
     }
 }
 
-std::string TrefoilString() const
+static std::string TrefoilString( const LInt T_p, const LInt T_m )
 {
     std::string s;
-    if( T_p_counter > LInt(0) )
+    if( T_p > LInt(0) )
     {
         s += "\nT+ ";
-        s += ToString(T_p_counter);
+        s += ToString(T_p);
     }
-    if( T_m_counter > LInt(0) )
+    if( T_m > LInt(0) )
     {
         s += "\nT- ";
-        s += ToString(T_m_counter);
+        s += ToString(T_m);
     }
     return s;
 }
 
-std::string FigureEightString() const
+static std::string FigureEightString( const LInt F8 )
 {
     std::string s;
-    if( F8_counter > LInt(0) )
+    if( F8 > LInt(0) )
     {
         s += "\nF8 ";
-        s += ToString(F8_counter);
+        s += ToString(F8);
     }
     return s;
 }
 
+// Counts the proven trefoils and figure-eight knots among the summands of `PDC`.
+void CountTallies( cref<PDC_T> PDC, mref<LInt> T_p, mref<LInt> T_m, mref<LInt> F8 ) const
+{
+    T_p = 0;
+    T_m = 0;
+    F8  = 0;
+    
+    for( const PD_T & PD : PDC.Diagrams() )
+    {
+        if( tally_trefoilsQ && PD.ProvenTrefoilQ() )
+        {
+            if( PD.CrossingRightHandedQ(Int(0)) )
+            {
+                ++T_p;
+            }
+            else
+            {
+                ++T_m;
+            }
+        }
+        if( tally_F8Q && PD.ProvenFigureEightQ() )
+        {
+            ++F8;
+        }
+    }
+}
+
+enum class CodeKind_T : std::int_fast8_t
+{
+    PD,
+    Gauss,
+    MacLeod
+};
 
+/*!@brief Returns the record of the codes of the simplified knot `PDC` that is written to the code file of type `kind`. Trivial summands and the tallied trefoils and figure-eight knots are not written out.
+ */
+
+std::string CodeBlock(
+    const CodeKind_T kind,
+    cref<PDC_T> PDC,
+    const LInt T_p,
+    const LInt T_m,
+    const LInt F8
+) const
+{
+    std::string block ( "k" );
+    
+    if( tally_trefoilsQ )
+    {
+        block += TrefoilString(T_p,T_m);
+    }
+    if( tally_F8Q )
+    {
+        block += FigureEightString(F8);
+    }
+    
+    for( auto & PD : PDC.Diagrams() )
+    {
+        if( PD.CrossingCount() <= 0 )
+        {
+            continue;
+        }
+        if( tally_trefoilsQ && PD.ProvenTrefoilQ() )
+        {
+            continue;
+        }
+        if( tally_F8Q && PD.ProvenFigureEightQ() )
+        {
+            continue;
+        }
+        
+        block += "\ns ";
+        block += ToString(PD.ProvenMinimalQ());
+        
+        switch( kind )
+        {
+            case CodeKind_T::PD:
+            {
+                auto code = PD.PDCode();
+                block += "\n";
+                block += OutString::FromMatrix<Format::Matrix::TSV>(
+                    code.ReadAccess(), code.Dim(0), code.Dim(1)
+                );
+                break;
+            }
+            case CodeKind_T::Gauss:
+            {
+                auto code = PD.ExtendedGaussCode();
+                block += " | ";
+                block += OutString::FromArray(
+                    code.ReadAccess(), code.Size(), "", " ", ""
+                );
+                break;
+            }
+            case CodeKind_T::MacLeod:
+            {
+                auto code = PD.MacLeodCode();
+                block += " | ";
+                block += OutString::FromArray(
+                    code.ReadAccess(), code.Size(), "", " ", ""
+                );
+                break;
+            }
+        }
+    }
+    
+    block += "\n";
+    
+    return block;
+}
 
 template<Size_T t0, int my_verbosity>
 void Analyze( const LInt i )
@@ -132,318 +240,170 @@ void Analyze( const LInt i )
     
     if( pdQ || gaussQ || macleodQ )
     {
-        T_link.Tic<V2Q>();
-        Link_T L ( n );
-
-        // Read coordinates into `Link_T` object `L`...
-        L.ReadVertexCoordinates ( x.data() );
-        T_link.Toc<V2Q>();
-        allocation_time += T_link.Duration();
-        
-        T_intersection.Tic<V2Q>();
-        
-        const int err = L.template FindIntersections<true>();
-        
-        T_intersection.Toc<V2Q>();
-        
-        const IntersectionFlagCounts_T intersection_flag_counts = L.IntersectionFlagCounts();
-        
-        acc_intersec_counts += intersection_flag_counts;
-        
-        if( (err != 0) || V1Q )
-        {
-            log << ",\n" + ct_tabs<t1> + "\"Link\" -> <|";
-                kv<t2,0>("Byte Count", L.ByteCount() );
-            if( (err != 0) || V2Q )
-            {
-                log << ",\n" + ct_tabs<t2> + "\"Byte Count Details\" -> ";
-                log << L.template AllocatedByteCountDetails<t2>();
-                
-                PrintIntersectionFlagCounts<t2>(
-                    "Intersection Flag Counts", intersection_flag_counts
-                );
-                
-                PrintIntersectionFlagCounts<t2>(
-                    "Accumulated Intersection Flag Counts", acc_intersec_counts
-                );
-            }
-            log << "\n" + ct_tabs<t1> + "|>";
-        }
-        
-        // TODO: This lets the simulation continue if closeby intersection times have been detected. Should should make this check more robust in the future.
-        if( (err != 0) && (err != 8) )
-        {
-            kv<t1>("FindIntersections Error Flag", err);
-            log << std::flush;
-            throw std::runtime_error(ClassName()+"::Analyze(" + ToString(i) + "): Error in creating the planar diagram.");
-        }
-        
-        // Deallocate tree-related data in L to make room for the PlanarDiagram.
-        if( force_deallocQ )
+        if( PipelineQ() )
         {
-            T_delete.Tic<V2Q>();
-            L.DeleteTree();
-            T_delete.Toc<V2Q>();
-            deallocation_time += T_delete.Duration();
+            // The knot analysis of this sample runs on a worker thread; see Pipeline.hpp.
+            SubmitAnalysis(i);
         }
-        
-        T_pd.Tic<V2Q>();
-        // We delay the allocation until substantial parts of L have been deallocated.
-        PDC_T PDC ( L );
-        T_pd.Toc<V2Q>();
-    
-        // Delete remainder of L to make room for the simplification.
-        if( force_deallocQ )
-        {
-            T_link_dealloc.Tic<V2Q>();
-            L = Link_T();
-            T_link_dealloc.Toc<V2Q>();
-            deallocation_time += T_link_dealloc.Duration();
-        }
-    
-        if constexpr ( V1Q )
-        {
-            log << ",\n" + ct_tabs<t1> + "\"PlanarDiagram\" -> <|";
-            kv<t2,0>("Byte Count (Before Simplification)", PDC.Diagram(0).ByteCount() );
-            kv<t2>("Crossing Count (Before Simplification)", PDC.Diagram(0).CrossingCount() );
-            log << std::flush;
-        }
-        
-//        std::vector<PD_T> pd_list;
-//        
-//        T_simplify.Tic<V2Q>();
-//        PD.Simplify5( pd_list );
-//        pd_list.push_back(std::move(PD));
-//        T_simplify.Toc<V2Q>();
-        
-        T_simplify.Tic<V2Q>();
-        PDC.Simplify();
-        T_simplify.Toc<V2Q>();
-        
-        Size_T byte_count  = 0;
-        Int crossing_count = 0;
-        
-        if( pdQ || gaussQ || macleodQ )
+        else
         {
-            T_p_counter = 0;
-            T_m_counter = 0;
-            F8_counter  = 0;
+            T_link.Tic<V2Q>();
+            Link_T L ( n );
             
-            for( const PD_T & PD : PDC.Diagrams() )
+            // Read coordinates into `Link_T` object `L`...
+            L.ReadVertexCoordinates ( x.data() );
+            T_link.Toc<V2Q>();
+            allocation_time += T_link.Duration();
+            
+            T_intersection.Tic<V2Q>();
+            
+            const int err = L.template FindIntersections<true>();
+            
+            T_intersection.Toc<V2Q>();
+            
+            const IntersectionFlagCounts_T intersection_flag_counts = L.IntersectionFlagCounts();
+            
+            acc_intersec_counts += intersection_flag_counts;
+            
+            if( (err != 0) || V1Q )
             {
-                byte_count     += PD.ByteCount();
-                crossing_count += PD.CrossingCount();
-                
-                if( tally_trefoilsQ && PD.ProvenTrefoilQ() )
+                log << ",\n" + ct_tabs<t1> + "\"Link\" -> <|";
+                    kv<t2,0>("Byte Count", L.ByteCount() );
+                if( (err != 0) || V2Q )
                 {
-                    if( PD.CrossingRightHandedQ(Int(0)) )
-                    {
-                        ++T_p_counter;
-                    }
-                    else
-                    {
-                        ++T_m_counter;
-                    }
-                }
-                if( tally_F8Q && PD.ProvenFigureEightQ() )
-                {
-                    ++F8_counter;
+                    log << ",\n" + ct_tabs<t2> + "\"Byte Count Details\" -> ";
+                    log << L.template AllocatedByteCountDetails<t2>();
+                    
+                    PrintIntersectionFlagCounts<t2>(
+                        "Intersection Flag Counts", intersection_flag_counts
+                    );
+                    
+                    PrintIntersectionFlagCounts<t2>(
+                        "Accumulated Intersection Flag Counts", acc_intersec_counts
+                    );
                 }
+                log << "\n" + ct_tabs<t1> + "|>";
             }
-        }
-        else
-        {
+            
+            // TODO: This lets the simulation continue if closeby intersection times have been detected. Should should make this check more robust in the future.
+            if( (err != 0) && (err != 8) )
+            {
+                kv<t1>("FindIntersections Error Flag", err);
+                log << std::flush;
+                throw std::runtime_error(ClassName()+"::Analyze(" + ToString(i) + "): Error in creating the planar diagram.");
+            }
+            
+            // Deallocate tree-related data in L to make room for the PlanarDiagram.
+            if( force_deallocQ )
+            {
+                T_delete.Tic<V2Q>();
+                L.DeleteTree();
+                T_delete.Toc<V2Q>();
+                deallocation_time += T_delete.Duration();
+            }
+            
+            T_pd.Tic<V2Q>();
+            // We delay the allocation until substantial parts of L have been deallocated.
+            PDC_T PDC ( L );
+            T_pd.Toc<V2Q>();
+            
+            // Delete remainder of L to make room for the simplification.
+            if( force_deallocQ )
+            {
+                T_link_dealloc.Tic<V2Q>();
+                L = Link_T();
+                T_link_dealloc.Toc<V2Q>();
+                deallocation_time += T_link_dealloc.Duration();
+            }
+            
+            if constexpr ( V1Q )
+            {
+                log << ",\n" + ct_tabs<t1> + "\"PlanarDiagram\" -> <|";
+                kv<t2,0>("Byte Count (Before Simplification)", PDC.Diagram(0).ByteCount() );
+                kv<t2>("Crossing Count (Before Simplification)", PDC.Diagram(0).CrossingCount() );
+                log << std::flush;
+            }
+            
+            T_simplify.Tic<V2Q>();
+            PDC.Simplify();
+            T_simplify.Toc<V2Q>();
+            
+            Size_T byte_count  = 0;
+            Int crossing_count = 0;
+            
             for( const PD_T & PD : PDC.Diagrams() )
             {
                 byte_count     += PD.ByteCount();
                 crossing_count += PD.CrossingCount();
             }
-        }
-                
-        
-        if constexpr ( V2Q )
-        {
-            kv<t2>("Byte Count (After Simplification)", byte_count );
-            kv<t2>("Crossing Count (After Simplification)", crossing_count );
-        }
-        
-        if constexpr ( V1Q )
-        {
-            log << "\n" + ct_tabs<t1> + "|>";
-            log << std::flush;
-        }
-        
-        if( !tally_unknotsQ || (crossing_count > Int(0)) )
-        {
-            if( tally_unknotsQ && (unknot_counter > LInt(0)) )
+            
+            CountTallies( PDC, T_p_counter, T_m_counter, F8_counter );
+            
+            if constexpr ( V2Q )
             {
-                WriteUnknots();
-                unknot_counter = 0;
+                kv<t2>("Byte Count (After Simplification)", byte_count );
+                kv<t2>("Crossing Count (After Simplification)", crossing_count );
             }
             
-            if( pdQ )
+            if constexpr ( V1Q )
             {
-                if constexpr ( V2Q ) { T_pd_write.Tic(); }
-                
-                // Writing the PD codes to file.
-                pd_stream << "k";
-                if( tally_trefoilsQ )
-                {
-                    pd_stream << TrefoilString();
-                }
-                if( tally_F8Q )
-                {
-                    pd_stream << FigureEightString();
-                }
-                
-                for( auto & PD : PDC.Diagrams() )
-                {
-                    if( PD.CrossingCount() <= 0 )
-                    {
-                        continue;
-                    }
-                    if( tally_trefoilsQ && PD.ProvenTrefoilQ() )
-                    {
-                        continue;
-                    }
-                    if( tally_F8Q && PD.ProvenFigureEightQ() )
-                    {
-                        continue;
-                    }
-                    
-                    auto code = PD.PDCode();
-                    
-                    pd_stream << "\ns ";
-                    pd_stream << ToString(PD.ProvenMinimalQ());
-                    pd_stream << "\n";
-                    pd_stream << OutString::FromMatrix<Format::Matrix::TSV>(
-                        code.ReadAccess(), code.Dim(0), code.Dim(1)
-                    );
-                }
-                
-                pd_stream << "\n";
-                pd_stream << std::flush;
-                if( !pd_stream )
-                {
-                    throw std::runtime_error(ClassName()+"::Analyze(" + ToString(i) + "): Failed to write to file \"" + pd_file.string() + "\".");
-                }
-                
-                if constexpr ( V2Q ) { T_pd_write.Toc(); }
+                log << "\n" + ct_tabs<t1> + "|>";
+                log << std::flush;
             }
             
-            if ( gaussQ )
+            if( !tally_unknotsQ || (crossing_count > Int(0)) )
             {
-                if constexpr ( V2Q ) { T_gauss_write.Tic(); }
-                
-                // Writing the PD codes to file.
-                gauss_stream << "k";
-                if( tally_trefoilsQ )
-                {
-                    gauss_stream << TrefoilString();
-                }
-                if( tally_F8Q )
+                if( tally_unknotsQ && (unknot_counter > LInt(0)) )
                 {
-                    gauss_stream << FigureEightString();
+                    WriteUnknots();
+                    unknot_counter = 0;
                 }
                 
-                for( auto & PD : PDC.Diagrams() )
+                if( pdQ )
                 {
-                    if( PD.CrossingCount() <= 0 )
-                    {
-                        continue;
-                    }
-                    if( tally_trefoilsQ && PD.ProvenTrefoilQ() )
-                    {
-                        continue;
-                    }
-                    if( tally_F8Q && PD.ProvenFigureEightQ() )
-                    {
-                        continue;
-                    }
+                    if constexpr ( V2Q ) { T_pd_write.Tic(); }
                     
-                    auto code = PD.ExtendedGaussCode();
-                    gauss_stream << "\ns ";
-                    gauss_stream << ToString(PD.ProvenMinimalQ());
-                    gauss_stream << " | ";
-                    gauss_stream << OutString::FromArray(
-                        code.ReadAccess(), code.Size(), "", " ", ""
+                    WriteCode( pd_stream, pd_writer, pd_file,
+                        CodeBlock( CodeKind_T::PD, PDC, T_p_counter, T_m_counter, F8_counter )
                     );
+                    
+                    if constexpr ( V2Q ) { T_pd_write.Toc(); }
                 }
                 
-                gauss_stream << "\n";
-                gauss_stream << std::flush;
-                if( !gauss_stream )
-                {
-                    throw std::runtime_error( ClassName()+"::Analyze(" + ToString(i) + "): Failed to write to file \"" + gauss_file.string() + "\".");
-                }
-                
-                if constexpr ( V2Q ) { T_gauss_write.Toc(); }
-            }
-            
-            if ( macleodQ )
-            {
-                if constexpr ( V2Q ) { T_macleod_write.Tic(); }
-                
-                // Writing the PD codes to file.
-                macleod_stream << "k";
-                if( tally_trefoilsQ )
+                if ( gaussQ )
                 {
-                    macleod_stream << TrefoilString();
-                }
-                if( tally_F8Q )
-                {
-                    macleod_stream << FigureEightString();
+                    if constexpr ( V2Q ) { T_gauss_write.Tic(); }
+                    
+                    WriteCode( gauss_stream, gauss_writer, gauss_file,
+                        CodeBlock( CodeKind_T::Gauss, PDC, T_p_counter, T_m_counter, F8_counter )
+                    );
+                    
+                    if constexpr ( V2Q ) { T_gauss_write.Toc(); }
                 }
                 
-                for( auto & PD : PDC.Diagrams() )
+                if ( macleodQ )
                 {
-                    if( PD.CrossingCount() <= 0 )
-                    {
-                        continue;
-                    }
-                    if( tally_trefoilsQ && PD.ProvenTrefoilQ() )
-                    {
-                        continue;
-                    }
-                    if( tally_F8Q && PD.ProvenFigureEightQ() )
-                    {
-                        continue;
-                    }
-            
-                    auto code = PD.MacLeodCode();
-                    macleod_stream << "\ns ";
-                    macleod_stream << ToString(PD.ProvenMinimalQ());
-                    macleod_stream << " | ";
-                    macleod_stream << OutString::FromArray(
-                        code.ReadAccess(), code.Size(), "", " ", ""
+                    if constexpr ( V2Q ) { T_macleod_write.Tic(); }
+                    
+                    WriteCode( macleod_stream, macleod_writer, macleod_file,
+                        CodeBlock( CodeKind_T::MacLeod, PDC, T_p_counter, T_m_counter, F8_counter )
                     );
+                    
+                    if constexpr ( V2Q ) { T_macleod_write.Toc(); }
                 }
-                macleod_stream << "\n";
-                macleod_stream << std::flush;
-                if( !macleod_stream )
-                {
-                    throw std::runtime_error( ClassName()+"::Analyze(" + ToString(i) + "): Failed to write to file \"" + macleod_file.string() + "\".");
-                }
-                
-                if constexpr ( V2Q ) { T_macleod_write.Toc(); }
             }
-        }
-        else
-        {
-            ++unknot_counter;
-        }
-        
-        if( force_deallocQ )
-        {
-            T_pd_dealloc.Tic<V2Q>();
-            PDC = PDC_T();
-            T_pd_dealloc.Toc<V2Q>();
+            else
+            {
+                ++unknot_counter;
+            }
             
-//            T_pd_dealloc.Tic<V2Q>();
-//            PD = PD_T();
-//            pd_list = std::vector<PD_T>();
-//            T_pd_dealloc.Toc<V2Q>();
-            deallocation_time += T_pd_dealloc.Duration();
+            if( force_deallocQ )
+            {
+                T_pd_dealloc.Tic<V2Q>();
+                PDC = PDC_T();
+                T_pd_dealloc.Toc<V2Q>();
+                deallocation_time += T_pd_dealloc.Duration();
+            }
         }
     }
     
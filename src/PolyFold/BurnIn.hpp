@@ -22,15 +22,27 @@ void BurnIn()
     LInt attempt_count;
     LInt accept_count;
     Int active_node_count;
-    FoldFlagCounts_T counts;
+    FoldFlagCounts_T counts ( LInt(0) );
     
     TimeInterval T_burn_in (0);
     
     typename Clisby_T::CallCounters_T call_counters;
     
     {
+        LInt done = 0;
+        
         T_clisby.Tic<V2Q>();
-        Clisby_T T = CreateClisbyTree(true);
+        Clisby_T T;
+        if( resumeQ )
+        {
+            done   = resume_state.burn_in_done;
+            counts = resume_state.burn_in_counts;
+            T      = TakeResumeTree();
+        }
+        else
+        {
+            T = CreateClisbyTree(true);
+        }
         T_clisby.Toc<V2Q>();
     
 //        pre_state = FullState( T.RandomEngine() );
@@ -41,18 +53,38 @@ void BurnIn()
         if( hierarchicalQ )
         {
             // Experimental; not guaranteed to sample correctly.
-            counts = T.HierarchicalMove(
-                burn_in, reflection_probability, checksQ, check_jointsQ
+            counts += T.HierarchicalMove(
+                burn_in - done, reflection_probability, checksQ, check_jointsQ
             );
         }
         else
         {
-            counts = T.FoldRandom(
-                burn_in, reflection_probability, checksQ, check_jointsQ
-            );
+            // The state of the random walk between two calls of FoldRandom is the tree together with its random engine and distributions (some of which cache values between draws, e.g., the wrapped Gaussians). The checkpoint stores all of it; so we can split the burn-in into chunks to take checkpoints without changing the trajectory.
+            const LInt chunk = CheckpointsQ() ? Max( LInt(1), LInt(n) ) : burn_in;
+            
+            while( done < burn_in )
+            {
+                const LInt attempts = Min( chunk, burn_in - done );
+                
+                counts += T.FoldRandom(
+                    attempts, reflection_probability, checksQ, check_jointsQ
+                );
+                
+                done += attempts;
+                
+                if( (done < burn_in) && CheckpointDueQ() )
+                {
+                    WriteCheckpoint( T, done, LInt(0), counts );
+                }
+            }
         }
         T_fold.Toc<V2Q>();
         
+        if constexpr ( Clisby_T::telemetryQ )
+        {
+            burn_in_telemetry += T.Telemetry();
+        }
+        
         attempt_count = counts.Total();
         accept_count = counts[0];
         
@@ -146,8 +178,12 @@ void BurnIn()
     log << "\n" + ct_tabs<t0> + "|>";
 
     
-    print("Burn-in done.");
-    valprint<a>("Burn-In Seconds Elapsed", burn_in_time);
-    print("");
+    // Chains run concurrently; RunChains reports for them once they have joined.
+    if( !ChainQ() )
+    {
+        print("Burn-in done.");
+        valprint<a>("Burn-In Seconds Elapsed", burn_in_time);
+        print("");
+    }
     
 } // BurnIn
@@ -0,0 +1,336 @@
+public:
+
+bool ChainQ() const
+{
+    return chain >= Int(0);
+}
+
+Int ChainCount() const
+{
+    return chain_count;
+}
+
+private:
+
+struct ChainReport_T
+{
+    LInt   total_attempt_count   = 0;
+    LInt   total_accept_count    = 0;
+    LInt   burn_in_attempt_count = 0;
+    LInt   burn_in_accept_count  = 0;
+    double burn_in_time          = 0;
+    double total_sampling_time   = 0;
+    double total_analysis_time   = 0;
+    double total_snapshot_time   = 0;
+    double allocation_time       = 0;
+    double deallocation_time     = 0;
+    std::pair<Real,Real> e_dev   { Real(0), Real(0) };
+    IntersectionFlagCounts_T acc_intersec_counts = IntersectionFlagCounts_T( Size_T(0) );
+    Telemetry_T burn_in_telemetry;
+    Telemetry_T sample_telemetry;
+};
+
+static std::string ChainPrefix( const Int k )
+{
+    return "Chain_" + StringWithLeadingZeroes(k,3) + "_";
+}
+
+/*!@brief Creates chain number `chain_` of a multi-chain run. The chain copies the configuration and the initial polygon of `master`, but it writes to its own files. Its random engine is the one of `master`, advanced by `chain_ * 2^96` steps. So chain 0 reproduces the trajectory of a single-chain run, and the streams of different chains cannot overlap unless a chain draws more than 2^96 random numbers.
+ */
+
+PolyFold( cref<PolyFold> master, const Int chain_ )
+{
+    hard_sphere_diam         = master.hard_sphere_diam;
+    hard_sphere_squared_diam = master.hard_sphere_squared_diam;
+    prescribed_edge_length   = master.prescribed_edge_length;
+
+    n           = master.n;
+    N           = master.N;
+    burn_in     = master.burn_in;
+    skip        = master.skip;
+    verbosity   = master.verbosity;
+
+    collision_thread_count       = master.collision_thread_count;
+    parallel_collision_threshold = master.parallel_collision_threshold;
+    speculation_batch_size       = master.speculation_batch_size;
+
+    chain_count  = master.chain_count;
+    chain        = chain_;
+    chain_prefix = ChainPrefix(chain_);
+
+    path        = master.path;
+    input_file  = master.input_file;
+
+    x = master.x;
+
+    curvature_hist = Tensor1<LInt,Int> ( master.bin_count, 0 );
+    torsion_hist   = Tensor1<LInt,Int> ( Int(2) * master.bin_count, 0 );
+
+    edge_length_tolerance  = master.edge_length_tolerance;
+    reflection_probability = master.reflection_probability;
+    steps_between_print    = master.steps_between_print;
+    bin_count              = master.bin_count;
+
+    prng = master.prng;
+    prng.advance( static_cast<typename PRNG_T::state_type>(chain_) << 96 );
+    prng_init = State( prng );
+
+    force_deallocQ    = master.force_deallocQ;
+    checksQ           = master.checksQ;
+    check_jointsQ     = master.check_jointsQ;
+    hierarchicalQ     = master.hierarchicalQ;
+    path_updatesQ     = master.path_updatesQ;
+    anglesQ           = master.anglesQ;
+    squared_gyradiusQ = master.squared_gyradiusQ;
+    pdQ               = master.pdQ;
+    gaussQ            = master.gaussQ;
+    macleodQ          = master.macleodQ;
+    printQ            = master.printQ;
+    inputQ            = master.inputQ;
+    bounding_boxesQ   = master.bounding_boxesQ;
+    shiftQ            = master.shiftQ;
+    recenterQ         = master.recenterQ;
+    tally_unknotsQ    = master.tally_unknotsQ;
+    tally_trefoilsQ   = master.tally_trefoilsQ;
+    tally_F8Q         = master.tally_F8Q;
+
+    angle_method = master.angle_method;
+    angle_sigma  = master.angle_sigma;
+    pivot_method = master.pivot_method;
+    pivot_sigma  = master.pivot_sigma;
+    pivot_beta   = master.pivot_beta;
+
+    acc_intersec_counts.SetZero();
+
+    OpenChainFiles<0>();
+}
+
+template<Size_T t0>
+void OpenChainFiles()
+{
+    constexpr Size_T t1 = t0 + 1;
+    constexpr Size_T t2 = t0 + 2;
+
+    auto open = [this]( mref<std::ofstream> stream, mref<std::filesystem::path> file, const std::string & name )
+    {
+        file = path / (chain_prefix + name);
+
+        stream.open( file, std::ios_base::out );
+
+        if( !stream )
+        {
+            throw std::runtime_error(
+                ClassName()+"::OpenChainFiles: Failed to create file \"" + file.string() + "\"."
+            );
+        }
+    };
+
+    open( log, log_file, "Info.m" );
+
+    if( pdQ )
+    {
+        open( pd_stream, pd_file, "PDCodes.tsv" );
+    }
+
+    if( gaussQ )
+    {
+        open( gauss_stream, gauss_file, "GaussCodes.txt" );
+    }
+
+    if( macleodQ )
+    {
+        open( macleod_stream, macleod_file, "MacLeod.txt" );
+    }
+
+    if constexpr ( Clisby_T::witnessesQ )
+    {
+        open( witness_stream, witness_file, "Witnesses.tsv" );
+        open( pivot_stream, pivot_file, "AcceptedPivotMoves.tsv" );
+    }
+
+    log << ct_tabs<t0> + "<|";
+    kv<t1,0>("Chain", chain);
+    log << ",\n" + ct_tabs<t1> + "\"PCG64\" -> <|";
+        kv<t2,0>("Multiplier", prng_init.multiplier);
+        kv<t2>("Increment"   , prng_init.increment );
+        kv<t2>("State"       , prng_init.state     );
+    log << "\n" + ct_tabs<t1> + "|>";
+    log << std::flush;
+}
+
+ChainReport_T Report() const
+{
+    return ChainReport_T{
+        .total_attempt_count   = total_attempt_count,
+        .total_accept_count    = total_accept_count,
+        .burn_in_attempt_count = burn_in_attempt_count,
+        .burn_in_accept_count  = burn_in_accept_count,
+        .burn_in_time          = burn_in_time,
+        .total_sampling_time   = total_sampling_time,
+        .total_analysis_time   = total_analysis_time,
+        .total_snapshot_time   = total_snapshot_time,
+        .allocation_time       = allocation_time,
+        .deallocation_time     = deallocation_time,
+        .e_dev                 = e_dev,
+        .acc_intersec_counts   = acc_intersec_counts,
+        .burn_in_telemetry     = burn_in_telemetry,
+        .sample_telemetry      = sample_telemetry
+    };
+}
+
+// Appends the file `name` of chain `k` to `stream` and deletes it afterwards.
+void AppendChainFile( mref<std::ofstream> stream, const std::string & name, const Int k )
+{
+    const std::filesystem::path file = path / (ChainPrefix(k) + name);
+
+    {
+        std::ifstream s ( file );
+
+        // Streaming an empty buffer would set the failbit of `stream`.
+        if( s && (s.peek() != std::ifstream::traits_type::eof()) )
+        {
+            stream << s.rdbuf();
+        }
+    }
+
+    stream << std::flush;
+
+    if( !stream )
+    {
+        throw std::runtime_error(
+            ClassName()+"::AppendChainFile: Failed to append file \"" + file.string() + "\"."
+        );
+    }
+
+    std::filesystem::remove(file);
+}
+
+/*!@brief Runs `chain_count` independent chains, one per thread, and merges their outputs in chain order: The logs of the chains are collected in the list "Chains" of "Info.m", and the PD, Gauss, and MacLeod codes are concatenated into the usual files. The final report aggregates all chains.
+ */
+
+template<Size_T t0>
+void RunChains()
+{
+    constexpr Size_T t1 = t0 + 1;
+
+    const Size_T K = ToSize_T(chain_count);
+
+    std::vector<ChainReport_T>      reports ( K );
+    std::vector<std::exception_ptr> errors  ( K );
+
+    print("Running " + ToString(chain_count) + " chains in parallel.");
+    print("");
+
+    T_run.Tic();
+
+    ParallelDo(
+        [&reports,&errors,this]( const Size_T thread )
+        {
+            try
+            {
+                PolyFold C ( *this, static_cast<Int>(thread) );
+
+                C.Run();
+
+                reports[thread] = C.Report();
+            }
+            catch( ... )
+            {
+                errors[thread] = std::current_exception();
+            }
+        },
+        K
+    );
+
+    T_run.Toc();
+
+    total_timing = T_run.Duration();
+
+    // Aggregate the chains' statistics. Times are summed, so they are CPU times.
+
+    total_attempt_count   = 0;
+    total_accept_count    = 0;
+    burn_in_attempt_count = 0;
+    burn_in_accept_count  = 0;
+    burn_in_time          = 0;
+    total_sampling_time   = 0;
+    total_analysis_time   = 0;
+    total_snapshot_time   = 0;
+    allocation_time       = 0;
+    deallocation_time     = 0;
+    acc_intersec_counts.SetZero();
+    burn_in_telemetry     = Telemetry_T();
+    sample_telemetry      = Telemetry_T();
+
+    e_dev = reports[0].e_dev;
+
+    for( const ChainReport_T & r : reports )
+    {
+        total_attempt_count   += r.total_attempt_count;
+        total_accept_count    += r.total_accept_count;
+        burn_in_attempt_count += r.burn_in_attempt_count;
+        burn_in_accept_count  += r.burn_in_accept_count;
+        burn_in_time          += r.burn_in_time;
+        total_sampling_time   += r.total_sampling_time;
+        total_analysis_time   += r.total_analysis_time;
+        total_snapshot_time   += r.total_snapshot_time;
+        allocation_time       += r.allocation_time;
+        deallocation_time     += r.deallocation_time;
+        acc_intersec_counts   += r.acc_intersec_counts;
+        burn_in_telemetry     += r.burn_in_telemetry;
+        sample_telemetry      += r.sample_telemetry;
+
+        e_dev.first  = Min( e_dev.first , r.e_dev.first  );
+        e_dev.second = Max( e_dev.second, r.e_dev.second );
+    }
+
+    log << ",\n" + ct_tabs<t1> + "\"Chains\" -> {";
+
+    for( Int k = 0; k < chain_count; ++k )
+    {
+        log << ((k > Int(0)) ? ",\n" : "\n");
+
+        AppendChainFile( log, "Info.m", k );
+    }
+
+    log << "\n" + ct_tabs<t1> + "}";
+
+    for( Int k = 0; k < chain_count; ++k )
+    {
+        if( pdQ )
+        {
+            AppendChainFile( pd_stream, "PDCodes.tsv", k );
+        }
+
+        if( gaussQ )
+        {
+            AppendChainFile( gauss_stream, "GaussCodes.txt", k );
+        }
+
+        if( macleodQ )
+        {
+            AppendChainFile( macleod_stream, "MacLeod.txt", k );
+        }
+
+        if constexpr ( Clisby_T::witnessesQ )
+        {
+            AppendChainFile( witness_stream, "Witnesses.tsv", k );
+            AppendChainFile( pivot_stream, "AcceptedPivotMoves.tsv", k );
+        }
+    }
+
+    FinalReport<t1>();
+
+    log << std::flush;
+
+    for( Size_T k = 0; k < K; ++k )
+    {
+        if( errors[k] )
+        {
+            eprint(ClassName()+"::RunChains: Chain " + ToString(k) + " failed.");
+
+            std::rethrow_exception( errors[k] );
+        }
+    }
+
+} // RunChains
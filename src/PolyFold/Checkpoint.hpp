@@ -0,0 +1,265 @@
+public:
+
+bool CheckpointsQ() const
+{
+    return checkpoint_interval >= double(0);
+}
+
+private:
+
+bool CheckpointDueQ()
+{
+    if( !CheckpointsQ() )
+    {
+        return false;
+    }
+
+    T_checkpoint.Toc();
+
+    return T_checkpoint.Duration() >= checkpoint_interval;
+}
+
+/*!@brief Writes `T` together with the state of the sampler to `checkpoint_file`. The tree `T` must be the tree that the next `burn_in - burn_in_done` burn-in attempts (if `sample == 0`) or sample number `sample` start from.
+ */
+
+void WriteCheckpoint(
+    cref<Clisby_T> T,
+    const LInt burn_in_done,
+    const LInt sample,
+    cref<FoldFlagCounts_T> burn_in_counts
+)
+{
+    TimeInterval T_write (0);
+
+    // The counters below must include all samples before `sample`.
+    DrainAnalysisPipeline();
+
+    CheckpointState_T s;
+
+    s.n                     = n;
+    s.N                     = N;
+    s.burn_in               = burn_in;
+    s.skip                  = skip;
+    s.burn_in_done          = burn_in_done;
+    s.sample                = sample;
+    s.total_attempt_count   = total_attempt_count;
+    s.total_accept_count    = total_accept_count;
+    s.burn_in_attempt_count = burn_in_attempt_count;
+    s.burn_in_accept_count  = burn_in_accept_count;
+    s.unknot_counter        = unknot_counter;
+    s.T_p_counter           = T_p_counter;
+    s.T_m_counter           = T_m_counter;
+    s.F8_counter            = F8_counter;
+    // Sample(i) has already incremented print_ctr.
+    s.print_ctr             = (sample > LInt(0)) ? print_ctr - printQ : print_ctr;
+    s.burn_in_counts        = burn_in_counts;
+    s.acc_intersec_counts   = acc_intersec_counts;
+    s.pd_byte_count         = CodeByteCount( pd_stream,      pd_writer,      pdQ      );
+    s.gauss_byte_count      = CodeByteCount( gauss_stream,   gauss_writer,   gaussQ   );
+    s.macleod_byte_count    = CodeByteCount( macleod_stream, macleod_writer, macleodQ );
+    s.analysis_byte_count   = StreamByteCount( analysis_log   );
+    s.witness_byte_count    = StreamByteCount( witness_stream );
+    s.pivot_byte_count      = StreamByteCount( pivot_stream   );
+
+    T.WriteCheckpoint(
+        checkpoint_file, reinterpret_cast<cptr<std::byte>>(&s), sizeof(CheckpointState_T)
+    );
+
+    ++checkpoint_count;
+
+    T_write.Toc();
+
+    total_checkpoint_time += T_write.Duration();
+
+    T_checkpoint.Tic();
+}
+
+/*!@brief Reads the tree and the state of the sampler from `resume_file` and checks them against the current options. The tree is kept in `resume_tree` until `BurnIn` or `Sample` takes it via `TakeResumeTree`. This runs before `Initialize` opens the output files, because these have to be cut back to the byte counts in `resume_state`.
+ */
+
+void ReadResumeCheckpoint()
+{
+    TimeInterval T_load (0);
+
+    std::vector<std::byte> user_data;
+
+    resume_tree = Clisby_T::ReadCheckpoint( resume_file, user_data );
+
+    if( user_data.size() != sizeof(CheckpointState_T) )
+    {
+        throw std::runtime_error(
+            ClassName()+"::ReadResumeCheckpoint: File \"" + resume_file.string() + "\" was not written by " + ClassName() + "."
+        );
+    }
+
+    std::memcpy( &resume_state, user_data.data(), sizeof(CheckpointState_T) );
+
+    const CheckpointState_T & s = resume_state;
+
+    if( s.version != CheckpointState_T().version )
+    {
+        throw std::runtime_error(
+            ClassName()+"::ReadResumeCheckpoint: File \"" + resume_file.string() + "\" has unsupported version " + ToString(s.version) + "."
+        );
+    }
+
+    if(
+        (s.n != LInt(n)) || (s.N != N) || (s.burn_in != burn_in) || (s.skip != skip)
+        ||
+        (resume_tree.HardSphereDiameter() != hard_sphere_diam)
+    )
+    {
+        throw std::runtime_error(
+            ClassName()+"::ReadResumeCheckpoint: Edge count, sample count, burn-in count, skip count, or hard sphere diameter do not match the ones stored in \"" + resume_file.string() + "\"."
+        );
+    }
+
+    if( (s.sample < LInt(0)) || (s.sample > N) || ((s.sample == LInt(0)) && (s.burn_in_done > burn_in)) )
+    {
+        throw std::runtime_error(
+            ClassName()+"::ReadResumeCheckpoint: File \"" + resume_file.string() + "\" is corrupted."
+        );
+    }
+
+    T_load.Toc();
+
+    resume_load_time = T_load.Duration();
+}
+
+/*!@brief Restores the counters of the sampler from `resume_state` and reports the checkpoint in the log. Requires `ReadResumeCheckpoint`.
+ */
+
+template<Size_T t0>
+void LoadCheckpoint()
+{
+    constexpr Size_T t1 = t0 + 1;
+
+    const CheckpointState_T & s = resume_state;
+
+    total_attempt_count   = s.total_attempt_count;
+    total_accept_count    = s.total_accept_count;
+    burn_in_attempt_count = s.burn_in_attempt_count;
+    burn_in_accept_count  = s.burn_in_accept_count;
+    unknot_counter        = s.unknot_counter;
+    T_p_counter           = s.T_p_counter;
+    T_m_counter           = s.T_m_counter;
+    F8_counter            = s.F8_counter;
+    acc_intersec_counts   = s.acc_intersec_counts;
+
+    resume_tree.SetCollisionThreadCount( collision_thread_count );
+    resume_tree.SetParallelCollisionThreshold( parallel_collision_threshold );
+    resume_tree.SetSpeculationBatchSize( speculation_batch_size );
+
+    // The random methods replace the distributions by fresh ones; but the checkpoint may have been taken in the middle of the burn-in, where some distributions carry cached values.
+    const auto random_state = resume_tree.SaveRandomState();
+
+    ConfigureClisbyTree( resume_tree );
+
+    resume_tree.RestoreRandomState( random_state );
+
+    prng = resume_tree.RandomEngine();
+
+    log << ",\n" + ct_tabs<t0> + "\"Resumed\" -> <|";
+        kv<t1,0>("Checkpoint", resume_file.string() );
+        kv<t1>("Burn-in Attempts Done", (s.sample > LInt(0)) ? burn_in : s.burn_in_done );
+        kv<t1>("Sample", s.sample );
+        kv<t1>("PD Codes Byte Count", s.pd_byte_count );
+        kv<t1>("Gauss Codes Byte Count", s.gauss_byte_count );
+        kv<t1>("MacLeod Codes Byte Count", s.macleod_byte_count );
+        kv<t1>("Analyses Byte Count", s.analysis_byte_count );
+        kv<t1>("Load Seconds Elapsed", resume_load_time );
+    log << "\n" + ct_tabs<t0> + "|>" << std::flush;
+
+    print("Resumed from checkpoint \"" + resume_file.string() + "\".");
+    print("");
+}
+
+Clisby_T TakeResumeTree()
+{
+    resumeQ = false;
+
+    return std::move(resume_tree);
+}
+
+/*!@brief Opens `stream` for writing to `file`. When resuming, the file of the interrupted run is cut back to the `byte_count` bytes that it had when the checkpoint was written, and it is continued from there. Otherwise, the file is created anew.
+ */
+
+void OpenOutputFile(
+    mref<std::ofstream> stream, cref<std::filesystem::path> file, const std::uint64_t byte_count
+)
+{
+    if( resumeQ )
+    {
+        CutOutputFile( file, byte_count );
+        
+        // Unlike std::ios_base::app, this keeps `tellp` counting from the beginning of the file, as `StreamByteCount` requires.
+        stream.open( file, std::ios_base::in | std::ios_base::out );
+        stream.seekp( 0, std::ios_base::end );
+    }
+    else
+    {
+        stream.open( file, std::ios_base::out );
+    }
+    
+    if( !stream )
+    {
+        throw std::runtime_error(
+            ClassName()+"::OpenOutputFile: Failed to open file \"" + file.string() + "\"."
+        );
+    }
+}
+
+/*!@brief Cuts `file` back to `byte_count` bytes. Everything behind was written by the interrupted run after its last checkpoint and will be written again. Throws if the file is shorter, because then it is not the file that the checkpoint refers to.
+ */
+
+void CutOutputFile( cref<std::filesystem::path> file, const std::uint64_t byte_count )
+{
+    std::error_code ec;
+    
+    const std::uintmax_t size = std::filesystem::file_size( file, ec );
+    
+    if( ec )
+    {
+        if( byte_count == std::uint64_t(0) )
+        {
+            // Nothing to keep; just create the file.
+            std::ofstream create ( file );
+            return;
+        }
+        
+        throw std::runtime_error(
+            ClassName()+"::CutOutputFile: File \"" + file.string() + "\" of the interrupted run is missing."
+        );
+    }
+    
+    if( size < byte_count )
+    {
+        throw std::runtime_error(
+            ClassName()+"::CutOutputFile: File \"" + file.string() + "\" has " + ToString(size) + " bytes, but the checkpoint \"" + resume_file.string() + "\" refers to " + ToString(byte_count) + " bytes."
+        );
+    }
+    
+    std::filesystem::resize_file( file, byte_count );
+}
+
+/*!@brief The log of the interrupted run does not fit into the log of the resumed run, so we move it out of the way: "Info.m" becomes "Info_Interrupted_1.m" (or the next free number).
+ */
+
+void KeepInterruptedLog()
+{
+    if( !std::filesystem::exists( log_file ) )
+    {
+        return;
+    }
+    
+    for( Size_T k = 1; ; ++k )
+    {
+        const std::filesystem::path file = path / ("Info_Interrupted_" + ToString(k) + ".m");
+        
+        if( !std::filesystem::exists( file ) )
+        {
+            std::filesystem::rename( log_file, file );
+            return;
+        }
+    }
+}
@@ -0,0 +1,136 @@
+private:
+
+// When resuming, `file` is cut back to `byte_count` bytes and continued; see `OpenOutputFile`.
+std::unique_ptr<AsyncCodeWriter> CreateCodeWriter(
+    cref<std::filesystem::path> file, const std::uint64_t byte_count
+)
+{
+    if( resumeQ )
+    {
+        CutOutputFile( file, byte_count );
+    }
+    
+    return std::make_unique<AsyncCodeWriter>(
+        file,
+        AsyncCodeWriter::Settings_T{
+            .rotate_byte_count = ToSize_T(rotate_mib) << 20,
+            .compression_level = compression_level,
+            .appendQ           = resumeQ
+        }
+    );
+}
+
+/*!@brief Writes the block `s` of codes either to `stream` or, with asynchronous output, hands it over to `writer`.
+ */
+
+void WriteCode(
+    mref<std::ofstream> stream,
+    mref<std::unique_ptr<AsyncCodeWriter>> writer,
+    cref<std::filesystem::path> file,
+    std::string && s
+)
+{
+    if( writer )
+    {
+        writer->Push( std::move(s) );
+        return;
+    }
+    
+    stream << s << std::flush;
+    
+    if( !stream )
+    {
+        throw std::runtime_error(
+            ClassName()+"::WriteCode: Failed to write to file \"" + file.string() + "\"."
+        );
+    }
+}
+
+// Returns the number of bytes written to a code file so far; pending writes are completed first.
+static std::uint64_t CodeByteCount(
+    mref<std::ofstream> stream,
+    mref<std::unique_ptr<AsyncCodeWriter>> writer,
+    const bool activeQ
+)
+{
+    if( !activeQ )
+    {
+        return 0;
+    }
+    
+    if( writer )
+    {
+        writer->Flush();
+        
+        return static_cast<std::uint64_t>(writer->ByteCount());
+    }
+    
+    return StreamByteCount( stream );
+}
+
+// Returns the number of bytes in the file of `stream`, or 0 if it is not open; pending writes are completed first.
+static std::uint64_t StreamByteCount( mref<std::ofstream> stream )
+{
+    if( !stream.is_open() )
+    {
+        return 0;
+    }
+    
+    stream << std::flush;
+    
+    const auto pos = stream.tellp();
+    
+    return (pos < 0) ? std::uint64_t(0) : static_cast<std::uint64_t>(pos);
+}
+
+// Waits for all pending writes, so that write errors are reported before the final report.
+void CloseCodeWriters()
+{
+    for( auto * writer : { &pd_writer, &gauss_writer, &macleod_writer } )
+    {
+        if( *writer )
+        {
+            (*writer)->Close();
+        }
+    }
+}
+
+template<Size_T t0>
+void PrintCodeWriters()
+{
+    constexpr Size_T t1 = t0 + 1;
+    constexpr Size_T t2 = t0 + 2;
+    
+    if( !async_outputQ )
+    {
+        return;
+    }
+    
+    log << ",\n" + ct_tabs<t0> + "\"Asynchronous Output\" -> <|";
+    
+    bool appendQ = false;
+    
+    auto print_writer = [&appendQ,this]( const std::string & name, cref<std::unique_ptr<AsyncCodeWriter>> writer )
+    {
+        if( !writer )
+        {
+            return;
+        }
+        
+        log << (appendQ ? ",\n" : "\n") + ct_tabs<t1> + "\"" + name + "\" -> <|";
+            kv<t2,0>("Byte Count", writer->ByteCount() );
+            kv<t2>("File Count", writer->FileCount() );
+            kv<t2>("Write Seconds Elapsed", writer->WriteTime() );
+            kv<t2>("Greatest Backlog", writer->MaxBacklogCount() );
+            kv<t2>("Backlog Waits", writer->BacklogWaitCount() );
+        log << "\n" + ct_tabs<t1> + "|>";
+        
+        appendQ = true;
+    };
+    
+    print_writer( "PD Codes",      pd_writer      );
+    print_writer( "Gauss Codes",   gauss_writer   );
+    print_writer( "MacLeod Codes", macleod_writer );
+    
+    log << "\n" + ct_tabs<t0> + "|>";
+}
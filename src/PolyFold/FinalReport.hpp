@@ -21,6 +21,32 @@ void FinalReport()
         kv<t2>("Snapshots", total_snapshot_time );
     log << "\n" + ct_tabs<t1> + "|>";
     
+    if( CheckpointsQ() )
+    {
+        log << ",\n" + ct_tabs<t1> + "\"Checkpoints\" -> <|";
+            kv<t2,0>("Checkpoint Count", checkpoint_count );
+            kv<t2>("Checkpoint Seconds Elapsed", total_checkpoint_time );
+        log << "\n" + ct_tabs<t1> + "|>";
+    }
+    
+    PrintCodeWriters<t1>();
+    
+    if( analysis_thread_count > Int(0) )
+    {
+        log << ",\n" + ct_tabs<t1> + "\"Pipelined Analysis\" -> <|";
+            kv<t2,0>("Analysis Threads", analysis_thread_count );
+            kv<t2>("Worker Seconds Elapsed", total_pipelined_analysis_time );
+            kv<t2>("Sampler Stall Count", pipeline_stall_count );
+            kv<t2>("Sampler Stall Seconds", pipeline_stall_time );
+        log << "\n" + ct_tabs<t1> + "|>";
+    }
+    
+    if constexpr ( Clisby_T::telemetryQ )
+    {
+        PrintTelemetry<t1>( "Burn-in Pivot Telemetry", burn_in_telemetry );
+        PrintTelemetry<t1>( "Sampling Pivot Telemetry", sample_telemetry );
+    }
+    
     if( force_deallocQ )
     {
         log << ",\n" + ct_tabs<t1> + "\"Allocation Time Details\" -> <|";
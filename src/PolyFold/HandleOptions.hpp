@@ -46,6 +46,17 @@ bool HandleOptions( int argc, char** argv )
     ("shift,S", po::value<bool>()->default_value(true), "Shift vertex indices randomly in each sample.")
     ("recenter,Z", po::value<bool>()->default_value(true), "Translate each sample so that its barycenter is the origin.")
     ("edge-length-tol", po::value<Real>()->default_value(0.00000000001), "Set relative tolerance for the edge lengths.")
+    ("collision-threads", po::value<Int>()->default_value(1), "Use [arg] threads for the collision checks of pivot moves whose smaller part has at least as many vertices as given by --parallel-collision-threshold.")
+    ("parallel-collision-threshold", po::value<Int>()->default_value(131072), "Minimal number of moved vertices for which a collision check is run in parallel.")
+    ("path-updates", po::value<bool>()->default_value(false), "Set whether to update the Clisby tree after accepted moves by walking only along the paths from the pivots to the root instead of recursing through the tree.")
+    ("speculation-batch", po::value<Int>()->default_value(1), "Draw [arg] pivot moves at once, check them in parallel with --collision-threads threads, and apply the first accepted one. Yields a chain that is statistically equivalent to the one of the serial sampler; round-off in borderline collision checks may make them differ. Has no effect on hierarchical moves.")
+    ("checkpoint", po::value<double>(), "Write the state of the Markov chain to the file \"Checkpoint.bin\" in the output directory whenever at least [arg] seconds have passed since the last checkpoint. Checkpoints are taken every n attempts during burn-in and before each sample.")
+    ("resume", po::value<std::string>(), "Resume the Markov chain from the checkpoint file [arg]. All other options must agree with the ones of the run that wrote the checkpoint. The code, analysis, witness, and pivot files of the interrupted run are cut back to their state at the checkpoint and continued; the log of the interrupted run is kept as \"Info_Interrupted_<k>.m\". Cannot be combined with --compress-output or --rotate-output.")
+    ("analysis-threads", po::value<Int>()->default_value(0), "Analyze the knots of the samples (link, intersections, planar diagram, simplification, codes) on [arg] worker threads while the sampler continues. The results are written in sample order; their details go to \"Analyses.m\" instead of \"Info.m\". 0 means that the sampler analyzes each sample itself.")
+    ("async-output", po::value<bool>()->default_value(false), "Set whether PD/extended Gauss/MacLeod codes are written by a background thread, so that sampling never waits for the file system.")
+    ("compress-output", po::value<int>()->default_value(0), "Compress the PD/extended Gauss/MacLeod code files with zstd at level [arg]; 0 means no compression. Implies --async-output. Requires compilation with KNOODLE_USE_ZSTD.")
+    ("rotate-output", po::value<LInt>()->default_value(0), "Start a new PD/extended Gauss/MacLeod code file whenever the current one has reached [arg] MiB; 0 means never. Implies --async-output.")
+    ("chains,K", po::value<Int>()->default_value(1), "Run [arg] independent Markov chains on [arg] threads. Chain k uses the random engine of chain 0 advanced by k * 2^96 steps, so the streams never overlap. Outputs are merged in chain order into the usual files.")
     ;
     
     
@@ -192,7 +203,7 @@ bool HandleOptions( int argc, char** argv )
     edge_length_tolerance = vm["edge-length-tol"].as<Real>() * Real(n);
     valprint<a>("Edge Length Tolerance", edge_length_tolerance);
     
-    if( vm.count("gaussian-angles") && !vm.count("gaussian-angles") )
+    if( vm.count("gaussian-angles") )
     {
         Real sigma = vm["gaussian-angles"].as<Real>();
         
@@ -289,6 +300,109 @@ bool HandleOptions( int argc, char** argv )
         valprint<a>("PCG State", prng_init.state);
     }
     
+    collision_thread_count = vm["collision-threads"].as<Int>();
+    
+    if( collision_thread_count < Int(1) )
+    {
+        throw std::invalid_argument("Number of collision threads must be positive.");
+    }
+    
+    valprint<a>("Collision Threads", collision_thread_count);
+    
+    parallel_collision_threshold = Max( Int(1), vm["parallel-collision-threshold"].as<Int>() );
+    valprint<a>("Parallel Collision Threshold", parallel_collision_threshold);
+    
+    path_updatesQ = vm["path-updates"].as<bool>();
+    valprint<a>("Path Updates", BoolString(path_updatesQ) );
+    
+    speculation_batch_size = vm["speculation-batch"].as<Int>();
+    
+    if( speculation_batch_size < Int(1) )
+    {
+        throw std::invalid_argument("Speculation batch size must be positive.");
+    }
+    
+    valprint<a>("Speculation Batch Size", speculation_batch_size);
+    
+    chain_count = vm["chains"].as<Int>();
+    
+    if( chain_count < Int(1) )
+    {
+        throw std::invalid_argument("Number of chains must be positive.");
+    }
+    
+    valprint<a>("Chain Count", chain_count);
+    
+    if( vm.count("checkpoint") )
+    {
+        checkpoint_interval = vm["checkpoint"].as<double>();
+        
+        if( checkpoint_interval < double(0) )
+        {
+            throw std::invalid_argument("Checkpoint interval must be nonnegative.");
+        }
+        
+        valprint<a>("Checkpoint Interval", checkpoint_interval);
+    }
+    
+    if( vm.count("resume") )
+    {
+        resume_file = std::filesystem::path( vm["resume"].as<std::string>() );
+        resumeQ = true;
+        
+        valprint<a>("Resume File", resume_file.string());
+    }
+    
+    if( (chain_count > Int(1)) && (CheckpointsQ() || resumeQ) )
+    {
+        throw std::invalid_argument("Checkpoints are not supported in multi-chain mode.");
+    }
+    
+    compression_level = vm["compress-output"].as<int>();
+    
+#ifndef KNOODLE_USE_ZSTD
+    if( compression_level != 0 )
+    {
+        throw std::invalid_argument("Option \"--compress-output\" requires compilation with KNOODLE_USE_ZSTD.");
+    }
+#endif
+    
+    rotate_mib = vm["rotate-output"].as<LInt>();
+    
+    if( rotate_mib < LInt(0) )
+    {
+        throw std::invalid_argument("File size for rotation must be nonnegative.");
+    }
+    
+    async_outputQ = vm["async-output"].as<bool>() || (compression_level != 0) || (rotate_mib > LInt(0));
+    
+    if( (chain_count > Int(1)) && async_outputQ )
+    {
+        throw std::invalid_argument("Asynchronous output is not supported in multi-chain mode.");
+    }
+    
+    if( resumeQ && ((compression_level != 0) || (rotate_mib > LInt(0))) )
+    {
+        throw std::invalid_argument("Compressed or rotated code files cannot be continued by \"--resume\".");
+    }
+    
+    analysis_thread_count = vm["analysis-threads"].as<Int>();
+    
+    if( analysis_thread_count < Int(0) )
+    {
+        throw std::invalid_argument("Number of analysis threads must be nonnegative.");
+    }
+    
+    if( (chain_count > Int(1)) && (analysis_thread_count > Int(0)) )
+    {
+        throw std::invalid_argument("Pipelined analysis is not supported in multi-chain mode.");
+    }
+    
+    valprint<a>("Analysis Threads", analysis_thread_count );
+    valprint<a>("Asynchronous Output", BoolString(async_outputQ) );
+    valprint<a>("Compression Level", compression_level );
+    valprint<a>("Rotate Output (MiB)", rotate_mib );
+    
     print("");
     
     verbosity = vm["verbosity"].as<int>();
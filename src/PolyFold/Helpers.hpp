@@ -45,6 +45,19 @@ void PrintCallCounts( cref<typename Clisby_T::CallCounters_T> call_counters)
         kv<t+1>("Matrix-Matrix Multiplications", call_counters.mm);
         kv<t+1>("Matrix-Vector Multiplications", call_counters.mv);
         kv<t+1>("Ball Overlap Checks", call_counters.overlap);
+    
+        auto print_update = [this]( const std::string & name, cref<typename Clisby_T::UpdateCallCounters_T> c )
+        {
+            log << (",\n" + ct_tabs<t+1> + "\"" + name + "\" -> <|");
+                kv<t+2,0>("Calls", c.calls);
+                kv<t+2>("Transformation Loads", c.load_transform);
+                kv<t+2>("Matrix-Matrix Multiplications", c.mm);
+                kv<t+2>("Matrix-Vector Multiplications", c.mv);
+            log << ("\n" + ct_tabs<t+1> + "|>");
+        };
+    
+        print_update( "Subtree Updates", call_counters.update[0] );
+        print_update( "Path Updates",    call_counters.update[1] );
     log << ("\n" + ct_tabs<t> + "|>");
 }
 
@@ -60,6 +73,113 @@ void PrintClisbyFlagCounts( cref<FoldFlagCounts_T> counts )
     log << ("\n" + ct_tabs<t> + "|>");
 }
 
+/*!@brief Prints the histograms of `telemetry` as Mathematica lists. Pivot distances, ball overlap checks per collision check, and nanoseconds per accepted move are binned logarithmically; the bin with index k holds the values in the range `"... Bins"[[k]]`. Trailing empty bins are dropped.
+ */
+
+template<Size_T t, bool appendQ = true>
+void PrintTelemetry( std::string_view key, cref<Telemetry_T> telemetry )
+{
+    using F_T = Clisby_T::FoldFlag_T;
+    
+    constexpr Size_T bin_count = Clisby_T::telemetry_bin_count;
+    
+    auto list = []( const Size_T count, auto && get )
+    {
+        std::string s ( "{" );
+        
+        for( Size_T k = 0; k < count; ++k )
+        {
+            s += (k > Size_T(0) ? ", " : "") + get(k);
+        }
+        
+        return s + "}";
+    };
+    
+    auto bins = [&list]( const Size_T count )
+    {
+        return list( count, []( const Size_T k )
+        {
+            const Size_T lo = (k == Size_T(0)) ? Size_T(0) : (Size_T(1) << (k - Size_T(1)));
+            const Size_T hi = (k == Size_T(0)) ? Size_T(0) : (Size_T(1) << k) - Size_T(1);
+            
+            return "{" + ToString(lo) + ", " + ToString(hi) + "}";
+        });
+    };
+    
+    auto used = []( auto && nonzeroQ, const Size_T count )
+    {
+        Size_T used_count = count;
+        
+        while( (used_count > Size_T(0)) && !nonzeroQ(used_count - Size_T(1)) )
+        {
+            --used_count;
+        }
+        
+        return used_count;
+    };
+    
+    const auto & D = telemetry.distance_flags;
+    
+    auto attempts = [&D]( const Size_T k )
+    {
+        LInt sum = 0;
+        
+        for( LInt c : D[k] )
+        {
+            sum += c;
+        }
+        
+        return sum;
+    };
+    
+    const Size_T d_count = used( [&attempts]( const Size_T k ){ return attempts(k) > LInt(0); }, bin_count );
+    
+    auto flags = [&list,&D,d_count]( const F_T flag )
+    {
+        return list( d_count, [&D,flag]( const Size_T k ){ return ToString(D[k][ToSize_T(ToUnderlying(flag))]); } );
+    };
+    
+    auto histogram_string = [&list,&used]( const auto & h )
+    {
+        const Size_T count = used( [&h]( const Size_T k ){ return h[k] > LInt(0); }, h.size() );
+        
+        return list( count, [&h]( const Size_T k ){ return ToString(h[k]); } );
+    };
+    
+    auto histogram_bins = [&bins,&used]( const auto & h )
+    {
+        return bins( used( [&h]( const Size_T k ){ return h[k] > LInt(0); }, h.size() ) );
+    };
+    
+    log << ((appendQ ? ",\n" : "\n") + ct_tabs<t> + "\"") << key << "\" -> <|";
+        log << ("\n" + ct_tabs<t+1> + "\"Pivot Distance Bins\" -> ") << bins(d_count);
+        log << (",\n" + ct_tabs<t+1> + "\"Attempted Steps\" -> ")
+            << list( d_count, [&attempts]( const Size_T k ){ return ToString(attempts(k)); } );
+        log << (",\n" + ct_tabs<t+1> + "\"Accepted Steps\" -> ") << flags(F_T::Accepted);
+        log << (",\n" + ct_tabs<t+1> + "\"Rejected by Input Check\" -> ") << flags(F_T::RejectedByPivots);
+        log << (",\n" + ct_tabs<t+1> + "\"Rejected by First Pivot Check\" -> ") << flags(F_T::RejectedByJoint0);
+        log << (",\n" + ct_tabs<t+1> + "\"Rejected by Second Pivot Check\" -> ") << flags(F_T::RejectedByJoint1);
+        log << (",\n" + ct_tabs<t+1> + "\"Rejected by Tree\" -> ") << flags(F_T::RejectedByTree);
+        log << (",\n" + ct_tabs<t+1> + "\"Acceptance Probability\" -> ")
+            << list( d_count, [&D,&attempts]( const Size_T k )
+            {
+                return ToMathematicaString( Frac<double>(
+                    static_cast<double>(D[k][ToSize_T(ToUnderlying(F_T::Accepted))]),
+                    static_cast<double>(Max(attempts(k),LInt(1)))
+                ));
+            });
+        log << (",\n" + ct_tabs<t+1> + "\"Rejection Depths\" -> ") << histogram_string(telemetry.rejection_depths);
+        kv<t+1>("Collision Checks", telemetry.check_count);
+        kv<t+1>("Ball Overlap Checks", telemetry.overlap_count);
+        log << (",\n" + ct_tabs<t+1> + "\"Ball Overlap Checks per Collision Check Bins\" -> ") << histogram_bins(telemetry.check_overlaps);
+        log << (",\n" + ct_tabs<t+1> + "\"Ball Overlap Checks per Collision Check\" -> ") << histogram_string(telemetry.check_overlaps);
+        kv<t+1>("Accepted Steps (Timed)", telemetry.accept_count);
+        kv<t+1>("Accepted Steps Seconds Elapsed", telemetry.accept_time);
+        log << (",\n" + ct_tabs<t+1> + "\"Nanoseconds per Accepted Step Bins\" -> ") << histogram_bins(telemetry.accept_nanoseconds);
+        log << (",\n" + ct_tabs<t+1> + "\"Nanoseconds per Accepted Step\" -> ") << histogram_string(telemetry.accept_nanoseconds);
+    log << ("\n" + ct_tabs<t> + "|>");
+}
+
 template<Size_T t, bool appendQ = true>
 void PrintIntersectionFlagCounts( cref<std::string> key, cref<IntersectionFlagCounts_T> counts )
 {
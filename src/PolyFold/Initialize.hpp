@@ -14,7 +14,28 @@ Clisby_T CreateClisbyTree( bool load_data = false )
         // This initialized the polygonal line _and_ the prng.
         T = Clisby_T( n, hard_sphere_diam );
     }
+    
+    T.SetCollisionThreadCount( collision_thread_count );
+    T.SetParallelCollisionThreshold( parallel_collision_threshold );
+    T.SetSpeculationBatchSize( speculation_batch_size );
+    
+    ConfigureClisbyTree( T );
+    
+    return T;
+}
 
+// Applies all settings that are not part of the state of T.
+void ConfigureClisbyTree( mref<Clisby_T> T ) const
+{
+    if( path_updatesQ )
+    {
+        T.UsePathUpdates();
+    }
+    else
+    {
+        T.UseSubtreeUpdates();
+    }
+    
     switch( angle_method )
     {
         case AngleRandomMethod_T::Uniform:
@@ -52,8 +73,6 @@ Clisby_T CreateClisbyTree( bool load_data = false )
             break;
         }
     }
-    
-    return T;
 }
 
 template<Size_T t0>
@@ -74,6 +93,16 @@ void Initialize()
     Size_T PD_byte_count  = 0;
     
     log_file = path / "Info.m";
+    checkpoint_file = path / "Checkpoint.bin";
+    
+    if( resumeQ )
+    {
+        // We need the byte counts of the output files before we open them.
+        ReadResumeCheckpoint();
+        
+        KeepInterruptedLog();
+    }
+    
     log.open( log_file, std::ios_base::out );
     
     if( !log )
@@ -86,67 +115,76 @@ void Initialize()
     if( pdQ )
     {
         pd_file = path / "PDCodes.tsv";
-        pd_stream.open( pd_file, std::ios_base::out );
         
-        if( !pd_stream )
+        if( async_outputQ )
+        {
+            pd_writer = CreateCodeWriter( pd_file, resume_state.pd_byte_count );
+        }
+        else
         {
-            throw std::runtime_error(
-                ClassName()+"::Initialize: Failed to create file \"" + pd_file.string() + "\"."
-            );
+            OpenOutputFile( pd_stream, pd_file, resume_state.pd_byte_count );
         }
     }
     
     if( gaussQ )
     {
         gauss_file = path / "GaussCodes.txt";
-        gauss_stream.open( gauss_file, std::ios_base::out );
         
-        if( !gauss_stream )
+        if( async_outputQ )
+        {
+            gauss_writer = CreateCodeWriter( gauss_file, resume_state.gauss_byte_count );
+        }
+        else
         {
-            throw std::runtime_error(
-                ClassName()+"::Initialize: Failed to create file \"" + gauss_file.string() + "\"."
-            );
+            OpenOutputFile( gauss_stream, gauss_file, resume_state.gauss_byte_count );
         }
     }
     
     if( macleodQ )
     {
         macleod_file = path / "MacLeod.txt";
-        macleod_stream.open( macleod_file, std::ios_base::out );
         
-        if( !macleod_stream )
+        if( async_outputQ )
+        {
+            macleod_writer = CreateCodeWriter( macleod_file, resume_state.macleod_byte_count );
+        }
+        else
+        {
+            OpenOutputFile( macleod_stream, macleod_file, resume_state.macleod_byte_count );
+        }
+    }
+    
+    if( (analysis_thread_count > Int(0)) && (pdQ || gaussQ || macleodQ) )
+    {
+        analysis_file = path / "Analyses.m";
+        OpenOutputFile( analysis_log, analysis_file, resume_state.analysis_byte_count );
+        
+        // A continued file already has its opening brace and the analyses up to the checkpoint.
+        if( resume_state.analysis_byte_count == std::uint64_t(0) )
         {
-            throw std::runtime_error(
-                ClassName()+"::Initialize: Failed to create file \"" + macleod_file.string() + "\"."
-            );
+            analysis_log << "{" << std::flush;
         }
+        
+        analysis_log_appendQ = (resume_state.analysis_byte_count > std::uint64_t(1));
     }
     
     if constexpr ( Clisby_T::witnessesQ )
     {
         witness_file = path / "Witnesses.tsv";
-        witness_stream.open( witness_file, std::ios_base::out );
+        OpenOutputFile( witness_stream, witness_file, resume_state.witness_byte_count );
         
-        if( !witness_stream )
+        if( resume_state.witness_byte_count == std::uint64_t(0) )
         {
-            throw std::runtime_error(
-                ClassName()+"::Initialize: Failed to create file \"" + witness_file.string() + "\"."
-            );
+            witness_stream << "Pivot 0" << "\t" << "Pivot 1" << "\t" << "Witness 0" << "\t" << "Witness 1\n";
         }
         
-        witness_stream << "Pivot 0" << "\t" << "Pivot 1" << "\t" << "Witness 0" << "\t" << "Witness 1\n";
-        
         pivot_file = path / "AcceptedPivotMoves.tsv";
-        pivot_stream.open( pivot_file, std::ios_base::out );
+        OpenOutputFile( pivot_stream, pivot_file, resume_state.pivot_byte_count );
         
-        if( !pivot_stream )
+        if( resume_state.pivot_byte_count == std::uint64_t(0) )
         {
-            throw std::runtime_error(
-                ClassName()+"::Initialize: Failed to create file \"" + pivot_file.string() + "\"."
-            );
+            pivot_stream   << "Pivot 0" << "\t" << "Pivot 1" << "\t" << "Angle\n";
         }
-        
-        pivot_stream   << "Pivot 0" << "\t" << "Pivot 1" << "\t" << "Angle\n";
     }
     
     log << ct_tabs<t0> + "<|";
@@ -157,6 +195,19 @@ void Initialize()
     kv<t1>  ("Sample Count",N);
     kv<t1>  ("Burn-in Count",burn_in);
     kv<t1>  ("Skip Count",skip);
+    kv<t1>  ("Collision Threads",collision_thread_count);
+    kv<t1>  ("Parallel Collision Threshold",parallel_collision_threshold);
+    kv<t1>  ("Speculation Batch Size",speculation_batch_size);
+    kv<t1>  ("Chain Count",chain_count);
+    kv<t1>  ("Checkpoint Interval",checkpoint_interval);
+    kv<t1>  ("Analysis Threads",analysis_thread_count);
+    kv<t1>  ("Asynchronous Output",BoolString(async_outputQ));
+    kv<t1>  ("Compression Level",compression_level);
+    kv<t1>  ("Rotate Output (MiB)",rotate_mib);
+    if( resumeQ )
+    {
+        kv<t1>("Resume File",resume_file.string());
+    }
     kv<t1>  ("Reflection Probability",reflection_probability);
     
     switch (angle_method)
@@ -201,6 +252,7 @@ void Initialize()
     }
     
     kv<t1>  ("Hierarchical Moves",BoolString(hierarchicalQ));
+    kv<t1>  ("Path Updates",BoolString(path_updatesQ));
     kv<t1>  ("Shift Indices",BoolString(shiftQ));
     kv<t1>  ("Recenter",BoolString(recenterQ));
     kv<t1>  ("Collision Checks",BoolString(checksQ));
@@ -0,0 +1,465 @@
+public:
+
+bool PipelineQ() const
+{
+    return static_cast<bool>(pipeline);
+}
+
+private:
+
+// Result of the knot analysis of one sample on a worker thread.
+struct AnalysisResult_T
+{
+    LInt   i                       = 0;
+    int    err                     = 0;
+    Size_T link_byte_count         = 0;
+    Size_T pd_byte_count           = 0; // Before simplification.
+    Int    pd_crossing_count       = 0; // Before simplification.
+    Size_T byte_count              = 0;
+    Int    crossing_count          = 0;
+    LInt   T_p                     = 0;
+    LInt   T_m                     = 0;
+    LInt   F8                      = 0;
+    double link_time               = 0;
+    double intersection_time       = 0;
+    double pd_time                 = 0;
+    double simplify_time           = 0;
+    double code_time               = 0;
+    double total_time              = 0;
+    IntersectionFlagCounts_T intersection_flag_counts { Size_T(0) };
+    std::string pd_block;
+    std::string gauss_block;
+    std::string macleod_block;
+    std::exception_ptr error;
+};
+
+/*!@brief State of the analysis pipeline. The sampler thread copies each sample into a free buffer and queues it; the workers take samples from the queue, analyze them and return the buffers. The results are committed by the sampler thread in the order of the samples.
+ */
+
+struct AnalysisPipeline_T
+{
+    std::mutex              mutex;
+    std::condition_variable job_cv;    // Signals the workers that there is a job or that they have to stop.
+    std::condition_variable result_cv; // Signals the sampler thread that a buffer or a result is available.
+
+    std::vector<PolygonContainer_T>    buffers;
+    std::vector<Size_T>                free_buffers;
+    std::deque<std::pair<LInt,Size_T>> jobs; // Sample index and buffer.
+    std::map<LInt,AnalysisResult_T>    results;
+    std::vector<std::thread>           workers;
+
+    bool stopQ = false;
+
+    // Only accessed by the sampler thread.
+    LInt   next_commit    = 0;
+    LInt   end_commit     = 0;
+    LInt   window         = 1; // Maximal number of samples in flight.
+    LInt   stall_count    = 0;
+    double stall_time     = 0;
+
+    ~AnalysisPipeline_T()
+    {
+        {
+            const std::lock_guard<std::mutex> lock ( mutex );
+            stopQ = true;
+        }
+
+        job_cv.notify_all();
+
+        for( std::thread & worker : workers )
+        {
+            if( worker.joinable() )
+            {
+                worker.join();
+            }
+        }
+    }
+};
+
+/*!@brief Runs the same knot analysis as `Analyze` on the polygon `X`, but writes nothing. Only reads the configuration of `*this`, so it can be run concurrently.
+ */
+
+AnalysisResult_T AnalyzeKnot( cptr<Real> X, const LInt i ) const
+{
+    AnalysisResult_T r;
+
+    r.i = i;
+
+    TimeInterval T_total (0);
+    TimeInterval T_step  (0);
+
+    Link_T L ( n );
+
+    L.ReadVertexCoordinates( X );
+
+    T_step.Toc();
+    r.link_time = T_step.Duration();
+    T_step.Tic();
+
+    r.err = L.template FindIntersections<true>();
+
+    T_step.Toc();
+    r.intersection_time = T_step.Duration();
+
+    r.intersection_flag_counts = L.IntersectionFlagCounts();
+    r.link_byte_count          = L.ByteCount();
+
+    if( (r.err != 0) && (r.err != 8) )
+    {
+        // The error is reported when the result is committed.
+        return r;
+    }
+
+    if( force_deallocQ )
+    {
+        L.DeleteTree();
+    }
+
+    T_step.Tic();
+    PDC_T PDC ( L );
+    T_step.Toc();
+    r.pd_time = T_step.Duration();
+
+    if( force_deallocQ )
+    {
+        L = Link_T();
+    }
+
+    r.pd_byte_count     = PDC.Diagram(0).ByteCount();
+    r.pd_crossing_count = PDC.Diagram(0).CrossingCount();
+
+    T_step.Tic();
+    PDC.Simplify();
+    T_step.Toc();
+    r.simplify_time = T_step.Duration();
+
+    for( const PD_T & PD : PDC.Diagrams() )
+    {
+        r.byte_count     += PD.ByteCount();
+        r.crossing_count += PD.CrossingCount();
+    }
+
+    CountTallies( PDC, r.T_p, r.T_m, r.F8 );
+
+    T_step.Tic();
+    if( !tally_unknotsQ || (r.crossing_count > Int(0)) )
+    {
+        if( pdQ )
+        {
+            r.pd_block = CodeBlock( CodeKind_T::PD, PDC, r.T_p, r.T_m, r.F8 );
+        }
+        if( gaussQ )
+        {
+            r.gauss_block = CodeBlock( CodeKind_T::Gauss, PDC, r.T_p, r.T_m, r.F8 );
+        }
+        if( macleodQ )
+        {
+            r.macleod_block = CodeBlock( CodeKind_T::MacLeod, PDC, r.T_p, r.T_m, r.F8 );
+        }
+    }
+    T_step.Toc();
+    r.code_time = T_step.Duration();
+
+    T_total.Toc();
+    r.total_time = T_total.Duration();
+
+    return r;
+}
+
+void AnalysisWorker()
+{
+    AnalysisPipeline_T & P = *pipeline;
+
+    while( true )
+    {
+        std::unique_lock<std::mutex> lock ( P.mutex );
+
+        P.job_cv.wait( lock, [&P]{ return P.stopQ || !P.jobs.empty(); } );
+
+        if( P.stopQ )
+        {
+            return;
+        }
+
+        const auto [i,b] = P.jobs.front();
+        P.jobs.pop_front();
+
+        lock.unlock();
+
+        AnalysisResult_T r;
+
+        try
+        {
+            r = AnalyzeKnot( P.buffers[b].data(), i );
+        }
+        catch( ... )
+        {
+            r.i     = i;
+            r.error = std::current_exception();
+        }
+
+        lock.lock();
+
+        P.free_buffers.push_back(b);
+        P.results.emplace( i, std::move(r) );
+
+        lock.unlock();
+
+        P.result_cv.notify_all();
+    }
+}
+
+void StartAnalysisPipeline()
+{
+    pipeline = std::make_unique<AnalysisPipeline_T>();
+
+    AnalysisPipeline_T & P = *pipeline;
+
+    const Size_T thread_count = ToSize_T(analysis_thread_count);
+    const Size_T buffer_count = Size_T(2) * thread_count;
+
+    P.buffers.reserve( buffer_count );
+
+    for( Size_T b = 0; b < buffer_count; ++b )
+    {
+        P.buffers.emplace_back( n, AmbDim );
+        P.free_buffers.push_back( b );
+    }
+
+    // Results wait for all earlier samples before they are committed; this bounds their number.
+    P.window = LInt(4) * static_cast<LInt>(buffer_count);
+
+    P.workers.reserve( thread_count );
+
+    for( Size_T thread = 0; thread < thread_count; ++thread )
+    {
+        P.workers.emplace_back( [this](){ this->AnalysisWorker(); } );
+    }
+}
+
+/*!@brief Queues the knot analysis of the current polygon `x` as sample `i`. Waits only if all buffers are in use or too many results are waiting for an earlier sample. Commits all results that are ready.
+ */
+
+void SubmitAnalysis( const LInt i )
+{
+    AnalysisPipeline_T & P = *pipeline;
+
+    if( P.end_commit <= P.next_commit )
+    {
+        P.next_commit = i;
+    }
+
+    Size_T b = 0;
+
+    TimeInterval T_stall (0);
+
+    bool stalledQ = false;
+
+    while( true )
+    {
+        CommitReadyAnalyses();
+
+        std::unique_lock<std::mutex> lock ( P.mutex );
+
+        auto availableQ = [&P,i]()
+        {
+            return !P.free_buffers.empty() && (i - P.next_commit < P.window);
+        };
+
+        if( !availableQ() )
+        {
+            stalledQ = true;
+
+            P.result_cv.wait( lock, [&P,&availableQ]{
+                return availableQ() || P.results.contains(P.next_commit);
+            });
+        }
+
+        if( availableQ() )
+        {
+            b = P.free_buffers.back();
+            P.free_buffers.pop_back();
+            break;
+        }
+    }
+
+    T_stall.Toc();
+
+    if( stalledQ )
+    {
+        ++P.stall_count;
+        P.stall_time += T_stall.Duration();
+    }
+
+    copy_buffer( x.data(), P.buffers[b].data(), x.Size() );
+
+    {
+        const std::lock_guard<std::mutex> lock ( P.mutex );
+
+        P.jobs.emplace_back( i, b );
+    }
+
+    P.end_commit = i + LInt(1);
+
+    P.job_cv.notify_one();
+
+    CommitReadyAnalyses();
+}
+
+// Commits the results that are ready in the order of the samples; does not wait.
+void CommitReadyAnalyses()
+{
+    AnalysisPipeline_T & P = *pipeline;
+
+    while( P.next_commit < P.end_commit )
+    {
+        AnalysisResult_T r;
+
+        {
+            const std::lock_guard<std::mutex> lock ( P.mutex );
+
+            auto iter = P.results.find( P.next_commit );
+
+            if( iter == P.results.end() )
+            {
+                return;
+            }
+
+            r = std::move(iter->second);
+
+            P.results.erase(iter);
+        }
+
+        ++P.next_commit;
+
+        CommitAnalysis( std::move(r) );
+    }
+}
+
+// Waits for all queued analyses and commits them.
+void DrainAnalysisPipeline()
+{
+    if( !PipelineQ() )
+    {
+        return;
+    }
+
+    AnalysisPipeline_T & P = *pipeline;
+
+    while( P.next_commit < P.end_commit )
+    {
+        {
+            std::unique_lock<std::mutex> lock ( P.mutex );
+
+            P.result_cv.wait( lock, [&P]{ return P.results.contains(P.next_commit); } );
+        }
+
+        CommitReadyAnalyses();
+    }
+}
+
+void FinishAnalysisPipeline()
+{
+    if( !PipelineQ() )
+    {
+        return;
+    }
+
+    DrainAnalysisPipeline();
+
+    pipeline_stall_count = pipeline->stall_count;
+    pipeline_stall_time  = pipeline->stall_time;
+
+    // Stops and joins the workers.
+    pipeline.reset();
+
+    analysis_log << "\n}" << std::flush;
+}
+
+/*!@brief Does everything that `Analyze` does with the results of the knot analysis, except that the log entries go to "Analyses.m" instead of "Info.m".
+ */
+
+void CommitAnalysis( AnalysisResult_T && r )
+{
+    if( r.error )
+    {
+        std::rethrow_exception( r.error );
+    }
+
+    acc_intersec_counts += r.intersection_flag_counts;
+
+    total_pipelined_analysis_time += r.total_time;
+
+    auto entry = []( std::string_view key, const std::string & value, const bool appendQ = true )
+    {
+        return (appendQ ? ",\n" : "\n") + ct_tabs<2> + "\"" + std::string(key) + "\" -> " + value;
+    };
+
+    std::string s = (analysis_log_appendQ ? ",\n" : "\n") + ct_tabs<1> + "<|";
+
+    analysis_log_appendQ = true;
+
+    s += entry( "Sample", ToString(r.i), false );
+    s += entry( "Link Byte Count", ToString(r.link_byte_count) );
+
+    if( (r.err != 0) && (r.err != 8) )
+    {
+        s += entry( "FindIntersections Error Flag", ToString(r.err) );
+        s += "\n" + ct_tabs<1> + "|>";
+
+        analysis_log << s << std::flush;
+
+        throw std::runtime_error(ClassName()+"::Analyze(" + ToString(r.i) + "): Error in creating the planar diagram.");
+    }
+
+    s += entry( "Byte Count (Before Simplification)", ToString(r.pd_byte_count) );
+    s += entry( "Crossing Count (Before Simplification)", ToString(r.pd_crossing_count) );
+    s += entry( "Byte Count (After Simplification)", ToString(r.byte_count) );
+    s += entry( "Crossing Count (After Simplification)", ToString(r.crossing_count) );
+    s += entry( "Create Link", ToMathematicaString(r.link_time) );
+    s += entry( "Compute Intersections", ToMathematicaString(r.intersection_time) );
+    s += entry( "Create PlanarDiagram", ToMathematicaString(r.pd_time) );
+    s += entry( "Simplify PlanarDiagram", ToMathematicaString(r.simplify_time) );
+    s += entry( "Create Codes", ToMathematicaString(r.code_time) );
+    s += entry( "Analysis Seconds Elapsed", ToMathematicaString(r.total_time) );
+    s += "\n" + ct_tabs<1> + "|>";
+
+    analysis_log << s;
+
+    if( !analysis_log )
+    {
+        throw std::runtime_error(
+            ClassName()+"::CommitAnalysis: Failed to write to file \"" + analysis_file.string() + "\"."
+        );
+    }
+
+    T_p_counter = r.T_p;
+    T_m_counter = r.T_m;
+    F8_counter  = r.F8;
+
+    if( !tally_unknotsQ || (r.crossing_count > Int(0)) )
+    {
+        if( tally_unknotsQ && (unknot_counter > LInt(0)) )
+        {
+            WriteUnknots();
+            unknot_counter = 0;
+        }
+
+        if( pdQ )
+        {
+            WriteCode( pd_stream, pd_writer, pd_file, std::move(r.pd_block) );
+        }
+        if( gaussQ )
+        {
+            WriteCode( gauss_stream, gauss_writer, gauss_file, std::move(r.gauss_block) );
+        }
+        if( macleodQ )
+        {
+            WriteCode( macleod_stream, macleod_writer, macleod_file, std::move(r.macleod_block) );
+        }
+    }
+    else
+    {
+        ++unknot_counter;
+    }
+}
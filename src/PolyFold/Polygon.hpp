@@ -15,7 +15,7 @@ void PolygonSnapshot( const LInt i )
     
     constexpr Size_T t1 = t0 + 1;
     
-    std::string file_name = "Polygon_" + StringWithLeadingZeroes(i,9) + ".tsv";
+    std::string file_name = chain_prefix + "Polygon_" + StringWithLeadingZeroes(i,9) + ".tsv";
     
     std::ofstream s ( path / file_name );
     s << PolygonString(x);
@@ -5,6 +5,11 @@ void Run()
     total_analysis_time = 0;
     total_timing = 0;
     
+    if( (chain_count > Int(1)) && !ChainQ() )
+    {
+        return RunChains<0>();
+    }
+    
     switch( verbosity )
     {
         case 1:  return Run_impl<0,1>();
@@ -24,10 +29,24 @@ void Run_impl()
     {
         T_run.Tic();
         
-        BurnIn<tab_count+1,my_verbosity>();
+        if( resumeQ )
+        {
+            LoadCheckpoint<tab_count+1>();
+        }
+        
+        T_checkpoint.Tic();
+        
+        // A checkpoint taken during the sampling phase already contains the burnt-in tree.
+        if( !resumeQ || (resume_state.sample == LInt(0)) )
+        {
+            BurnIn<tab_count+1,my_verbosity>();
+        }
+        
         
         Sample<tab_count+1,my_verbosity>();
         
+        CloseCodeWriters();
+        
         T_run.Toc();
         
         total_timing = T_run.Duration();
@@ -37,7 +56,7 @@ void Run_impl()
     }
     catch( const std::exception & e )
     {
-        std::ofstream file ( path / "Aborted_Polygon.txt" );
+        std::ofstream file ( path / (chain_prefix + "Aborted_Polygon.txt") );
         file << PolygonString(x);
         throw;
     }
@@ -9,24 +9,44 @@ void Sample()
         
         log << "\n" + ct_tabs<t0+1>;
         
-        print_ctr = printQ ? LInt(0) : steps_between_print - LInt(1);
+        LInt i_begin = 1;
         
-        Sample<t0+1,my_verbosity>(LInt(1));
+        if( resumeQ )
+        {
+            i_begin   = resume_state.sample;
+            print_ctr = resume_state.print_ctr;
+        }
+        else
+        {
+            print_ctr = printQ ? LInt(0) : steps_between_print - LInt(1);
+        }
         
-        for( LInt i = 2; i < N; ++ i )
+        if( analysis_log.is_open() )
         {
-            log << ",\n" + ct_tabs<t0+1>;
-            
-            Sample<t0+1,my_verbosity>(i);
+            StartAnalysisPipeline();
         }
         
+        if( (i_begin < N) || (i_begin == LInt(1)) )
         {
-            log << ",\n" + ct_tabs<t0+1>;
+            Sample<t0+1,my_verbosity>(i_begin);
+            
+            for( LInt i = i_begin + 1; i < N; ++ i )
+            {
+                log << ",\n" + ct_tabs<t0+1>;
+                
+                Sample<t0+1,my_verbosity>(i);
+            }
             
+            log << ",\n" + ct_tabs<t0+1>;
+        }
+        
+        {
             // Run the last sample step with full verbosity, because that is affordable and we very often want this info for performance tuning.
             Sample<t0+1,2>(N);
         }
         
+        FinishAnalysisPipeline();
+        
         // Make sure that the last unknots are correctly recorded.
         if( tally_unknotsQ && (unknot_counter > LInt(0)) )
         {
@@ -85,10 +105,17 @@ void Sample( const LInt i )
         
         {
             T_clisby.Tic<V2Q>();
-            Clisby_T T = CreateClisbyTree(true);
+            Clisby_T T = (resumeQ && (i == resume_state.sample))
+                       ? TakeResumeTree()
+                       : CreateClisbyTree(true);
             T_clisby.Toc<V2Q>();
             allocation_time += T_clisby.Duration();
             
+            if( CheckpointDueQ() )
+            {
+                WriteCheckpoint( T, burn_in, i, FoldFlagCounts_T( LInt(0) ) );
+            }
+            
             T_fold.Tic<V2Q>();
             
             // Do `skip` attempts of folding.
@@ -104,6 +131,11 @@ void Sample( const LInt i )
             
             T_fold.Toc<V2Q>();
             
+            if constexpr ( Clisby_T::telemetryQ )
+            {
+                sample_telemetry += T.Telemetry();
+            }
+            
             attempt_count = counts.Total();
             accept_count = counts[0];
             
@@ -0,0 +1,439 @@
+// clisby_tree_check — the optional ball layouts and update methods of
+// ClisbyTree must not change the random walk.
+//
+//  (F) float_ballsQ: a tree with float32 internal balls and a plain tree with
+//      the same seed run many pivot attempts. After each round, every float32
+//      ball must contain the exact ball of its node, and its radius may exceed
+//      the exact radius only by the rounding of the center plus one float32
+//      rounding (i.e., it must not grow with the number of lazy pushes). The
+//      accept counts and the final vertex coordinates must agree bit for bit.
+//  (S) soa_ballsQ: a tree with the structure-of-arrays ball layout and a plain
+//      tree with the same seed run many pivot attempts. The flag counts (hence
+//      the collision results) must agree after each round, and the vectorized
+//      BallsCollideQ<m,n> must agree with the pairwise test of the plain tree on
+//      random pairs of sibling nodes. The final coordinates must agree bit for bit.
+//  (R) FoldRandom_Speculative: with wrapped Gaussian angles and discrete wrapped
+//      Gaussian pivots (whose distributions carry state between draws), the
+//      speculative random walk with several batch sizes runs with the same seed
+//      as the serial one. It checks its moves with composed transformations, so
+//      round-off may decide a borderline move differently, and from then on the
+//      two walks differ. So we only require statistical equivalence: for every
+//      fold flag, the fractions of attempts of the two walks must agree within
+//      5 binomial standard errors. Whether the walks stayed identical (equal
+//      flag counts and bitwise equal coordinates) is only reported.
+//  (U) UsePathUpdates: a tree that updates along the split paths and a tree
+//      that updates by subtree recursion with the same seed run many pivot
+//      attempts. Both push the same transforms and recompute the same balls, so
+//      after each round the flag counts and the balls of all nodes (which are
+//      stored relative to the pending transforms) must agree bit for bit, and
+//      so must the final coordinates.
+//  (P) CollisionQ_Parallel: a serial tree runs many random pivot attempts, one
+//      at a time. Before each attempt, it is copied to a tree with 4 collision
+//      threads and the threshold for the parallel query lowered to 1 vertex,
+//      and the copy makes the same attempt. The parallel query composes the
+//      transformations on the fly instead of pushing them, so round-off may
+//      decide a borderline ball test differently; such moves must be rare
+//      (at most 1 in 1000). Otherwise both must get the same fold flag (hence
+//      the same collision result), and if no collision is found, both
+//      traversals test the same pairs of balls, so the overlap counters must
+//      agree, too. After a collision, the parallel query may test more pairs
+//      before all threads stop, and the witness is whichever colliding pair
+//      some thread found first; so neither the counts nor the witnesses are
+//      compared then.
+//
+// Exit 0 = pass.
+//
+// Usage: ./clisby_tree_check [vertex_count] [rounds] [attempts_per_round]
+#include "../Knoodle.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+using namespace Knoodle;
+
+using Real = Real64;
+using Int  = Int64;
+using LInt = Int64;
+
+using Plain_T = ClisbyTree<3,Real,Int,LInt>;
+using Float_T = ClisbyTree<3,Real,Int,LInt,ClisbyTree_TArgs{ .float_ballsQ = true }>;
+using SoA_T   = ClisbyTree<3,Real,Int,LInt,ClisbyTree_TArgs{ .soa_ballsQ = true }>;
+using Count_T = ClisbyTree<3,Real,Int,LInt,ClisbyTree_TArgs{ .countersQ = true }>;
+
+static constexpr Real diam     = 0.75;
+static constexpr Real reflectP = 0.5;
+
+template<typename C_0, typename C_1>
+static bool SameCountsQ( const C_0 & c_0, const C_1 & c_1 )
+{
+    for( std::size_t f = 0; f < Plain_T::fold_flag_count; ++f )
+    {
+        if( c_0[f] != c_1[f] ) { return false; }
+    }
+
+    return true;
+}
+
+template<typename T_0, typename T_1>
+static bool SameCoordinatesQ( T_0 & T, T_1 & S )
+{
+    const auto X = T.VertexCoordinates();
+    const auto Y = S.VertexCoordinates();
+
+    for( Int i = 0; i < X.Size(); ++i )
+    {
+        if( X.data()[i] != Y.data()[i] ) { return false; }
+    }
+
+    return true;
+}
+
+// (F)
+static std::size_t CheckFloatBalls( const Int n, const Int rounds, const LInt attempts )
+{
+    Plain_T T ( n, diam );
+    Float_T S ( n, diam );
+
+    T.SetRandomEngine( Plain_T::PRNG_T( 42 ) );
+    S.SetRandomEngine( Float_T::PRNG_T( 42 ) );
+
+    constexpr Real eps_f = static_cast<Real>(std::numeric_limits<float>::epsilon());
+    constexpr Real tiny  = static_cast<Real>(std::numeric_limits<float>::denorm_min());
+
+    std::size_t failures = 0;
+    Real max_excess = 0; // Largest (float32 radius - exact radius) / exact radius.
+
+    for( Int round = 0; round < rounds; ++round )
+    {
+        const auto c_T = T.FoldRandom( attempts, reflectP );
+        const auto c_S = S.FoldRandom( attempts, reflectP );
+
+        if( !SameCountsQ( c_T, c_S ) )
+        {
+            ++failures;
+            std::cout << "FAIL (F): round " << round << ": flag counts differ\n";
+        }
+
+        std::size_t bad = 0;
+
+        for( Int node = 0; node < S.InternalNodeCount(); ++node )
+        {
+            Real B [4];
+            Real F [4];
+
+            S.WriteNodeBall( node, &B[0] );
+            S.WriteBroadPhaseBall( node, &F[0] );
+
+            Real e2 = 0;
+            for( Int k = 0; k < 3; ++k ) { e2 += (B[k] - F[k]) * (B[k] - F[k]); }
+
+            const Real r = B[3] + std::sqrt(e2);
+
+            // Containment, and at most one float32 rounding beyond it.
+            if( (F[3] < r) || (F[3] > r + eps_f * r + tiny) ) { ++bad; }
+
+            if( B[3] > Real(0) ) { max_excess = std::max( max_excess, (F[3] - B[3]) / B[3] ); }
+        }
+
+        if( bad > 0 )
+        {
+            ++failures;
+            std::cout << "FAIL (F): round " << round << ": " << bad << " float32 balls out of bounds\n";
+        }
+    }
+
+    if( !SameCoordinatesQ( T, S ) )
+    {
+        ++failures;
+        std::cout << "FAIL (F): vertex coordinates differ\n";
+    }
+
+    std::cout << "(F) float_ballsQ: " << rounds << " x " << attempts << " attempts, max relative radius excess "
+              << max_excess << "\n";
+
+    return failures;
+}
+
+// Compares S.BallsCollideQ<m,n>( i, j, C ) with the pairwise tests of T.
+template<Size_T m, Size_T n>
+static std::size_t CountSiblingMismatches( SoA_T & S, Plain_T & T, const Int i, const Int j )
+{
+    bool C [m * n];
+
+    S.template BallsCollideQ<m,n>( i, j, &C[0] );
+
+    std::size_t bad = 0;
+
+    for( Size_T k = 0; k < m; ++k )
+    {
+        for( Size_T l = 0; l < n; ++l )
+        {
+            bad += ( C[n * k + l] != T.BallsCollideQ( i + Int(k), j + Int(l) ) );
+        }
+    }
+
+    return bad;
+}
+
+// (S)
+static std::size_t CheckSoABalls( const Int n, const Int rounds, const LInt attempts )
+{
+    Plain_T T ( n, diam );
+    SoA_T   S ( n, diam );
+
+    T.SetRandomEngine( Plain_T::PRNG_T( 43 ) );
+    S.SetRandomEngine( SoA_T::PRNG_T( 43 ) );
+
+    std::mt19937_64 pick ( 44 );
+    std::uniform_int_distribution<Int> internal_node ( 0, S.InternalNodeCount() - 1 );
+
+    std::size_t failures   = 0;
+    std::size_t hit_count  = 0;
+    std::size_t test_count = 0;
+
+    for( Int round = 0; round < rounds; ++round )
+    {
+        const auto c_T = T.FoldRandom( attempts, reflectP );
+        const auto c_S = S.FoldRandom( attempts, reflectP );
+
+        if( !SameCountsQ( c_T, c_S ) )
+        {
+            ++failures;
+            std::cout << "FAIL (S): round " << round << ": flag counts differ\n";
+        }
+
+        // The balls are stored relative to the transforms of their ancestors; both trees have the same ones.
+        std::size_t bad = 0;
+
+        for( Int t = 0; t < 1000; ++t )
+        {
+            const Int i = Plain_T::LeftChild( internal_node(pick) );
+            const Int j = Plain_T::LeftChild( internal_node(pick) );
+
+            bad += CountSiblingMismatches<2,2>( S, T, i, j );
+            bad += CountSiblingMismatches<1,2>( S, T, i, j );
+            bad += CountSiblingMismatches<2,1>( S, T, i, j );
+
+            hit_count  += T.BallsCollideQ( i, j );
+            test_count += 1;
+        }
+
+        if( bad > 0 )
+        {
+            ++failures;
+            std::cout << "FAIL (S): round " << round << ": " << bad << " vectorized ball tests differ\n";
+        }
+    }
+
+    if( !SameCoordinatesQ( T, S ) )
+    {
+        ++failures;
+        std::cout << "FAIL (S): vertex coordinates differ\n";
+    }
+
+    std::cout << "(S) soa_ballsQ: " << rounds << " x " << attempts << " attempts, "
+              << hit_count << " of " << test_count << " sampled sibling tests overlap\n";
+
+    return failures;
+}
+
+// (R)
+static std::size_t CheckSpeculative( const Int n, const Int rounds, const LInt attempts )
+{
+    auto make_tree = [n]()
+    {
+        Plain_T T ( n, diam );
+
+        T.SetRandomEngine( Plain_T::PRNG_T( 45 ) );
+        T.UseWrappedGaussianAngles( Real(0.5) );
+        T.UseDiscreteWrappedGaussianPivots( 0.1 * static_cast<double>(n) );
+
+        return T;
+    };
+
+    Plain_T T = make_tree();
+
+    auto c_T = T.FoldRandom( rounds * attempts, reflectP );
+
+    std::size_t failures = 0;
+
+    const double N = static_cast<double>( rounds * attempts );
+
+    std::size_t identical_count = 0;
+
+    for( const Int batch_size : { Int(2), Int(7), Int(64) } )
+    {
+        Plain_T S = make_tree();
+
+        S.SetCollisionThreadCount( 2 );
+        S.SetSpeculationBatchSize( batch_size );
+
+        auto c_S = S.FoldRandom( rounds * attempts, reflectP );
+
+        for( std::size_t f = 0; f < Plain_T::fold_flag_count; ++f )
+        {
+            const double p_T = static_cast<double>(c_T[f]) / N;
+            const double p_S = static_cast<double>(c_S[f]) / N;
+            const double p   = 0.5 * (p_T + p_S);
+
+            // Standard error of p_T - p_S for two independent samples, plus one count for rare flags.
+            const double tol = 5.0 * std::sqrt( 2.0 * p * (1.0 - p) / N ) + 1.0 / N;
+
+            if( std::abs( p_T - p_S ) > tol )
+            {
+                ++failures;
+                std::cout << "FAIL (R): batch size " << batch_size << ": flag " << f << " has fraction "
+                          << p_S << ", serial " << p_T << " (tolerance " << tol << ")\n";
+            }
+        }
+
+        identical_count += SameCountsQ( c_T, c_S ) && SameCoordinatesQ( T, S );
+    }
+
+    std::cout << "(R) speculative: " << rounds * attempts << " attempts, "
+              << c_T[0] << " accepted, batch sizes 2, 7, 64, " << identical_count
+              << " of 3 walks identical to the serial one\n";
+
+    return failures;
+}
+
+// (U)
+static std::size_t CheckUpdateMethods( const Int n, const Int rounds, const LInt attempts )
+{
+    Plain_T T ( n, diam );
+    Plain_T S ( n, diam );
+
+    T.SetRandomEngine( Plain_T::PRNG_T( 46 ) );
+    S.SetRandomEngine( Plain_T::PRNG_T( 46 ) );
+
+    T.UseSubtreeUpdates();
+    S.UsePathUpdates();
+
+    std::size_t failures = 0;
+
+    for( Int round = 0; round < rounds; ++round )
+    {
+        const auto c_T = T.FoldRandom( attempts, reflectP );
+        const auto c_S = S.FoldRandom( attempts, reflectP );
+
+        if( !SameCountsQ( c_T, c_S ) )
+        {
+            ++failures;
+            std::cout << "FAIL (U): round " << round << ": flag counts differ\n";
+        }
+
+        std::size_t bad = 0;
+
+        for( Int node = 0; node < T.NodeCount(); ++node )
+        {
+            Real B_T [4];
+            Real B_S [4];
+
+            T.WriteNodeBall( node, &B_T[0] );
+            S.WriteNodeBall( node, &B_S[0] );
+
+            for( Int k = 0; k < 4; ++k ) { bad += (B_T[k] != B_S[k]); }
+        }
+
+        if( bad > 0 )
+        {
+            ++failures;
+            std::cout << "FAIL (U): round " << round << ": " << bad << " ball entries differ\n";
+        }
+    }
+
+    if( !SameCoordinatesQ( T, S ) )
+    {
+        ++failures;
+        std::cout << "FAIL (U): vertex coordinates differ\n";
+    }
+
+    std::cout << "(U) path updates: " << rounds << " x " << attempts << " attempts\n";
+
+    return failures;
+}
+
+// (P)
+static std::size_t CheckParallelCollisions( const Int n, const Int rounds, const LInt attempts )
+{
+    Count_T T ( n, diam );
+    Count_T S;
+
+    T.SetRandomEngine( Count_T::PRNG_T( 47 ) );
+
+    const LInt move_count = rounds * std::max( LInt(1), attempts / LInt(10) );
+
+    std::size_t failures      = 0;
+    std::size_t flag_bad      = 0;
+    std::size_t overlap_bad   = 0;
+    std::size_t tree_rejected = 0;
+
+    for( LInt move = 0; move < move_count; ++move )
+    {
+        // The copy starts from the same state, including the random engine, so it draws the same move.
+        S = T;
+        S.SetCollisionThreadCount( 4 );
+        S.SetParallelCollisionThreshold( 1 );
+
+        const Size_T o_T = T.CallCounters().overlap;
+        const Size_T o_S = S.CallCounters().overlap;
+
+        const auto c_T = T.FoldRandom( 1, reflectP );
+        const auto c_S = S.FoldRandom( 1, reflectP );
+
+        if( !SameCountsQ( c_T, c_S ) )
+        {
+            ++flag_bad;
+            continue;
+        }
+
+        const bool collisionQ = (c_T[static_cast<std::size_t>(Count_T::FoldFlag_T::RejectedByTree)] > LInt(0));
+
+        tree_rejected += collisionQ;
+
+        if( !collisionQ && (T.CallCounters().overlap - o_T != S.CallCounters().overlap - o_S) )
+        {
+            ++overlap_bad;
+        }
+    }
+
+    const std::size_t allowed = static_cast<std::size_t>(move_count / LInt(1000));
+
+    if( flag_bad + overlap_bad > allowed )
+    {
+        ++failures;
+        std::cout << "FAIL (P): of " << move_count << " moves, " << flag_bad << " got different fold flags and "
+                  << overlap_bad << " without collision tested different numbers of ball pairs (at most "
+                  << allowed << " allowed)\n";
+    }
+
+    std::cout << "(P) parallel collision checks: " << move_count << " moves, "
+              << tree_rejected << " rejected by the tree, " << flag_bad + overlap_bad << " borderline\n";
+
+    return failures;
+}
+
+int main( int argc, char** argv )
+{
+    const Int  n        = (argc > 1) ? std::atoll(argv[1]) : 1000;
+    const Int  rounds   = (argc > 2) ? std::atoll(argv[2]) : 50;
+    const LInt attempts = (argc > 3) ? std::atoll(argv[3]) : 2000;
+
+    std::size_t failures = 0;
+
+    failures += CheckFloatBalls( n, rounds, attempts );
+    failures += CheckSoABalls( n, rounds, attempts );
+    failures += CheckSpeculative( n, rounds, attempts );
+    failures += CheckUpdateMethods( n, rounds, attempts );
+    failures += CheckParallelCollisions( n, rounds, attempts );
+
+    std::cout << "clisby_tree_check: " << (failures == 0 ? "PASS" : "FAIL")
+              << " (" << failures << " failures)\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+// dijkstra_strategy_check — every DijkstraStrategy_T must find shortest paths
+// of the same length. Guided only reorders the faces within one layer of the
+// breadth-first search (by landmark bounds), so it must agree with the others
+// exactly, also on large diagrams. Random equilateral polygons (seeded
+// action-angle sampler) are projected to diagrams; for random pairs of arcs the
+// dual-graph distance from FindShortestPath is compared across all strategies,
+// in several rounds between which the diagram is mutated by pass simplification.
+// Then each diagram is pass-simplified with every strategy, which must keep the
+// diagram valid and the knot a knot. Prints the per-strategy search counters.
+// On large diagrams (polygon_edges >= 400), the searches of (A) with Guided must
+// sweep fewer faces in total than those with Bidirectional, which sweeps the
+// same layers in their stack order. Exit 0 = pass.
+//
+// Usage: ./dijkstra_strategy_check [polygon_edges] [polygon_count] [pairs]
+#include "../Knoodle.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using Int      = std::int64_t;
+using Real     = double;
+using PDC_T    = Knoodle::PlanarDiagramComplex<Int>;
+using PD_T     = PDC_T::PD_T;
+using Dijkstra = Knoodle::DijkstraStrategy_T;
+using PassSimplifier_T = PDC_T::PassSimplifier_T;
+
+static constexpr std::array<Dijkstra, 4> kStrategies {
+    Dijkstra::Unidirectional, Dijkstra::Alternating, Dijkstra::Bidirectional, Dijkstra::Guided
+};
+
+int main(int argc, char** argv)
+{
+    const Int         edges = (argc > 1) ? std::atoll(argv[1]) : Int(400);
+    const std::size_t count = (argc > 2) ? std::size_t(std::atoll(argv[2])) : std::size_t(8);
+    const std::size_t pairs = (argc > 3) ? std::size_t(std::atoll(argv[3])) : std::size_t(200);
+    const Int         rounds = 8;
+    const bool        largeQ = (edges >= Int(400));
+
+    using Sampler_T = Knoodle::ActionAngleSampler<Real, Int, Knoodle::PRNG_T, true>;
+    Sampler_T sampler{ Knoodle::PRNG_T(20261018) };
+    std::mt19937_64 rng(7);
+
+    std::size_t diagrams = 0, searches = 0, mutations = 0, length_mismatches = 0, simplify_failures = 0;
+    std::size_t bidirectional_faces = 0, guided_faces = 0;
+
+    for (std::size_t tries = 0; diagrams < count && tries < 20 * count; ++tries)
+    {
+        auto L = sampler.RandomEquilateralLink<Real, Int, float>(Int(1), edges);
+        auto [pd, unlinks] = PD_T::FromLinkEmbedding(L);
+        (void)unlinks;
+        if (!pd.ValidQ() || pd.CrossingCount() < Int(8)) { continue; }
+        ++diagrams;
+
+        // (A) Same distance for every strategy. The searches run on one diagram that is mutated between
+        // rounds by pass simplification with a small max_dist (without compression), so the pass simplifier
+        // must not reuse marks or landmarks of an older state of the diagram.
+        PDC_T host{ PD_T(pd) };
+        PassSimplifier_T& S = host.GetPassSimplifier(Dijkstra::Guided);
+        PD_T work = pd.CachelessCopy();
+
+        for (Int round = 0; round < rounds; ++round)
+        {
+            const Int m = work.MaxArcCount();
+            std::uniform_int_distribution<Int> arc(0, m - 1);
+
+            // The mutations below also search; count only the faces swept by the searches of this round.
+            const std::size_t bidirectional_before = S.DijkstraCounts(Dijkstra::Bidirectional).face_count;
+            const std::size_t guided_before        = S.DijkstraCounts(Dijkstra::Guided).face_count;
+
+            for (std::size_t k = 0; k < pairs / std::size_t(rounds); ++k)
+            {
+                const Int a = arc(rng);
+                const Int b = arc(rng);
+                if (a == b || !work.ArcActiveQ(a) || !work.ArcActiveQ(b)) { continue; }
+                ++searches;
+
+                Int reference = -1;
+                for (const Dijkstra s : kStrategies)
+                {
+                    const Int length = S.SetDijkstraStrategy(s).FindShortestPath(work, a, b, m).Size();
+                    if (s == kStrategies[0]) { reference = length; }
+                    else if (length != reference)
+                    {
+                        ++length_mismatches;
+                        std::cout << "MISMATCH: round " << round << ", arcs " << a << ", " << b << ": "
+                                  << Knoodle::ToString(s) << " found " << length
+                                  << ", Unidirectional " << reference << "\n";
+                    }
+                }
+            }
+
+            bidirectional_faces += S.DijkstraCounts(Dijkstra::Bidirectional).face_count - bidirectional_before;
+            guided_faces        += S.DijkstraCounts(Dijkstra::Guided).face_count - guided_before;
+
+            // Mutate the diagram.
+            S.SetDijkstraStrategy(Dijkstra::Guided);
+            const auto changes = S.template SimplifyPasses<PassSimplifier_T::SimplifyPasses_TArgs{}>(
+                work, { .max_dist = Int(3), .overQ = (round % 2 == 0), .compressQ = false }
+            );
+            ++mutations;
+            if (changes == 0 || work.InvalidQ() || work.CrossingCount() < Int(8)) { break; }
+        }
+
+        for (const Dijkstra s : kStrategies)
+        {
+            std::cout << "  " << Knoodle::ToString(s) << ": "
+                      << ToString(S.DijkstraCounts(s)) << "\n";
+        }
+
+        // (B) Pass simplification with every strategy.
+        for (const Dijkstra s : kStrategies)
+        {
+            PDC_T P{ PD_T(pd) };
+            PDC_T::Simplify_Args_T args{};
+            args.strategy = s;
+            P.Simplify(args);
+
+            Int components = 0;
+            bool validQ = P.ValidQ();
+            for (Int i = 0; validQ && i < P.DiagramCount(); ++i)
+            {
+                validQ = P.Diagram(i).CheckAll();
+                components += P.Diagram(i).LinkComponentCount();
+            }
+            if (!validQ || (P.DiagramCount() > Int(0) && components != P.DiagramCount()))
+            {
+                ++simplify_failures;
+                std::cout << "FAIL: Simplify with " << Knoodle::ToString(s)
+                          << " produced an invalid diagram or changed the component count\n";
+            }
+        }
+    }
+
+    std::cout << "dijkstra_strategy_check: " << diagrams << " diagrams (" << edges << "-gons), "
+              << searches << " searches, " << mutations << " mutations, length mismatches: " << length_mismatches
+              << ", simplify failures: " << simplify_failures << "\n";
+    std::cout << "faces swept by the searches: Bidirectional " << bidirectional_faces
+              << ", Guided " << guided_faces << "\n";
+
+    const bool fewer_facesQ = !largeQ || (guided_faces < bidirectional_faces);
+    if (!fewer_facesQ)
+    {
+        std::cout << "FAIL: Guided did not sweep fewer faces than Bidirectional\n";
+    }
+
+    const bool passQ = (diagrams > 0) && (length_mismatches == 0) && (simplify_failures == 0) && fewer_facesQ;
+    std::cout << (passQ ? "PASS" : "FAIL") << "\n";
+    return passQ ? 0 : 1;
+}
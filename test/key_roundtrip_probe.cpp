@@ -104,7 +104,7 @@ int main(int argc, char** argv)
     //==========================================================================
     std::size_t total = 0, stage1_bad = 0, stage2_bad = 0, invalid_pd = 0;
 
-    for (std::size_t c = 3; c <= Klut::max_crossing_count; ++c)
+    for (std::size_t c = 3; c <= klut.AvailableCrossingCount(); ++c)
     {
         std::ifstream stream(klut.KeyFile(c), std::ios::binary);
         if (!stream)
@@ -26,27 +26,55 @@
  * real polygonal-knot enumeration workload (mostly unknots, a tail of small
  * knots, occasional >13-crossing diagrams that escalate or stay Unidentified).
  *
- * Parallel scaling uses the REENTRANT path: subtables pre-loaded once
- * (LoadSubtables, avoiding the lazy-load race); ki::Identify's lookups use a
- * thread-local buffer (FindID(buffer, c), NOT the shared-buffer FindID(pd)) over
- * the shared read-only table, and each worker thread owns its own Reapr.
+ * Regression suite (--suite=OUT.json): runs fixed corpora -- the KLUT minimals,
+ * their perturbations, and polygon firehoses at several N (--suite-polygons) --
+ * and writes throughput, p50/p99 latency per stage, reapr calls/item, resolved
+ * and correct rates and the peak RSS of the process as JSON (ru_maxrss is
+ * process-wide: a corpus reports the peak of everything run before it, too).
+ * The corpora are pool files in --corpus-dir, built on first use and reused
+ * verbatim afterwards; pin that directory to compare across Knoodle versions.
+ * --compare=BASE.json flags every
+ * metric that is worse than the baseline by more than --tolerance (relative,
+ * default 0.10) or --rate-tolerance (absolute, default 0.005) and exits with 1;
+ * --compare=BASE.json --current=CUR.json compares two stored results.
+ *
+ * Escalation profile (--escalation-profile=PATH): every mode escalates with the
+ * adaptive schedule of klut_escalation_profile.hpp instead of plain doubling.
+ * PATH is loaded if it exists, all chains record into it, and it is written back
+ * on exit -- so a suite or firehose run trains the profile that knoodleidentify
+ * --escalation-profile=PATH then uses.
+ *
+ * Parallel scaling shares one Klut across all workers: its const query API is
+ * reentrant (stack scratch, once-flag lazy loading). The subtables are still
+ * pre-loaded once (RequireSubtables) so loading stays out of the timed stages,
+ * and each worker thread owns its own Reapr.
  *
  * Build: test/Makefile target klut_bench (UMFPACK + Accelerate, like inflate_check).
  */
 
 #include "../Knoodle.hpp"
 #include "../tools/klut_identify.hpp"
+#include "../tools/klut_escalation_profile.hpp"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cctype>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
+#include <sys/resource.h>   // getrusage
 
 using Int     = std::int64_t;
 using Real    = double;
@@ -234,7 +262,10 @@ std::vector<Item> LoadPool(const std::string& path)
     return pool;
 }
 
-struct Stage { double construct = 0, identify = 0; std::size_t reapr_calls = 0; };
+struct Stage { double construct = 0, identify = 0; std::size_t reapr_calls = 0, resolved = 0; };
+
+// Per-item stage times in ns, recorded by RunChain on request (suite mode).
+struct Latencies { std::vector<double> construct, identify; };
 
 // True iff Identify resolved `it` to exactly the source knot: a single Identified
 // summand at the source's crossing number and id.
@@ -247,20 +278,34 @@ bool IdentifiedAsSource(const ki::IdentifyResult& r, const Item& it)
         && r.summands[0].id == it.src_id;
 }
 
+// True iff Identify fully resolved the input: a knot whose summands (if any)
+// are all Identified. Applies to every corpus, also to those without a source.
+bool ResolvedQ(const ki::IdentifyResult& r)
+{
+    if (r.status != ki::IdentifyResult::Status::Knot || r.component_error) { return false; }
+    for (const auto& sm : r.summands)
+    {
+        if (sm.kind != ki::Summand::Kind::Identified) { return false; }
+    }
+    return true;
+}
+
 // Run `iters` identify chains over the pool (cycled), accumulating per-stage time
 // and the escalation count. Returns the stage totals; `correct` counts items that
-// resolved to the source knot. One Reapr and one set of scratch PDCs / result are
-// reused across all items via ki::IdentifyInto (the realistic reentrant firehose
-// path) and are therefore thread-local to this chain. The per-item input PD_T is
+// resolved to the source knot. One Reapr, one Simplify workspace and one set of
+// scratch PDCs / result are reused across all items via ki::IdentifyInto (the
+// realistic reentrant firehose path) and are therefore thread-local to this chain. The per-item input PD_T is
 // always freshly built (each pool item is a different diagram).
 Stage RunChain(const std::vector<Item>& pool, Klut& klut, std::size_t iters,
                std::size_t start, std::size_t stride, std::atomic<std::size_t>* correct,
-               const ki::IdentifyParams& q)
+               const ki::IdentifyParams& q, Latencies* lat = nullptr)
 {
+    if (lat) { lat->construct.reserve(iters); lat->identify.reserve(iters); }
     Stage s;
     std::size_t hits = 0;
     Reapr_T reapr{};
     PDC_T work, temp;            // scratch, reused across items
+    ki::Workspace_T workspace;   // Simplify scratch, reused across items
     ki::IdentifyResult R;        // result, reused across items
     for (std::size_t i = 0; i < iters; ++i)
     {
@@ -272,13 +317,19 @@ Stage RunChain(const std::vector<Item>& pool, Klut& klut, std::size_t iters,
         work.Push(PD_T::FromSignedPDCode(it.code.data(), rows, false, true));
         auto t1 = Clock::now();
 
-        ki::IdentifyInto(klut, work, temp, reapr, R, q);
+        ki::IdentifyInto(klut, work, temp, reapr, &workspace, R, q);
         auto t2 = Clock::now();
 
         s.reapr_calls += static_cast<std::size_t>(R.reapr_calls);
         if (IdentifiedAsSource(R, it)) { ++hits; }
+        if (ResolvedQ(R)) { ++s.resolved; }
         s.construct += Secs(t0, t1);
         s.identify  += Secs(t1, t2);
+        if (lat)
+        {
+            lat->construct.push_back(Secs(t0, t1) * 1e9);
+            lat->identify.push_back(Secs(t1, t2) * 1e9);
+        }
     }
     if (correct) { correct->fetch_add(hits, std::memory_order_relaxed); }
     return s;
@@ -348,6 +399,400 @@ const char* CompactionName(PDC_T::Compaction_T c)
     }
 }
 
+//==============================================================================
+// Regression suite (--suite=OUT.json). Every corpus is a pool file in
+// --corpus-dir; a missing one is built once and saved, an existing one is used
+// verbatim, so the inputs stay fixed across runs and Knoodle versions. The
+// FNV-1a hash of each pool file goes into the results, so a comparison notices
+// when two runs did not see the same corpus. --compare=BASE.json then flags
+// metrics that got worse than the baseline by more than the tolerance.
+//==============================================================================
+
+constexpr int kSuiteVersion = 1;
+
+std::uint64_t FileHash(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    char ch;
+    while (in.get(ch)) { h = (h ^ static_cast<unsigned char>(ch)) * 0x100000001b3ULL; }
+    return h;
+}
+
+std::string Hex(std::uint64_t x)
+{
+    char buf[17];
+    std::snprintf(buf, sizeof buf, "%016llx", static_cast<unsigned long long>(x));
+    return buf;
+}
+
+// The KLUT minimal diagrams themselves: the cheapest case, a direct hit.
+std::vector<Item> MinimalCorpus(const std::vector<PD_T>& minimals, Klut& klut)
+{
+    std::vector<Item> pool;
+    std::array<CodeInt, Klut::max_crossing_count> kbuf{};
+    for (const PD_T& m_in : minimals)
+    {
+        PD_T m(m_in);
+        const Int c = m.CrossingCount();
+        m.template WriteMacLeodCode<CodeInt>(kbuf.data());
+        auto [mc, src_id] = klut.FindID(kbuf.data(), c);
+        (void)mc;
+        pool.push_back(Item{ SignedPDCode(m), c, c, src_id });
+    }
+    return pool;
+}
+
+// `count` random equilateral `edges`-gons from the seeded action-angle sampler.
+// There is no source knot (src_id = not_found); crossing-free projections are
+// skipped, they never reach the table.
+std::vector<Item> PolygonCorpus(Int edges, std::size_t count, std::uint64_t seed)
+{
+    using Sampler_T = Knoodle::ActionAngleSampler<Real, Int, Knoodle::PRNG_T, true>;
+    Sampler_T sampler{ Knoodle::PRNG_T(seed) };
+    std::vector<Item> pool;
+    for (std::size_t tries = 0; pool.size() < count && tries < 20 * count; ++tries)
+    {
+        auto L = sampler.RandomEquilateralLink<Real, Int, float>(Int(1), edges);
+        auto [pd, unlinks] = PD_T::FromLinkEmbedding(L);
+        (void)unlinks;
+        if (!pd.ValidQ() || pd.CrossingCount() == Int(0)) { continue; }
+        pool.push_back(Item{ SignedPDCode(pd), pd.CrossingCount(), Int(0), Klut::not_found });
+    }
+    return pool;
+}
+
+template<typename F>
+std::vector<Item> LoadOrBuildCorpus(const std::filesystem::path& dir, const std::string& name,
+                                    F&& build, std::uint64_t& hash)
+{
+    const std::string path = (dir / (name + ".pool")).string();
+    std::vector<Item> pool;
+    if (std::filesystem::exists(path))
+    {
+        pool = LoadPool(path);
+        std::cout << "  corpus " << name << ": " << pool.size() << " diagrams from " << path << "\n";
+    }
+    else
+    {
+        pool = build();
+        std::filesystem::create_directories(dir);
+        if (!SavePool(pool, path))
+        {
+            std::cerr << "  warning: could not save corpus to " << path << "\n";
+            hash = 0;
+            return pool;
+        }
+        std::cout << "  corpus " << name << ": built " << pool.size()
+                  << " diagrams, saved to " << path << "\n";
+    }
+    hash = FileHash(path);
+    return pool;
+}
+
+// Nearest-rank percentile, q in [0,1]: the ceil(q*n)-th smallest value.
+double Percentile(std::vector<double> v, double q)
+{
+    if (v.empty()) { return 0; }
+    const double rank = std::ceil(q * static_cast<double>(v.size()));
+    const std::size_t k = std::min(v.size() - 1,
+        static_cast<std::size_t>(std::max(rank, 1.0)) - 1);
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+// Peak resident set size of the process so far (ru_maxrss is KiB on Linux, bytes on macOS).
+// This is not a per-corpus number: it never decreases, and it includes the corpora,
+// tables and caches of everything that ran before.
+double PeakRSSBytes()
+{
+    struct rusage ru {};
+    if (::getrusage(RUSAGE_SELF, &ru) != 0) { return 0; }
+#if defined(__APPLE__)
+    return static_cast<double>(ru.ru_maxrss);
+#else
+    return static_cast<double>(ru.ru_maxrss) * 1024.0;
+#endif
+}
+
+struct CorpusResult
+{
+    std::string   name;
+    std::uint64_t hash  = 0;
+    std::size_t   items = 0;
+    std::vector<std::pair<std::string, double>> metrics;
+};
+
+CorpusResult RunCorpus(const std::string& name, const std::vector<Item>& pool,
+                       std::uint64_t hash, Klut& klut, std::size_t iters,
+                       const ki::IdentifyParams& q)
+{
+    CorpusResult r{ name, hash, pool.size(), {} };
+    std::atomic<std::size_t> correct{0};
+    Latencies lat;
+    const auto t0 = Clock::now();
+    const Stage s = RunChain(pool, klut, iters, 0, 1, &correct, q, &lat);
+    const auto t1 = Clock::now();
+    const double wall = Secs(t0, t1);
+    const double n = static_cast<double>(iters);
+
+    bool sourcedQ = false;
+    for (const Item& it : pool) { if (it.src_id != Klut::not_found) { sourcedQ = true; break; } }
+
+    r.metrics = {
+        {"throughput_items_per_s", n / wall},
+        {"construct_p50_ns",       Percentile(lat.construct, 0.50)},
+        {"construct_p99_ns",       Percentile(lat.construct, 0.99)},
+        {"identify_p50_ns",        Percentile(lat.identify, 0.50)},
+        {"identify_p99_ns",        Percentile(lat.identify, 0.99)},
+        {"reapr_calls_per_item",   static_cast<double>(s.reapr_calls) / n},
+        {"resolved_rate",          static_cast<double>(s.resolved) / n},
+        {"process_peak_rss_bytes", PeakRSSBytes()},
+    };
+    if (sourcedQ) { r.metrics.push_back({"correct_rate", static_cast<double>(correct.load()) / n}); }
+
+    std::cout << "    " << name << ": " << (n / wall) << " items/s, identify p50/p99 "
+              << Percentile(lat.identify, 0.50) << "/" << Percentile(lat.identify, 0.99)
+              << " ns, " << (static_cast<double>(s.reapr_calls) / n) << " reapr calls/item\n";
+    return r;
+}
+
+std::string JsonEscape(const std::string& s)
+{
+    std::string out;
+    for (const char c : s)
+    {
+        if (c == '"' || c == '\\') { out.push_back('\\'); }
+        out.push_back(c);
+    }
+    return out;
+}
+
+bool WriteSuiteJson(const std::string& path, const std::vector<CorpusResult>& results,
+                    std::size_t iters, const ki::IdentifyParams& q, const std::string& klut_dir)
+{
+    std::ofstream out(path);
+    if (!out) { return false; }
+    out.precision(10);
+    out << "{\n"
+        << "  \"schema\": \"klut_bench_suite\",\n"
+        << "  \"version\": " << kSuiteVersion << ",\n"
+        << "  \"klut_dir\": \"" << JsonEscape(klut_dir) << "\",\n"
+        << "  \"suite_iters\": " << iters << ",\n"
+        << "  \"params\": { \"n0\": " << q.n0 << ", \"cap\": " << q.cap
+        << ", \"deep_cx\": " << q.deep_cx << ", \"rot\": " << q.rot
+        << ", \"max_cx\": " << q.max_cx << " },\n"
+        << "  \"corpora\": {";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const CorpusResult& r = results[i];
+        out << (i ? ",\n" : "\n") << "    \"" << r.name << "\": {\n"
+            << "      \"corpus_hash\": \"" << Hex(r.hash) << "\",\n"
+            << "      \"corpus_items\": " << r.items;
+        for (const auto& [key, value] : r.metrics)
+        {
+            out << ",\n      \"" << key << "\": " << value;
+        }
+        out << "\n    }";
+    }
+    out << "\n  }\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Just enough JSON to read back what WriteSuiteJson writes (and hand edits of
+// it): objects, arrays, strings without escapes beyond \" and \\, numbers,
+// true/false/null. Values are flattened to "corpora.perturbed.identify_p99_ns".
+class FlatJson
+{
+public:
+    std::map<std::string, double>      numbers;
+    std::map<std::string, std::string> strings;
+
+    bool Parse(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in) { return false; }
+        text_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        pos_ = 0;
+        return Value("") && (Skip(), pos_ == text_.size());
+    }
+
+private:
+    std::string text_;
+    std::size_t pos_ = 0;
+
+    void Skip() { while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) { ++pos_; } }
+
+    bool Eat(char c) { Skip(); if (pos_ < text_.size() && text_[pos_] == c) { ++pos_; return true; } return false; }
+
+    bool String(std::string& out)
+    {
+        if (!Eat('"')) { return false; }
+        out.clear();
+        while (pos_ < text_.size() && text_[pos_] != '"')
+        {
+            if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) { ++pos_; }
+            out.push_back(text_[pos_++]);
+        }
+        return Eat('"');
+    }
+
+    bool Value(const std::string& key)
+    {
+        Skip();
+        if (pos_ >= text_.size()) { return false; }
+        const char c = text_[pos_];
+        const std::string prefix = key.empty() ? key : key + ".";
+        if (c == '{')
+        {
+            ++pos_;
+            if (Eat('}')) { return true; }
+            do
+            {
+                std::string name;
+                if (!String(name) || !Eat(':') || !Value(prefix + name)) { return false; }
+            }
+            while (Eat(','));
+            return Eat('}');
+        }
+        if (c == '[')
+        {
+            ++pos_;
+            if (Eat(']')) { return true; }
+            std::size_t i = 0;
+            do { if (!Value(prefix + std::to_string(i++))) { return false; } } while (Eat(','));
+            return Eat(']');
+        }
+        if (c == '"')
+        {
+            std::string v;
+            if (!String(v)) { return false; }
+            strings[key] = v;
+            return true;
+        }
+        for (const char* word : {"true", "false", "null"})
+        {
+            if (text_.compare(pos_, std::strlen(word), word) == 0) { pos_ += std::strlen(word); return true; }
+        }
+        const char* begin = text_.c_str() + pos_;
+        char* end = nullptr;
+        const double v = std::strtod(begin, &end);
+        if (end == begin) { return false; }
+        pos_ += static_cast<std::size_t>(end - begin);
+        numbers[key] = v;
+        return true;
+    }
+};
+
+// Compares every corpus metric of `base` with `cur`. Throughputs and rates must
+// not drop, times, reapr calls and memory must not grow, by more than `tol`
+// (relative; rates by `rate_tol` absolute). Results of another schema or suite
+// version are not compared at all, and the metrics of a corpus whose hash
+// differs are skipped. Returns the number of regressions.
+std::size_t CompareSuites(const FlatJson& base, const FlatJson& cur, double tol, double rate_tol)
+{
+    auto ends_with = [](const std::string& s, const std::string& t) {
+        return s.size() >= t.size() && s.compare(s.size() - t.size(), t.size(), t) == 0;
+    };
+
+    for (const auto& [json, name] : { std::pair{ &base, "baseline" }, std::pair{ &cur, "current" } })
+    {
+        auto schema  = json->strings.find("schema");
+        auto version = json->numbers.find("version");
+        if (schema == json->strings.end() || schema->second != "klut_bench_suite" ||
+            version == json->numbers.end() || version->second != double(kSuiteVersion))
+        {
+            std::cout << "  INCOMPATIBLE " << name << " results: expected schema klut_bench_suite, version "
+                      << kSuiteVersion << "; nothing compared\n";
+            return 1;
+        }
+    }
+
+    std::size_t regressions = 0, checked = 0;
+
+    // "corpora.NAME." prefixes of the corpora whose numbers are not comparable.
+    std::vector<std::string> skipped;
+
+    for (const auto& [key, hash] : base.strings)
+    {
+        if (!key.starts_with("corpora.") || !ends_with(key, ".corpus_hash")) { continue; }
+        auto it = cur.strings.find(key);
+        if (it == cur.strings.end())
+        {
+            std::cout << "  MISSING    " << key.substr(8, key.size() - 8 - 12) << " (corpus not in current run)\n";
+            ++regressions;
+        }
+        else if (it->second != hash)
+        {
+            std::cout << "  WARNING    " << key << ": " << hash << " -> " << it->second
+                      << " (different corpus; its numbers are skipped)\n";
+            skipped.push_back(key.substr(0, key.size() - 11));
+        }
+    }
+
+    for (const auto& [key, b] : base.numbers)
+    {
+        if (!key.starts_with("corpora.") || ends_with(key, ".corpus_items")) { continue; }
+        if (std::any_of(skipped.begin(), skipped.end(),
+                        [&key](const std::string& prefix) { return key.starts_with(prefix); }))
+        {
+            continue;
+        }
+        auto it = cur.numbers.find(key);
+        if (it == cur.numbers.end()) { continue; }
+        const double c = it->second;
+        ++checked;
+
+        bool worseQ = false;
+        if (ends_with(key, "_rate"))
+        {
+            worseQ = (c < b - rate_tol);
+        }
+        else if (ends_with(key, "_per_s"))
+        {
+            worseQ = (c < b * (1.0 - tol));
+        }
+        else   // _ns, reapr_calls_per_item, process_peak_rss_bytes: lower is better
+        {
+            worseQ = (c > b * (1.0 + tol));
+        }
+
+        const double change = (b != 0) ? 100.0 * (c - b) / b : 0.0;
+        char buf[256];
+        std::snprintf(buf, sizeof buf, "  %-10s %-48s %14.6g -> %14.6g  (%+.1f%%)\n",
+                      worseQ ? "REGRESSION" : "ok", key.substr(8).c_str(), b, c, change);
+        std::cout << buf;
+        if (worseQ) { ++regressions; }
+    }
+
+    std::cout << "  " << checked << " metrics compared, " << regressions << " regression(s)"
+              << " (tolerance " << 100.0 * tol << "%, rates " << rate_tol << " absolute)\n";
+    return regressions;
+}
+
+// --escalation-profile=PATH: loaded at startup, shared by all chains through
+// IdentifyParams::profile, written back when main returns (from any mode).
+struct ProfileFile
+{
+    std::string           path;
+    ki::EscalationProfile profile;
+
+    ~ProfileFile()
+    {
+        if (path.empty()) { return; }
+        const auto [steps, resolved] = profile.Totals();
+        if (profile.Save(path))
+        {
+            std::cout << "  escalation profile: " << steps << " recorded rounds ("
+                      << resolved << " resolved) written to " << path << "\n";
+        }
+        else
+        {
+            std::cerr << "cannot write escalation profile " << path << "\n";
+        }
+    }
+};
+
 } // namespace
 
 int main(int argc, char* argv[])
@@ -377,7 +822,16 @@ int main(int argc, char* argv[])
     long   ssn_max_iter  = -1;   // --ssn-max-iter=N: Reapr energy-min max iterations (>=0 to override)
     double scaling       = -1;   // --scaling=X: Reapr embedding scaling (>0 to override)
     std::string pool_file;       // --pool-file=PATH: load pool if it exists, else build + save
+    std::string suite_file;      // --suite=PATH: run the regression suite, write JSON results
+    std::string compare_file;    // --compare=PATH: flag regressions against this baseline
+    std::string current_file;    // --current=PATH: compare this stored result instead of running
+    std::string corpus_dir = "klut_bench_corpora"; // --corpus-dir=DIR: the suite's pinned pools
+    std::size_t suite_iters = 20000;               // --suite-iters=N: items per corpus
+    std::vector<Int> suite_polygons = {16, 32, 64}; // --suite-polygons=N,M,...: polygon corpora
+    double tolerance = 0.10;     // --tolerance=X: relative slack before a metric regresses
+    double rate_tolerance = 0.005; // --rate-tolerance=X: absolute slack for *_rate metrics
     std::vector<int> thread_counts = {1, 2, 4, 8};
+    ProfileFile esc_profile;     // --escalation-profile=PATH: adaptive escalation, trained + saved
 
     for (int i = 1; i < argc; ++i)
     {
@@ -405,13 +859,52 @@ int main(int argc, char* argv[])
         else if (a.rfind("--ssn-max-iter=", 0) == 0)  ssn_max_iter = std::stol(v("--ssn-max-iter="));
         else if (a.rfind("--scaling=", 0) == 0)       scaling = std::stod(v("--scaling="));
         else if (a.rfind("--pool-file=", 0) == 0) pool_file = v("--pool-file=");
+        else if (a.rfind("--suite=", 0) == 0)      suite_file = v("--suite=");
+        else if (a.rfind("--compare=", 0) == 0)    compare_file = v("--compare=");
+        else if (a.rfind("--current=", 0) == 0)    current_file = v("--current=");
+        else if (a.rfind("--corpus-dir=", 0) == 0) corpus_dir = v("--corpus-dir=");
+        else if (a.rfind("--suite-iters=", 0) == 0) suite_iters = std::stoull(v("--suite-iters="));
+        else if (a.rfind("--tolerance=", 0) == 0)  tolerance = std::stod(v("--tolerance="));
+        else if (a.rfind("--rate-tolerance=", 0) == 0) rate_tolerance = std::stod(v("--rate-tolerance="));
+        else if (a.rfind("--escalation-profile=", 0) == 0) esc_profile.path = v("--escalation-profile=");
+        else if (a.rfind("--suite-polygons=", 0) == 0)
+        {
+            suite_polygons.clear();
+            std::string list = v("--suite-polygons=");
+            for (std::size_t b = 0, e; b < list.size(); b = e + 1)
+            {
+                e = list.find(',', b);
+                if (e == std::string::npos) { e = list.size(); }
+                if (e > b) { suite_polygons.push_back(std::stoll(list.substr(b, e - b))); }
+            }
+        }
+    }
+
+    // Compare two stored results; no table needed.
+    if (!compare_file.empty() && !current_file.empty())
+    {
+        FlatJson base, cur;
+        if (!base.Parse(compare_file)) { std::cerr << "cannot parse " << compare_file << "\n"; return 2; }
+        if (!cur.Parse(current_file))  { std::cerr << "cannot parse " << current_file << "\n"; return 2; }
+        std::cout << "klut_bench: " << current_file << " vs. baseline " << compare_file << "\n";
+        return CompareSuites(base, cur, tolerance, rate_tolerance) == 0 ? 0 : 1;
+    }
+
+    if (!esc_profile.path.empty() && std::filesystem::exists(esc_profile.path) &&
+        !esc_profile.profile.Load(esc_profile.path))
+    {
+        std::cerr << "cannot read escalation profile " << esc_profile.path << "\n";
+        esc_profile.path.clear();
+        return 2;
     }
 
     const ki::IdentifyParams idp{ .n0 = n0, .cap = cap_escalate,
                                   .deep_cx = band_escalate, .rot = rot_trials,
                                   .max_cx = static_cast<Int>(c_max),
                                   .seed_local_opt = seed_local_opt,
-                                  .seed_reroute = (seed_reroute != 0) };
+                                  .seed_reroute = (seed_reroute != 0),
+                                  .profile = esc_profile.path.empty() ? nullptr
+                                                                      : &esc_profile.profile };
 
     std::cout << "klut_bench: KLUT Identify-path throughput\n"
               << "  klut-dir=" << klut_dir << "  c_max=" << c_max
@@ -420,13 +913,68 @@ int main(int argc, char* argv[])
               << "  seed-local-opt=" << static_cast<long long>(seed_local_opt)
               << "  seed-reroute=" << seed_reroute << "\n\n";
 
-    // Build the table and pre-load (single-threaded) so parallel reads are safe.
+    // Build the table and pre-load it, so that loading is not part of the timed stages.
     Klut klut{ std::filesystem::path(klut_dir), static_cast<Knoodle::Size_T>(c_max) };
     const auto tL0 = Clock::now();
-    klut.LoadSubtables();
+    klut.RequireSubtables();
     const auto tL1 = Clock::now();
     std::cout << "  subtables loaded in " << Secs(tL0, tL1) << " s\n";
 
+    // Regression suite: fixed corpora, single thread, JSON results; with
+    // --compare=BASE.json, exit status 1 if any metric regressed.
+    if (!suite_file.empty())
+    {
+        const std::filesystem::path dir(corpus_dir);
+        std::vector<PD_T> minimals;
+        auto need_minimals = [&]() -> const std::vector<PD_T>& {
+            if (minimals.empty()) { minimals = SampleMinimals(klut_dir, c_max, per_c); }
+            return minimals;
+        };
+
+        std::vector<std::pair<std::string, std::vector<Item>>> corpora;
+        std::vector<std::uint64_t> hashes;
+        auto add = [&](const std::string& name, auto&& build) {
+            std::uint64_t h = 0;
+            auto pool = LoadOrBuildCorpus(dir, name, build, h);
+            if (pool.empty()) { std::cerr << "  warning: corpus " << name << " is empty; skipped\n"; return; }
+            corpora.emplace_back(name, std::move(pool));
+            hashes.push_back(h);
+        };
+
+        add("minimal",   [&]() { return MinimalCorpus(need_minimals(), klut); });
+        add("perturbed", [&]() { return BuildPool(need_minimals(), cap, 0xC0FFEE, 8, klut); });
+        for (Int N : suite_polygons)
+        {
+            add("polygon-" + std::to_string(N), [&, N]() {
+                return PolygonCorpus(N, 2000, polygon_seed + static_cast<std::uint64_t>(N));
+            });
+        }
+
+        suite_iters = std::max(suite_iters, std::size_t(1));
+        std::cout << "\n  suite (single thread, " << suite_iters << " items per corpus):\n";
+        std::vector<CorpusResult> results;
+        for (std::size_t i = 0; i < corpora.size(); ++i)
+        {
+            results.push_back(RunCorpus(corpora[i].first, corpora[i].second, hashes[i],
+                                        klut, suite_iters, idp));
+        }
+
+        if (!WriteSuiteJson(suite_file, results, suite_iters, idp, klut_dir))
+        {
+            std::cerr << "cannot write " << suite_file << "\n";
+            return 2;
+        }
+        std::cout << "  results written to " << suite_file << "\n";
+
+        if (compare_file.empty()) { return 0; }
+
+        FlatJson base, cur;
+        if (!base.Parse(compare_file)) { std::cerr << "cannot parse " << compare_file << "\n"; return 2; }
+        if (!cur.Parse(suite_file))    { std::cerr << "cannot parse " << suite_file << "\n"; return 2; }
+        std::cout << "\n  comparison with baseline " << compare_file << ":\n";
+        return CompareSuites(base, cur, tolerance, rate_tolerance) == 0 ? 0 : 1;
+    }
+
     // Polygon-firehose mode: instead of the perturbed KLUT pool, generate fresh
     // random equilateral polygons (single-component knots) with the progressive
     // action-angle sampler, project each to a PD, and Identify it. Generation and
@@ -449,6 +997,7 @@ int main(int argc, char* argv[])
         Sampler_T sampler{ Knoodle::PRNG_T(polygon_seed) };
         Reapr_T reapr{ rset };
         PDC_T work, temp;
+        ki::Workspace_T workspace;
         ki::IdentifyResult R;
 
         double t_gen = 0, t_classify = 0;
@@ -487,7 +1036,7 @@ int main(int argc, char* argv[])
                 gen_c_sum += static_cast<double>(gc);
                 work.Clear();
                 work.Push(std::move(pd));
-                ki::IdentifyInto(klut, work, temp, reapr, R, idp);
+                ki::IdentifyInto(klut, work, temp, reapr, &workspace, R, idp);
             }
             auto t2 = Clock::now();
 
@@ -315,6 +315,7 @@ int main(int argc, char* argv[])
     int  from_c = 3, to_c = 13;
     long per    = 100;
     long seed   = 0;
+    int  threads = 1;
     bool keep_temp = false;
 
     for (int k = 1; k < argc; ++k)
@@ -327,6 +328,7 @@ int main(int argc, char* argv[])
         else if (a.rfind("--from-crossing=", 0) == 0)  from_c = std::stoi(a.substr(16));
         else if (a.rfind("--up-to-crossing=", 0) == 0) to_c = std::stoi(a.substr(17));
         else if (a.rfind("--seed=", 0) == 0)           seed = std::stol(a.substr(7));
+        else if (a.rfind("--threads=", 0) == 0)        threads = std::stoi(a.substr(10));
         else if (a == "--keep-temp")                   keep_temp = true;
         else if (a == "-h" || a == "--help")
         {
@@ -342,6 +344,9 @@ int main(int argc, char* argv[])
                 "  --from-crossing=N     first crossing number (default 3)\n"
                 "  --up-to-crossing=N    last crossing number (default 13)\n"
                 "  --seed=N              shift which keys are sampled (default 0)\n"
+                "  --threads=N           run the tools with --threads=N (default 1);\n"
+                "                        the in-order comparison then also checks\n"
+                "                        that the parallel output keeps input order\n"
                 "  --keep-temp           do not delete the temp input/output files\n";
             return 0;
         }
@@ -378,9 +383,11 @@ int main(int argc, char* argv[])
     if (ec || abs_dir.empty()) { abs_dir = dir; }
 
     const std::string cmd =
-        Shq(simplify) + " --streaming-mode --quiet < " + Shq(in_path) +
+        Shq(simplify) + " --streaming-mode --quiet --threads=" + std::to_string(threads) +
+        " < " + Shq(in_path) +
         " 2> " + Shq(sim_log) + " | " +
-        Shq(identify) + " --expanded --quiet --data-dir=" + Shq(abs_dir) +
+        Shq(identify) + " --expanded --quiet --threads=" + std::to_string(threads) +
+        " --data-dir=" + Shq(abs_dir) +
         " > " + Shq(out_path) + " 2> " + Shq(id_log);
 
     std::cout << "  running pipeline...\n";
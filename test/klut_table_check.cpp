@@ -0,0 +1,228 @@
+/**
+ * @file klut_table_check.cpp
+ * @brief Round-trip test of the prebuilt, memory-mapped KLUT table files
+ *        (Klut_Table_NN.bin, see Klut::TableHeader_T).
+ *
+ * Loads the text tables (Klut_Keys_NN.bin + Klut_Values_NN.tsv), converts each
+ * subtable with Klut::WriteTableFile into a scratch directory, and opens a
+ * second Klut on that directory, which then has ONLY the table files. For every
+ * key of every subtable it checks:
+ *
+ *  (A) FindID agrees: same (crossing_count, id) from the hash map and from the
+ *      binary search over the mapped key array.
+ *  (B) FindName agrees: the name from the mapped string pool equals the name
+ *      parsed from the tsv.
+ *  (C) The key counts and knot counts agree, and a code that is not in the
+ *      table (the first key with its first entry bumped) is NotFound in both
+ *      or found with the same id in both.
+ *  (P) Packing: UnpackKey(PackKey(key)) gives back every key, in
+ *      PackedKeyByteCount(c) bytes.
+ *  (E) Batch lookups: FindIDs over all codes of a subtable, and over one batch
+ *      of keys with mixed crossing counts, agree with FindID in both modes.
+ *  (D) Concurrency: fresh, not-yet-loaded instances (text and table) are
+ *      queried through the const API from several threads at once; the first
+ *      lookups race into the lazy loading. All answers must match (A).
+ *
+ * Build (from test/): make klut_table_check (light config, no UMFPACK).
+ * Run:
+ *   ./klut_table_check [../data/Klut] [max_crossings]
+ */
+
+#include "../Knoodle.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>   // getpid
+
+using Klut    = Knoodle::Klut;
+using CodeInt = Klut::CodeInt;
+
+int main(int argc, char** argv)
+{
+    namespace fs = std::filesystem;
+
+    const fs::path data_dir = (argc > 1) ? argv[1] : "../data/Klut";
+    // By default all subtables that the text tables can serve (<= 13 crossings).
+    const std::size_t c_max = (argc > 2)
+        ? static_cast<std::size_t>(std::atoi(argv[2]))
+        : Klut(data_dir, Klut::max_crossing_count, false).AvailableCrossingCount();
+
+    const fs::path table_dir =
+        fs::temp_directory_path() / ("klut_table_check_" + std::to_string(::getpid()));
+    fs::create_directories(table_dir);
+
+    // The text tables only; a stale Klut_Table_NN.bin in data_dir must not leak in.
+    Klut text(data_dir, c_max, false);
+
+    std::cout << "=== KLUT table files (c=3.." << c_max << ") ===\n";
+
+    std::size_t failures = 0;
+
+    for (std::size_t c = 3; c <= c_max; ++c)
+    {
+        if (!text.WriteTableFile(table_dir / ("Klut_Table_" +
+                Knoodle::StringWithLeadingZeroes(c, std::size_t(2)) + ".bin"), c))
+        {
+            std::cout << "c = " << c << ": FAIL (could not write table file)\n";
+            ++failures;
+        }
+    }
+
+    Klut table(table_dir, c_max);
+
+    for (std::size_t c = 3; c <= c_max; ++c)
+    {
+        const auto codes = text.SubtableCodes(c);
+        const auto names = text.SubtableNames(c);
+
+        std::size_t id_bad = 0, name_bad = 0, pack_bad = 0, batch_bad = 0;
+
+        const auto text_batch  = text.FindIDs(codes);
+        const auto table_batch = table.FindIDs(codes);
+
+        for (std::size_t j = 0; j < codes.Dim(0); ++j)
+        {
+            const Klut::Key_T key = Klut::MacLeodCodeToKey(codes.data(j), c);
+            std::array<Knoodle::UInt8, sizeof(Klut::Key_T)> packed{};
+            Klut::PackKey(key, c, packed.data());
+            if (Klut::UnpackKey(packed.data(), c) != key) { ++pack_bad; }
+
+            const auto a = text.FindID(codes.data(j), c);
+            const auto b = table.FindID(codes.data(j), c);
+
+            if (text_batch[j] != a || table_batch[j] != b) { ++batch_bad; }
+
+            if (a != b || b.second == Klut::not_found) { ++id_bad; continue; }
+
+            if (text.FindName(a) != table.FindName(b)) { ++name_bad; }
+        }
+
+        const bool counts_ok =
+            (table.SubtableIDs(c).Size() == text.SubtableIDs(c).Size()) &&
+            (table.SubtableNames(c) == names);
+
+        bool absent_ok = true;
+        if (codes.Dim(0) > 0)
+        {
+            Knoodle::Tensor1<CodeInt, std::size_t> code(codes.data(0), c);
+            code[0] = static_cast<CodeInt>(code[0] + 1);
+            absent_ok = (text.FindID(code.data(), c) == table.FindID(code.data(), c));
+        }
+
+        std::cout << "c = " << c << ": " << codes.Dim(0) << " keys, id mismatches: "
+                  << id_bad << ", name mismatches: " << name_bad
+                  << ", packing mismatches: " << pack_bad
+                  << ", batch mismatches: " << batch_bad
+                  << (counts_ok ? "" : ", COUNT MISMATCH")
+                  << (absent_ok ? "" : ", ABSENT-KEY MISMATCH") << "\n";
+
+        failures += id_bad + name_bad + pack_bad + batch_bad + !counts_ok + !absent_ok;
+    }
+
+    // (E) One batch across all subtables, interleaved, with absent keys mixed in.
+    {
+        std::vector<decltype(text.SubtableCodes(c_max))> batch_codes(c_max + 1);
+        for (std::size_t c = 3; c <= c_max; ++c) { batch_codes[c] = text.SubtableCodes(c); }
+
+        std::vector<Klut::Key_T> keys;
+
+        for (std::size_t j = 0; j < 1000; ++j)
+        {
+            bool any = false;
+            for (std::size_t c = 3; c <= c_max; ++c)
+            {
+                const auto& codes = batch_codes[c];
+                if (j >= codes.Dim(0)) { continue; }
+                any = true;
+                keys.push_back(Klut::MacLeodCodeToKey(codes.data(j), c));
+                if (j % 7 == 0)
+                {
+                    Klut::Key_T absent = keys.back();
+                    reinterpret_cast<CodeInt*>(absent.data())[0] ^= CodeInt(0x80);
+                    keys.push_back(absent);
+                }
+            }
+            if (!any) { break; }
+        }
+
+        std::size_t mismatches = 0;
+
+        for (const Klut* klut : {&text, &table})
+        {
+            std::vector<std::pair<std::size_t, Klut::ID_T>> result(keys.size());
+            klut->FindIDs(keys.data(), keys.size(), result.data());
+
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                std::array<CodeInt, Klut::max_crossing_count> code{};
+                Klut::KeyToMacLeodCode(keys[i], code.data());
+                const std::size_t c = Klut::MacLeodCodeLength(keys[i]);
+                if (result[i] != klut->FindID(code.data(), c)) { ++mismatches; }
+            }
+        }
+
+        std::cout << "mixed batch of " << keys.size() << " keys: batch mismatches: "
+                  << mismatches << "\n";
+
+        failures += mismatches;
+    }
+
+    // (D) One shared instance per mode, many threads, no RequireSubtables.
+    std::vector<decltype(text.SubtableCodes(c_max))> all_codes(c_max + 1);
+    for (std::size_t c = 3; c <= c_max; ++c) { all_codes[c] = text.SubtableCodes(c); }
+
+    for (const bool table_filesQ : {false, true})
+    {
+        const Klut shared(table_filesQ ? table_dir : data_dir, c_max, table_filesQ);
+
+        const std::size_t thread_count =
+            std::max(std::size_t(2), std::size_t(std::thread::hardware_concurrency()));
+
+        std::vector<std::size_t> bad(thread_count, 0);
+        std::vector<std::thread> threads;
+
+        for (std::size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                // Start at different subtables, so that several loads overlap.
+                for (std::size_t k = 0; k + 3 <= c_max; ++k)
+                {
+                    const std::size_t c = 3 + (k + t) % (c_max - 2);
+                    const auto& codes = all_codes[c];
+                    for (std::size_t j = t; j < codes.Dim(0); j += thread_count)
+                    {
+                        if (shared.FindID(codes.data(j), c) != text.FindID(codes.data(j), c))
+                        {
+                            ++bad[t];
+                        }
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) { thread.join(); }
+
+        std::size_t mismatches = 0;
+        for (const std::size_t b : bad) { mismatches += b; }
+
+        std::cout << (table_filesQ ? "table" : "text ") << " instance, " << thread_count
+                  << " threads: concurrent mismatches: " << mismatches << "\n";
+
+        failures += mismatches;
+    }
+
+    fs::remove_all(table_dir);
+
+    std::cout << "\nklut_table_check: " << (failures == 0 ? "PASS" : "FAIL")
+              << " (" << failures << " failures)\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -561,6 +561,7 @@ int main(int argc, char* argv[])
             std::filesystem::path(klut_dir), Knoodle::Klut::max_crossing_count);
         klut->LoadSubtables();                    // pre-load (single-threaded; no race)
         ki_params.cap = static_cast<ki::Size_T>(contract_cap);
+        ki_params.max_cx = static_cast<Int>(klut->AvailableCrossingCount());
     }
 
     std::mt19937_64 rng(static_cast<std::uint64_t>(seed));
@@ -678,7 +679,7 @@ int main(int argc, char* argv[])
                 //       the table, which is exactly the contract violation.
                 // Links are out of scope (the table is knots-only) and skipped.
                 bool contract_fail = false;
-                if (klut_on && !is_link && n <= static_cast<int>(klut->CrossingCount()))
+                if (klut_on && !is_link && n <= static_cast<int>(klut->AvailableCrossingCount()))
                 {
                     ki_work.Clear();
                     ki_work.Push(PD_T(pd));                 // copy; pd is still needed below
@@ -0,0 +1,202 @@
+// polyfold_resume_check — a PolyFold run that is killed and resumed with
+// --resume must leave the same code files as an uninterrupted run.
+//
+// For each configuration (synchronous output; asynchronous output with
+// pipelined analysis; a long burn-in with wrapped Gaussian angles and discrete
+// wrapped Gaussian pivots, whose distributions cache values between draws):
+//  (R) A reference run writes PDCodes.tsv, GaussCodes.txt, MacLeod.txt.
+//  (K) The same run, with checkpoints, is started in a child process and killed
+//      (SIGKILL): in the sampling configurations once it has written about half
+//      of the reference PD codes, in the burn-in configuration as soon as the
+//      first checkpoint exists, i.e., in the middle of the burn-in. Each code
+//      file must be a prefix of the reference file. Then some garbage is
+//      appended to each file, as if the killed run had written samples after
+//      its last checkpoint.
+//  (C) The run is resumed from Checkpoint.bin in the same directory. Each code
+//      file must now equal the reference file byte for byte: the interrupted
+//      run's contents up to the checkpoint, followed by the new samples. The
+//      interrupted log must survive as Info_Interrupted_1.m. In the burn-in
+//      configuration, the resumed log must report sample 0, so that the run
+//      really continued the burn-in from the checkpoint.
+// The seed is fixed through --pcg-*, so the chains are reproducible. Exit 0 = pass.
+//
+// Usage: ./polyfold_resume_check [edge_count] [sample_count]
+#include "../Knoodle.hpp"
+#include "../src/PolyFold.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using PolyFold_T = Knoodle::PolyFold<Knoodle::Real64, Knoodle::Int64, Knoodle::Int64, Knoodle::Real32>;
+
+namespace fs = std::filesystem;
+
+static const std::vector<std::string> kCodeFiles { "PDCodes.tsv", "GaussCodes.txt", "MacLeod.txt" };
+
+static std::string Slurp(const fs::path& file)
+{
+    std::ifstream in(file, std::ios::binary);
+    std::stringstream s;
+    s << in.rdbuf();
+    return s.str();
+}
+
+static void RunPolyFold(const std::vector<std::string>& args)
+{
+    std::vector<std::string> storage { "polyfold" };
+    storage.insert(storage.end(), args.begin(), args.end());
+
+    std::vector<char*> argv;
+    for (auto& a : storage) { argv.push_back(a.data()); }
+
+    PolyFold_T polyfold(static_cast<int>(argv.size()), argv.data());
+}
+
+int main(int argc, char** argv)
+{
+    const std::string edges   = (argc > 1) ? argv[1] : "48";
+    const std::string samples = (argc > 2) ? argv[2] : "2000";
+
+    // The default state of pcg64, spelled out so that the runs do not seed from the device.
+    std::string multiplier, increment, state;
+    {
+        std::stringstream s;
+        s << pcg64();
+        s >> multiplier >> increment >> state;
+    }
+
+    const fs::path root = fs::temp_directory_path() / ("polyfold_resume_check_" + std::to_string(::getpid()));
+    fs::create_directories(root);
+
+    struct Config_T
+    {
+        std::string              name;
+        std::string              burn_in;
+        std::string              checkpoint;   // seconds between checkpoints
+        bool                     burn_inQ;     // kill during the burn-in
+        std::vector<std::string> extra;
+    };
+
+    const std::vector<Config_T> configs {
+        { "sync",    "200",     "0",    false, {} },
+        { "async",   "200",     "0",    false, { "--async-output=true", "--analysis-threads=2" } },
+        { "burn-in", "4000000", "0.02", true,  { "--gaussian-angles=0.5", "--gaussian-pivots=4" } },
+    };
+
+    std::size_t failures = 0;
+
+    for (const auto& [name, burn_in, checkpoint, burn_inQ, extra] : configs)
+    {
+        std::vector<std::string> common {
+            "-n", edges, "-b", burn_in, "-s", "10", "-N", samples, "-c", "-G", "-M",
+            "--tally-unknots=false",
+            "--pcg-multiplier", multiplier, "--pcg-increment", increment, "--pcg-state", state
+        };
+        common.insert(common.end(), extra.begin(), extra.end());
+
+        // (R)
+        const fs::path ref_dir = root / (name + "_ref");
+        {
+            auto args = common;
+            args.insert(args.end(), { "-o", ref_dir.string() });
+            RunPolyFold(args);
+        }
+
+        const std::size_t ref_pd_size = fs::file_size(ref_dir / "PDCodes.tsv");
+
+        // (K)
+        const fs::path run_dir = root / (name + "_run");
+        auto run_args = common;
+        run_args.insert(run_args.end(), { "-o", run_dir.string(), "--checkpoint", checkpoint });
+
+        const pid_t child = ::fork();
+        if (child == 0)
+        {
+            if (!std::freopen("/dev/null", "w", stdout)) { ::_exit(2); }
+            try { RunPolyFold(run_args); } catch (...) { ::_exit(1); }
+            ::_exit(0);
+        }
+
+        bool killedQ = false;
+        for (;;)
+        {
+            int status = 0;
+            if (::waitpid(child, &status, WNOHANG) == child) { break; }
+
+            std::error_code ec;
+            const auto size = fs::file_size(run_dir / "PDCodes.tsv", ec);
+            const bool dueQ = burn_inQ || (!ec && (2 * size >= ref_pd_size));
+            if (dueQ && fs::exists(run_dir / "Checkpoint.bin"))
+            {
+                ::kill(child, SIGKILL);
+                ::waitpid(child, &status, 0);
+                killedQ = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        std::size_t prefix_bad = 0;
+        for (const auto& file : kCodeFiles)
+        {
+            const std::string got = Slurp(run_dir / file);
+            const std::string ref = Slurp(ref_dir / file);
+            if (ref.compare(0, got.size(), got) != 0 || got.size() > ref.size()) { ++prefix_bad; }
+
+            std::ofstream(run_dir / file, std::ios::app) << "garbage written after the checkpoint\n";
+        }
+
+        // (C)
+        {
+            auto args = run_args;
+            args.insert(args.end(), { "--resume", (run_dir / "Checkpoint.bin").string() });
+            RunPolyFold(args);
+        }
+
+        std::size_t final_bad = 0;
+        for (const auto& file : kCodeFiles)
+        {
+            if (Slurp(run_dir / file) != Slurp(ref_dir / file))
+            {
+                ++final_bad;
+                std::cout << "FAIL: " << name << ": " << file << " differs from the reference after resuming\n";
+            }
+        }
+
+        const bool logQ = fs::exists(run_dir / "Info_Interrupted_1.m") && fs::exists(run_dir / "Info.m");
+
+        // The resumed log reports where the checkpoint was taken.
+        bool mid_burn_inQ = false;
+        if (burn_inQ)
+        {
+            const std::string info = Slurp(run_dir / "Info.m");
+            const std::size_t pos  = info.find("\"Resumed\"");
+            mid_burn_inQ = (pos != std::string::npos) && (info.find("\"Sample\" -> 0", pos) != std::string::npos);
+        }
+        const bool phaseQ = !burn_inQ || mid_burn_inQ;
+
+        std::cout << name << ": " << (killedQ ? "killed" : "finished before the kill, resumed from the last checkpoint")
+                  << ", prefix mismatches: " << prefix_bad << ", final mismatches: " << final_bad
+                  << (logQ ? "" : ", INTERRUPTED LOG MISSING")
+                  << (phaseQ ? "" : ", NOT RESUMED DURING THE BURN-IN") << "\n";
+
+        failures += prefix_bad + final_bad + !logQ + !phaseQ;
+    }
+
+    fs::remove_all(root);
+
+    std::cout << "polyfold_resume_check: " << (failures == 0 ? "PASS" : "FAIL")
+              << " (" << failures << " failures)\n";
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+#pragma once
+// Adaptive Reapr-escalation schedule for klut_identify::IdentifyInto.
+//
+// Without a profile, IdentifyInto escalates a stalled candidate with a fixed
+// schedule: embedding_trials n0, 2*n0, 4*n0, ... and `rot` reprojections per
+// embedding. That schedule was tuned once on klut_bench; it is blind to how
+// hard the stalled diagram is. With a profile, every escalation step is one of
+// a few (embedding_trials, rotation_trials) options, and the profile records
+// per (stalled crossing count, round, option) how often the step resolved the
+// candidate and how many seconds it took. The next step is the option with the
+// best resolutions per second in that cell, i.e., the step that maximizes the
+// identification rate per CPU-second.
+//
+// Exploration: a cell only trusts options with at least `min_trials`
+// observations; until then it falls back to the fixed schedule's step, and
+// with probability `explore` it tries an option uniformly at random instead,
+// so the alternatives get observed at all. The exploration draws come from the
+// profile's own engine (seeded in the constructor), not from the Reapr engine of
+// the caller; so a profile does not shift the random embeddings of Reapr. That
+// is all the seed buys: the choices are not reproducible. Once a cell trusts
+// its options, it ranks them by measured wall-clock seconds, and with several
+// workers the order in which they draw from the shared engine depends on the
+// timing of the threads.
+// "Resolved" means what ends the
+// escalation loop in IdentifyInto with an answer: the table knot was found,
+// the candidate split into summands, or it reduced to the unknot.
+//
+// Persistence: Load merges a profile file into the counts, Save writes all
+// observed cells. The format is TSV, one cell per line:
+//   crossings  round  embedding_trials  rotation_trials  attempts  resolved  seconds
+// so profiles from several runs (or machines) can be concatenated.
+//
+// Concurrency: the counts are relaxed atomics, so one profile can be shared by
+// all identify workers; a step choice may see slightly stale counts. The engine
+// is guarded by a mutex.
+
+#include "../Knoodle.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace klut_identify {
+
+class EscalationProfile
+{
+public:
+
+    using Int    = std::int64_t;
+    using Size_T = Knoodle::Size_T;
+
+    struct Step
+    {
+        Size_T embedding_trials = 1;
+        Size_T rotation_trials  = 5;
+    };
+
+    static constexpr std::array<Size_T, 7> embedding_options { 1, 2, 4, 8, 16, 32, 64 };
+    static constexpr std::array<Size_T, 3> rotation_options  { 1, 5, 10 };
+
+    static constexpr Size_T option_count   = embedding_options.size() * rotation_options.size();
+    static constexpr Int    crossing_limit = 64;   // stalled diagrams above share the last cell
+    static constexpr Size_T round_limit    = 16;   // rounds above share the last cell
+
+    static constexpr std::uint64_t default_seed = 20260715;
+
+    explicit EscalationProfile(double explore = 0.05, Size_T min_trials = 8,
+                               std::uint64_t seed = default_seed)
+    :   explore_    (explore)
+    ,   min_trials_ (std::max(min_trials, Size_T(1)))
+    ,   cells_      (std::make_unique<Cell[]>(CellCount()))
+    ,   rng_        (seed)
+    {}
+
+    EscalationProfile(const EscalationProfile&)            = delete;
+    EscalationProfile& operator=(const EscalationProfile&) = delete;
+
+    // The step for round `round` on a stalled diagram with `crossings` crossings.
+    // `fallback` is what the fixed schedule would do.
+    Step Choose(Int crossings, Size_T round, Step fallback) const
+    {
+        {
+            const std::lock_guard<std::mutex> lock(rng_mutex_);
+            if( std::uniform_real_distribution<double>(0, 1)(rng_) < explore_ )
+            {
+                return OptionStep(std::uniform_int_distribution<Size_T>(0, option_count - 1)(rng_));
+            }
+        }
+
+        Step   best      = fallback;
+        double best_rate = -1;
+
+        for( Size_T o = 0; o < option_count; ++o )
+        {
+            const Cell& cell = cells_[Index(crossings, round, o)];
+            const double n = static_cast<double>(cell.attempts.load(std::memory_order_relaxed));
+            if( n < static_cast<double>(min_trials_) ) { continue; }
+
+            const double s = static_cast<double>(cell.resolved.load(std::memory_order_relaxed));
+            const double t = 1e-9 * static_cast<double>(cell.nanoseconds.load(std::memory_order_relaxed));
+            // Resolutions per second, with the success rate shrunk towards 1/2
+            // so that a lucky streak on few trials does not dominate.
+            const double rate = ((s + 1) / (n + 2)) / std::max(t / n, 1e-9);
+
+            if( rate > best_rate ) { best_rate = rate; best = OptionStep(o); }
+        }
+        return best;
+    }
+
+    // Records the outcome of a step chosen by Choose (or any step on the grid;
+    // others are attributed to the nearest option).
+    void Record(Int crossings, Size_T round, Step step, bool resolvedQ, double seconds)
+    {
+        Cell& cell = cells_[Index(crossings, round, OptionOf(step))];
+        cell.attempts.fetch_add(1, std::memory_order_relaxed);
+        if( resolvedQ ) { cell.resolved.fetch_add(1, std::memory_order_relaxed); }
+        cell.nanoseconds.fetch_add(static_cast<std::uint64_t>(std::max(seconds, 0.0) * 1e9),
+                                   std::memory_order_relaxed);
+    }
+
+    // Merges the counts in `path` into this profile. false if the file cannot
+    // be read; malformed lines are skipped.
+    bool Load(const std::string& path)
+    {
+        std::ifstream in(path);
+        if( !in ) { return false; }
+
+        std::string line;
+        while( std::getline(in, line) )
+        {
+            if( line.empty() || line[0] == '#' ) { continue; }
+            std::istringstream fields(line);
+            Int c = 0; Size_T r = 0, e = 0, rot = 0, n = 0, s = 0; double t = 0;
+            if( !(fields >> c >> r >> e >> rot >> n >> s >> t) || s > n || t < 0 ) { continue; }
+
+            Cell& cell = cells_[Index(c, r, OptionOf(Step{e, rot}))];
+            cell.attempts.fetch_add(n, std::memory_order_relaxed);
+            cell.resolved.fetch_add(s, std::memory_order_relaxed);
+            cell.nanoseconds.fetch_add(static_cast<std::uint64_t>(t * 1e9), std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Writes all observed cells to `path` (through a temporary file, so an
+    // interrupted write does not destroy the previous profile).
+    bool Save(const std::string& path) const
+    {
+        const std::string temp_path = path + ".tmp";
+        {
+            std::ofstream out(temp_path);
+            if( !out ) { return false; }
+            out << "# klut_identify escalation profile v1\n"
+                << "# crossings\tround\tembedding_trials\trotation_trials\tattempts\tresolved\tseconds\n";
+            out.precision(9);
+            for( Int c = 0; c <= crossing_limit; ++c )
+            {
+                for( Size_T r = 0; r < round_limit; ++r )
+                {
+                    for( Size_T o = 0; o < option_count; ++o )
+                    {
+                        const Cell& cell = cells_[Index(c, r, o)];
+                        const std::uint64_t n = cell.attempts.load(std::memory_order_relaxed);
+                        if( n == 0 ) { continue; }
+                        const Step step = OptionStep(o);
+                        out << c << '\t' << r << '\t' << step.embedding_trials << '\t'
+                            << step.rotation_trials << '\t' << n << '\t'
+                            << cell.resolved.load(std::memory_order_relaxed) << '\t'
+                            << 1e-9 * static_cast<double>(cell.nanoseconds.load(std::memory_order_relaxed))
+                            << '\n';
+                    }
+                }
+            }
+            if( !out ) { return false; }
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp_path, path, ec);
+        return !ec;
+    }
+
+    // Total recorded steps and resolutions (for summaries).
+    std::pair<std::uint64_t, std::uint64_t> Totals() const
+    {
+        std::uint64_t n = 0, s = 0;
+        for( Size_T i = 0; i < CellCount(); ++i )
+        {
+            n += cells_[i].attempts.load(std::memory_order_relaxed);
+            s += cells_[i].resolved.load(std::memory_order_relaxed);
+        }
+        return {n, s};
+    }
+
+private:
+
+    struct Cell
+    {
+        std::atomic<std::uint64_t> attempts    = 0;
+        std::atomic<std::uint64_t> resolved    = 0;
+        std::atomic<std::uint64_t> nanoseconds = 0;
+    };
+
+    static constexpr Size_T CellCount()
+    {
+        return static_cast<Size_T>(crossing_limit + 1) * round_limit * option_count;
+    }
+
+    static Size_T Index(Int crossings, Size_T round, Size_T option)
+    {
+        const Size_T c = static_cast<Size_T>(std::clamp(crossings, Int(0), crossing_limit));
+        const Size_T r = std::min(round, round_limit - 1);
+        return (c * round_limit + r) * option_count + option;
+    }
+
+    static Step OptionStep(Size_T option)
+    {
+        return Step{ embedding_options[option / rotation_options.size()],
+                     rotation_options [option % rotation_options.size()] };
+    }
+
+    // The grid option nearest to `step`: embedding trials by log distance,
+    // rotation trials by distance.
+    static Size_T OptionOf(Step step)
+    {
+        auto nearest = [](const auto& options, double x, auto dist) {
+            Size_T best = 0;
+            for( Size_T i = 1; i < options.size(); ++i )
+            {
+                if( dist(static_cast<double>(options[i]), x) < dist(static_cast<double>(options[best]), x) ) { best = i; }
+            }
+            return best;
+        };
+        const Size_T e = nearest(embedding_options, static_cast<double>(std::max(step.embedding_trials, Size_T(1))),
+                                 [](double a, double b) { return std::abs(std::log2(a) - std::log2(b)); });
+        const Size_T r = nearest(rotation_options, static_cast<double>(step.rotation_trials),
+                                 [](double a, double b) { return std::abs(a - b); });
+        return e * rotation_options.size() + r;
+    }
+
+    double                  explore_;
+    Size_T                  min_trials_;
+    std::unique_ptr<Cell[]> cells_;
+
+    // Exploration draws only; separate from the callers' engines.
+    mutable std::mutex      rng_mutex_;
+    mutable Knoodle::PRNG_T rng_;
+};
+
+} // namespace klut_identify
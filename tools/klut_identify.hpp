@@ -7,10 +7,14 @@
 // The protocol: decompose the input into prime candidates (pass-only Simplify,
 // canonicalize OFF — the hot-path optimization, verified safe), look each up; if
 // not found, escalate Reapr (which also splits any under-decomposed composite).
-// Reapr is reused across calls. Lookups are reentrant (own buffer) so the routine
-// is thread-safe given a per-thread Reapr.
+// Reapr is reused across calls. Lookups go through the const, reentrant Klut
+// query API (stack scratch, once-flag lazy loading), so the routine is
+// thread-safe given a per-thread Reapr; all threads can share one Klut.
 #include "../Knoodle.hpp"
+#include "klut_escalation_profile.hpp"
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <utility>
 #include <vector>
@@ -22,6 +26,7 @@ using Real    = double;
 using PDC_T   = Knoodle::PlanarDiagramComplex<Int>;
 using PD_T    = PDC_T::PD_T;
 using Reapr_T = Knoodle::Reapr<Real, Int, float>;
+using Workspace_T = PDC_T::Workspace_T;
 using Klut    = Knoodle::Klut;
 using Code    = Klut::CodeInt;
 using Size_T  = Knoodle::Size_T;
@@ -38,15 +43,16 @@ struct IdentifyParams
                           // them at ~cap=2 cost.)
     Size_T base   = 2;    // escalation rounds always run, regardless of size
                           // (= the old tuned cap)
-    Int    deep_cx = static_cast<Int>(Klut::max_crossing_count) + Int(3);
+    Int    deep_cx = static_cast<Int>(Klut::max_text_crossing_count) + Int(3);
                           // rounds base..cap run only while the current stalled
                           // diagram has <= deep_cx crossings: a fixpoint close
                           // to table range plausibly hides a table knot (every
-                          // recovered production miss stalled at 12-15); one
-                          // far above it does not.
+                          // recovered production miss stalled at 12-15 with the
+                          // 13-crossing tables); one far above it does not.
     Size_T rot    = 5;    // rotation_trials (reprojections) per embedding during escalation
                           // (tuned via klut_bench: ~all of rot=1's speed, 5x the margin)
-    Int    max_cx = static_cast<Int>(Klut::max_crossing_count);  // 13
+    Int    max_cx = static_cast<Int>(Klut::max_crossing_count);  // 16; clamped to the
+                          // subtables `table` actually has (Klut::AvailableCrossingCount)
 
     // Experimental seed-Simplify knobs, kept for benchmarking (klut_bench's
     // --seed-local-opt / --seed-reroute). Defaults reproduce the tuned hot path
@@ -61,6 +67,13 @@ struct IdentifyParams
                                 // 2=R1+R2, 4=all local patterns.
     bool   seed_reroute = true; // rerouteQ for the seed. false + seed_local_opt>0 = a
                                 // local-only seed (no Dijkstra reroute).
+
+    // Adaptive escalation (klut_escalation_profile.hpp): if set, each round's
+    // (embedding_trials, rotation_trials) is chosen by the profile, and every
+    // round's outcome and time are recorded in it. Rounds, base/deep_cx banding
+    // and cap are unchanged; n0/rot become the profile's fallback step. Null =
+    // the fixed doubling schedule.
+    EscalationProfile* profile = nullptr;
 };
 
 struct Summand
@@ -92,7 +105,7 @@ namespace detail
     // local buffer and probe the table. {crossings, id}; not_found unless D is a
     // single-component knot with 3..max_cx crossings whose code is a key.
     inline std::pair<Int, Klut::ID_T>
-    Lookup(Klut& table, const PD_T& D, Int max_cx)
+    Lookup(const Klut& table, const PD_T& D, Int max_cx)
     {
         if( !D.ValidQ() || D.LinkComponentCount() != Int(1) ) { return {Int(0), Klut::not_found}; }
         const Int c = D.CrossingCount();
@@ -112,12 +125,20 @@ namespace detail
 // move between `work` and the one-candidate scratch `temp` via Pop()/Push() (no
 // copies); `temp` holds exactly one candidate at a time and is Simplified in
 // place during escalation. On return `work` and `temp` are empty (ready to reuse).
+// `workspace` (may be null) is the caller's Simplify scratch: with it, the
+// PassSimplifier buffers survive across the seed, every escalation round and
+// every call, instead of being reallocated whenever a Simplify canonicalizes.
+// Like work/temp it is per thread.
 inline void
-IdentifyInto(Klut& table, PDC_T& work, PDC_T& temp, Reapr_T& reapr,
-             IdentifyResult& R, IdentifyParams q = {})
+IdentifyInto(const Klut& table, PDC_T& work, PDC_T& temp, Reapr_T& reapr,
+             Workspace_T* workspace, IdentifyResult& R, IdentifyParams q = {})
 {
     using detail::Found; using detail::Lookup;
 
+    auto simplify = [&reapr, workspace](PDC_T& P, const PDC_T::Simplify_Args_T& a) {
+        if( workspace ) { P.Simplify(reapr, *workspace, a); } else { P.Simplify(reapr, a); }
+    };
+
     R.summands.clear();                            // keep the vector's capacity
     R.status          = IdentifyResult::Status::Knot;
     R.component_error = false;
@@ -147,6 +168,9 @@ IdentifyInto(Klut& table, PDC_T& work, PDC_T& temp, Reapr_T& reapr,
     if( work.ColorCount() != Int(1) )              // a link (or multi-component) -> out of scope
     { R.status = IdentifyResult::Status::LinkOutOfScope; work.Clear(); return; }
 
+    // Above the available subtables a miss is Unidentified, not NotFound/Error.
+    q.max_cx = std::min(q.max_cx, static_cast<Int>(table.AvailableCrossingCount()));
+
     // Seed: pass-only decomposition, canonicalize OFF (hot path).
     {
         PDC_T::Simplify_Args_T a{};
@@ -154,7 +178,7 @@ IdentifyInto(Klut& table, PDC_T& work, PDC_T& temp, Reapr_T& reapr,
         a.canonicalizeQ    = false;
         a.local_opt_level  = static_cast<Knoodle::UInt8>(q.seed_local_opt);  // default 0: no-op
         a.rerouteQ         = q.seed_reroute;                                 // default true: no-op
-        work.Simplify(reapr, a);
+        simplify(work, a);
         if( work.ColorCount() != Int(1) ) { R.component_error = true; }  // pass-reduce must preserve components
     }
 
@@ -196,23 +220,41 @@ IdentifyInto(Klut& table, PDC_T& work, PDC_T& temp, Reapr_T& reapr,
             if( att >= q.base
                 && temp.Diagram(0).CrossingCount() > q.deep_cx ) { break; }
 
+            // The fixed schedule's step, or the profile's pick for this stalled size and round.
+            const Int stalled_cx = temp.Diagram(0).CrossingCount();
+            EscalationProfile::Step step{ n, q.rot };
+            if( q.profile ) { step = q.profile->Choose(stalled_cx, att, step); }
+
             PDC_T::Simplify_Args_T a{};
-            a.embedding_trials = n;                // escalation: canonicalize default (immaterial; Reapr swamps)
-            a.rotation_trials  = q.rot;            // reprojections per embedding (tunable)
+            a.embedding_trials = step.embedding_trials;  // escalation: canonicalize default (immaterial; Reapr swamps)
+            a.rotation_trials  = step.rotation_trials;   // reprojections per embedding (tunable)
             ++R.reapr_calls;
-            temp.Simplify(reapr, a);
+            const auto t0 = q.profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+            simplify(temp, a);
 
+            bool resolved = false;
             if( temp.ColorCount() != Int(1) )      // Simplify changed component count -> bug
-            { R.component_error = true; done = true; break; }
-
-            if( temp.DiagramCount() > Int(1) )     // composite revealed -> requeue the pieces (MOVE)
-            { while( temp.DiagramCount() > Int(0) ) { work.Push( temp.Pop() ); } done = true; break; }
+            { R.component_error = true; done = true; }
+            else if( temp.DiagramCount() > Int(1) )  // composite revealed -> requeue the pieces (MOVE)
+            { while( temp.DiagramCount() > Int(0) ) { work.Push( temp.Pop() ); } done = resolved = true; }
+            else
+            {
+                const PD_T& D = temp.Diagram(0);
+                if( D.CrossingCount() == Int(0) ) { done = resolved = true; }   // reduced away -> drop
+                else
+                {
+                    auto [c, id] = Lookup(table, D, q.max_cx);
+                    if( Found(id) ) { R.summands.push_back(Summand{Summand::Kind::Identified, id, c, {}}); done = resolved = true; }
+                }
+            }
 
-            const PD_T& D = temp.Diagram(0);
-            if( D.CrossingCount() == Int(0) ) { done = true; break; }   // reduced away -> drop
-            auto [c, id] = Lookup(table, D, q.max_cx);
-            if( Found(id) ) { R.summands.push_back(Summand{Summand::Kind::Identified, id, c, {}}); done = true; break; }
-            if( n < Size_T(64) ) { n *= Size_T(2); }  // escalate (schedule to be tuned via klut_bench)
+            if( q.profile )
+            {
+                const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+                q.profile->Record(stalled_cx, att, step, resolved, dt.count());
+            }
+            if( done ) { break; }
+            if( n < Size_T(64) ) { n *= Size_T(2); }  // fixed schedule: double (the profile's fallback)
         }
         if( done ) { temp.Clear(); continue; }
 
@@ -222,11 +264,18 @@ IdentifyInto(Klut& table, PDC_T& work, PDC_T& temp, Reapr_T& reapr,
     }
 }
 
+inline void
+IdentifyInto(const Klut& table, PDC_T& work, PDC_T& temp, Reapr_T& reapr,
+             IdentifyResult& R, IdentifyParams q = {})
+{
+    IdentifyInto(table, work, temp, reapr, nullptr, R, q);
+}
+
 // Signature 1: caller supplies (and tunes) the Reapr. Owning convenience wrapper
 // over IdentifyInto -- allocates fresh scratch per call. Use IdentifyInto in a
 // firehose loop to reuse scratch across calls.
 inline IdentifyResult
-Identify(Klut& table, PDC_T P, Reapr_T& reapr, IdentifyParams q = {})
+Identify(const Klut& table, PDC_T P, Reapr_T& reapr, IdentifyParams q = {})
 {
     IdentifyResult R;
     PDC_T work = std::move(P);
@@ -237,7 +286,7 @@ Identify(Klut& table, PDC_T P, Reapr_T& reapr, IdentifyParams q = {})
 
 // Signature 2: build a Reapr with our tuned defaults (settled via klut_bench).
 inline IdentifyResult
-Identify(Klut& table, PDC_T P, IdentifyParams q = {})
+Identify(const Klut& table, PDC_T P, IdentifyParams q = {})
 {
     Reapr_T reapr{};   // TODO: plug in tuned Reapr settings once the klut_bench sweep is done
     return Identify(table, std::move(P), reapr, q);
@@ -0,0 +1,247 @@
+#pragma once
+// Result cache in front of klut_identify::IdentifyInto.
+//
+// Polygon samplers produce the same few small knots over and over, and every
+// identification redoes the pass-simplification (and Reapr escalation, and the
+// MacLeod lookup) from scratch. The cache short-circuits that: the key is the
+// MacLeod code of the RAW input diagram (canonical under relabeling, so two
+// samples that give the same diagram give the same key), the value is the
+// final IdentifyResult. A warm hit costs one MacLeod code and one hash probe.
+//
+// What is cached: only results that are facts about the knot type, i.e. every
+// summand Identified (or none: the unknot) and no component error. Unidentified
+// and Error summands depend on the Reapr's luck and are not replayed.
+//
+// What is keyed: single-diagram, single-component, valid inputs with 1 to
+// `max_crossings` crossings. Everything else (links, pre-split summands, huge
+// diagrams that will not repeat anyway) bypasses the cache.
+//
+// Concurrency: the table is split into shards by key hash, each with its own
+// mutex, own CLOCK ring (a reference bit per entry, second-chance eviction) and
+// its share of the capacity. Counters are atomics; GetCounts() is a snapshot.
+#include "klut_identify.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace klut_identify {
+
+class ResultCache
+{
+public:
+
+    // MacLeod entries are 8 * crossings - 1 at most; 16 bits cover any
+    // diagram up to 8191 crossings, far above any sensible `max_crossings`.
+    using KeyInt = std::uint16_t;
+    using Key    = std::vector<KeyInt>;
+
+    struct Counts
+    {
+        std::size_t hits      = 0;
+        std::size_t misses    = 0;
+        std::size_t inserts   = 0;
+        std::size_t evictions = 0;
+        std::size_t bypasses  = 0;   // inputs that were not keyed at all
+    };
+
+    explicit ResultCache(std::size_t capacity, Int max_crossings = Int(64),
+                         std::size_t shard_count = 16)
+    :   max_crossings_(std::min(max_crossings, Int(8191)))
+    {
+        shard_count = std::max(std::size_t(1), std::min(shard_count, capacity));
+        for( std::size_t s = 0; s < shard_count; ++s )
+        {
+            // Spread the capacity; the first shards take the remainder.
+            const std::size_t cap = capacity / shard_count + (s < capacity % shard_count);
+            shards_.push_back(std::make_unique<Shard>(cap));
+        }
+    }
+
+    ResultCache(const ResultCache&)            = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    Int MaxCrossings() const { return max_crossings_; }
+
+    // Writes the key of the input complex `P` into `key` (capacity reused).
+    // false if `P` is not cacheable, see above.
+    bool Fingerprint(const PDC_T& P, Key& key) const
+    {
+        if( P.DiagramCount() != Int(1) ) { return false; }
+        const PD_T& D = P.Diagram(0);
+        if( !D.ValidQ() || D.LinkComponentCount() != Int(1) ) { return false; }
+        const Int c = D.CrossingCount();
+        if( c < Int(1) || c > max_crossings_ ) { return false; }
+        key.resize(static_cast<std::size_t>(c));
+        D.template WriteMacLeodCode<KeyInt>(key.data());
+        return true;
+    }
+
+    // A result that may be replayed for any diagram of the same knot type.
+    static bool CacheableQ(const IdentifyResult& R)
+    {
+        if( R.status != IdentifyResult::Status::Knot || R.component_error ) { return false; }
+        for( const Summand& s : R.summands )
+        {
+            if( s.kind != Summand::Kind::Identified ) { return false; }
+        }
+        return true;
+    }
+
+    // On a hit, copies the cached result into `R` (its capacity reused).
+    bool Lookup(const Key& key, IdentifyResult& R)
+    {
+        const std::size_t h = Hash(key);
+        Shard& sh = ShardOf(h);
+        {
+            const std::lock_guard<std::mutex> lock(sh.mutex);
+            auto it = sh.index.find(key);
+            if( it != sh.index.end() )
+            {
+                Entry& e = sh.ring[it->second];
+                e.referencedQ = true;
+                R.status          = e.result.status;
+                R.summands        = e.result.summands;
+                R.component_error = false;
+                R.reapr_calls     = Size_T(0);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void Insert(const Key& key, const IdentifyResult& R)
+    {
+        Shard& sh = ShardOf(Hash(key));
+        if( sh.capacity == 0 ) { return; }
+
+        const std::lock_guard<std::mutex> lock(sh.mutex);
+        if( sh.index.contains(key) ) { return; }   // another worker was first
+
+        std::size_t slot;
+        if( sh.ring.size() < sh.capacity )
+        {
+            slot = sh.ring.size();
+            sh.ring.emplace_back();
+        }
+        else
+        {
+            // CLOCK: clear reference bits until an unreferenced entry comes up.
+            while( sh.ring[sh.hand].referencedQ )
+            {
+                sh.ring[sh.hand].referencedQ = false;
+                sh.hand = (sh.hand + 1) % sh.capacity;
+            }
+            slot = sh.hand;
+            sh.hand = (sh.hand + 1) % sh.capacity;
+            sh.index.erase(sh.ring[slot].key);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Entry& e = sh.ring[slot];
+        e.key         = key;
+        e.result      = R;
+        e.referencedQ = false;
+        sh.index.emplace(e.key, slot);
+        inserts_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void CountBypass() { bypasses_.fetch_add(1, std::memory_order_relaxed); }
+
+    Counts GetCounts() const
+    {
+        return Counts{
+            hits_.load(std::memory_order_relaxed),
+            misses_.load(std::memory_order_relaxed),
+            inserts_.load(std::memory_order_relaxed),
+            evictions_.load(std::memory_order_relaxed),
+            bypasses_.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+
+    struct Entry
+    {
+        Key            key;
+        IdentifyResult result;
+        bool           referencedQ = false;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const { return Hash(key); }
+    };
+
+    struct Shard
+    {
+        explicit Shard(std::size_t cap) : capacity(cap) {}
+
+        std::mutex                                      mutex;
+        std::size_t                                     capacity;
+        std::size_t                                     hand = 0;
+        std::vector<Entry>                              ring;
+        std::unordered_map<Key, std::size_t, KeyHash>   index;
+    };
+
+    // FNV-1a over the code entries, then a splitmix finalizer, so that the
+    // shard choice and the bucket within the shard both see well-mixed bits.
+    static std::size_t Hash(const Key& key)
+    {
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        for( const KeyInt k : key ) { h = (h ^ k) * 0x100000001b3ULL; }
+        h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return static_cast<std::size_t>(h);
+    }
+
+    Shard& ShardOf(std::size_t h) { return *shards_[(h >> 7) % shards_.size()]; }
+
+    Int                                 max_crossings_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<std::size_t> hits_      = 0;
+    std::atomic<std::size_t> misses_    = 0;
+    std::atomic<std::size_t> inserts_   = 0;
+    std::atomic<std::size_t> evictions_ = 0;
+    std::atomic<std::size_t> bypasses_  = 0;
+};
+
+// IdentifyInto behind `cache` (may be null: plain IdentifyInto). `key` is the
+// caller's scratch for the fingerprint, reused across calls like work/temp and
+// `workspace` (may be null, see IdentifyInto). On a hit `work` is cleared and
+// R.reapr_calls is 0.
+inline void
+IdentifyCachedInto(const Klut& table, ResultCache* cache, PDC_T& work, PDC_T& temp,
+                   Reapr_T& reapr, Workspace_T* workspace, ResultCache::Key& key,
+                   IdentifyResult& R, IdentifyParams q = {})
+{
+    if( !cache ) { IdentifyInto(table, work, temp, reapr, workspace, R, q); return; }
+
+    if( !cache->Fingerprint(work, key) )
+    {
+        cache->CountBypass();
+        IdentifyInto(table, work, temp, reapr, workspace, R, q);
+        return;
+    }
+
+    if( cache->Lookup(key, R) )
+    {
+        work.Unlock();
+        work.Clear();
+        return;
+    }
+
+    IdentifyInto(table, work, temp, reapr, workspace, R, q);
+
+    if( ResultCache::CacheableQ(R) ) { cache->Insert(key, R); }
+}
+
+} // namespace klut_identify
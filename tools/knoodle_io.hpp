@@ -18,6 +18,7 @@
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <streambuf>
 #include <system_error>
 #include <utility>
@@ -56,7 +57,7 @@ using PD_T        = PDC_T::PD_T;
 using OrthoDraw_T = Knoodle::OrthoDraw<PD_T>;
 using Energy_T    = PDC_T::Energy_T;
 using LinkEmb_T   = Knoodle::LinkEmbedding<Real, Int, float>;
-using Reapr_T     = Knoodle::Reapr<Real, Int, float>;  // only used for RandomRotation()
+using Reapr_T     = Knoodle::Reapr<Real, Int, float>;  // == PDC_T::Reapr_T
 
 // The timing aliases live in a named namespace rather than at global scope.
 // Apple's <MacTypes.h> (pulled in transitively by <Accelerate/Accelerate.h>,
@@ -157,6 +158,10 @@ std::ofstream g_log_file;
 /// streaming mode actually opened one.
 std::filesystem::path g_log_path;
 
+/// Serializes Log/LogError, so messages from a reader thread and the writer
+/// (--threads mode) never interleave mid-line.
+std::mutex g_log_mutex;
+
 //==============================================================================
 // Error detection (fail loudly rather than emit silently-wrong output)
 //==============================================================================
@@ -176,12 +181,19 @@ std::filesystem::path g_log_path;
 // There is no error counter in Tools to query, and eprint() is not a hook we can
 // register with, but it does write every message to std::cerr with a fixed
 // "ERROR: " prefix. So we tap std::cerr, pass everything through untouched, and
-// count matching lines. Tools serializes its own prints behind cerr_mutex, so
-// the counting stays coherent for library output; our own LogError bumps the
-// counter directly, since in streaming mode it goes to the log file, not cerr.
+// count matching lines. Tools serializes its own prints behind cerr_mutex, but
+// our own messages do not take that mutex, so the tap locks its own and keeps
+// the partial line per thread; with --threads, library errors arrive from
+// several workers at once. Our own LogError bumps the counter directly, since
+// in streaming mode it goes to the log file, not cerr.
 
 /// Number of errors reported by this tool's own LogError.
-long g_tool_error_count = 0;
+std::atomic<long> g_tool_error_count = 0;
+
+/// Number of errors (library + tool) reported by the calling thread. With
+/// --threads, other workers report errors at the same time; this count tells
+/// which of them belong to the work of this thread.
+thread_local long g_thread_error_count = 0;
 
 /// Counts "ERROR: " lines written to std::cerr (i.e. Tools' eprint) while
 /// forwarding every byte to the original stream. RAII: restores cerr on scope
@@ -203,7 +215,7 @@ public:
     CerrErrorTap(const CerrErrorTap&)            = delete;
     CerrErrorTap& operator=(const CerrErrorTap&) = delete;
 
-    long Count() const { return buf_.errors; }
+    long Count() const { return buf_.errors.load(std::memory_order_relaxed); }
 
     /// The error lines themselves, for the diagnostic report (bounded, so a
     /// pathological run cannot eat memory).
@@ -214,8 +226,8 @@ private:
     {
     public:
         std::streambuf*          sink   = nullptr;
-        long                     errors = 0;
-        std::vector<std::string> messages;
+        std::atomic<long>        errors = 0;
+        std::vector<std::string> messages;   // guarded by mutex_
 
         static constexpr std::size_t max_messages   = 50;
         static constexpr std::size_t max_line_bytes = 2000;
@@ -224,6 +236,7 @@ private:
         int overflow(int c) override
         {
             if (c == traits_type::eof()) { return traits_type::not_eof(c); }
+            const std::lock_guard<std::mutex> lock(mutex_);
             const char ch = static_cast<char>(c);
             if (sink) { sink->sputc(ch); }
             if (ch == '\n')
@@ -231,6 +244,7 @@ private:
                 if (line_.starts_with("ERROR:"))
                 {
                     ++errors;
+                    ++g_thread_error_count;
                     if (messages.size() < max_messages) { messages.push_back(line_); }
                 }
                 line_.clear();
@@ -244,10 +258,18 @@ private:
             return c;
         }
 
-        int sync() override { return sink ? sink->pubsync() : 0; }
+        int sync() override
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            return sink ? sink->pubsync() : 0;
+        }
 
     private:
-        std::string line_;
+        std::mutex mutex_;
+
+        // The line being assembled is per thread, so concurrent writers cannot
+        // splice their lines into one another (there is only one tap).
+        static inline thread_local std::string line_;
     };
 
     Buf buf_;
@@ -260,10 +282,18 @@ CerrErrorTap* g_cerr_tap = nullptr;
 /// unit and compare after, to decide whether that unit is trustworthy.
 [[maybe_unused]] long ErrorTotal()
 {
-    return g_tool_error_count
+    return g_tool_error_count.load()
          + ((g_cerr_tap != nullptr) ? g_cerr_tap->Count() : 0);
 }
 
+/// Errors reported so far by the calling thread, library + tool. Snapshot this
+/// before and after a piece of work done on one thread, to decide whether that
+/// piece is trustworthy while other threads may be reporting their own errors.
+[[maybe_unused]] long ThreadErrorTotal()
+{
+    return g_thread_error_count;
+}
+
 /// True if the library or this tool has reported any error during this run.
 [[maybe_unused]] bool ErrorsSeen()
 {
@@ -275,7 +305,7 @@ CerrErrorTap* g_cerr_tap = nullptr;
 {
     const long lib = (g_cerr_tap != nullptr) ? g_cerr_tap->Count() : 0;
     return std::to_string(lib) + " library error(s), "
-         + std::to_string(g_tool_error_count) + " tool error(s)";
+         + std::to_string(g_tool_error_count.load()) + " tool error(s)";
 }
 
 //==============================================================================
@@ -790,6 +820,7 @@ private:
  */
 [[maybe_unused]] void Log(const std::string& msg)
 {
+    const std::lock_guard<std::mutex> lock(g_log_mutex);
     *g_log_stream << msg << "\n";
 }
 
@@ -800,6 +831,8 @@ void LogError(const std::string& msg)
 {
     ++g_tool_error_count;   // see ErrorsSeen(): in streaming mode this line goes
                             // to the log file, so the tap on cerr won't see it.
+    ++g_thread_error_count;
+    const std::lock_guard<std::mutex> lock(g_log_mutex);
     *g_log_stream << "Error: " << msg << "\n";
 }
 
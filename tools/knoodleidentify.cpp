@@ -19,18 +19,23 @@
  * Parses directly via ToExpression. An unknot yields <||>.
  *
  * Non-table summands appear as: Unidentified[N] (reduced below the table range
- * is impossible, so this is N>13), NotFound[N] (<=13 yet unresolved even after
- * Reapr -- suspicious), and the whole input as Link[N] if it is multi-component
+ * is impossible, so N is above the table range), NotFound[N] (within the table
+ * range yet unresolved even after Reapr -- suspicious), and the whole input as Link[N] if it is multi-component
  * (the KLUT is knots-only). See --help for the option list.
  */
 
 #include "knoodle_io.hpp"
 #include "klut_identify.hpp"
+#include "klut_result_cache.hpp"
+#include "klut_escalation_profile.hpp"
+#include "ordered_pool.hpp"
 
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -66,9 +71,13 @@ struct Config
     bool tsv            = false;             ///< Per-summand TSV output
     bool quiet          = false;             ///< Suppress stderr summary/warnings
     bool randomize_projection = false;       ///< Apply random shear to 3D geometry projection
+    bool write_table_files = false;          ///< Convert the text tables to Klut_Table_NN.bin and exit
+    std::size_t threads = 1;                 ///< Identify workers (1 = serial)
+    std::size_t cache_size = 0;              ///< Result cache entries (0 = no cache)
     ki::Size_T escalation_rounds = ki::IdentifyParams{}.cap;      ///< Reapr escalation rounds per candidate
-    Int        escalation_band   = ki::IdentifyParams{}.deep_cx;  ///< deep rounds only while stalled <= this
+    std::optional<Int> escalation_band;      ///< deep rounds only while stalled <= this (default: table range + 3)
     ki::Size_T rotation_trials   = ki::IdentifyParams{}.rot;      ///< reprojections per embedding
+    std::optional<std::string> escalation_profile; ///< Learned escalation schedule file (read + updated)
     std::vector<std::string> input_files;    ///< Input file paths (empty = stdin)
     bool help_requested = false;
 };
@@ -107,36 +116,58 @@ void PrintUsage()
         "\n"
         "Options:\n"
         "  --data-dir=PATH     KLUT data directory containing Klut_Keys_NN.bin\n"
-        "                      and Klut_Values_NN.tsv. Default: $KNOODLE_KLUT_DIR,\n"
+        "                      and Klut_Values_NN.tsv (or prebuilt\n"
+        "                      Klut_Table_NN.bin). Default: $KNOODLE_KLUT_DIR,\n"
         "                      else data/Klut next to this executable's parent,\n"
         "                      else ./data/Klut.\n"
-        "  --max-crossings=N   Use subtables up to N crossings (3-13, default 13).\n"
+        "  --max-crossings=N   Use subtables up to N crossings (3-16; default:\n"
+        "                      all subtables in the data directory).\n"
         "  --escalation-rounds=N  Max Reapr escalation rounds per candidate\n"
         "                      (default 4). Each round doubles embedding trials.\n"
         "                      The first 2 rounds always run; deeper rounds are\n"
         "                      banded (see --escalation-band), so a high N does\n"
         "                      not tax genuinely irreducible diagrams.\n"
         "  --escalation-band=C Rounds beyond the first 2 run only while the\n"
-        "                      stalled diagram has <= C crossings (default 16 =\n"
+        "                      stalled diagram has <= C crossings (default:\n"
         "                      table range + 3): a fixpoint near table range\n"
         "                      plausibly hides a table knot, one far above it\n"
         "                      does not. Set large to disable banding.\n"
         "  --rotation-trials=N Reprojections per embedding during escalation\n"
         "                      (default 5).\n"
+        "  --escalation-profile=PATH  Choose each escalation round's embedding and\n"
+        "                      rotation trials from the per-crossing-count success\n"
+        "                      rates and times in PATH (a TSV written by this\n"
+        "                      option or by klut_bench), instead of doubling.\n"
+        "                      This run's rounds are added and PATH is rewritten\n"
+        "                      at exit; a missing file starts an empty profile.\n"
         "  --expanded          One line per knot, summands joined by ' # ' (uses\n"
         "                      the raw K[...] table names).\n"
         "  --tsv               Per-summand output: knot_index, summand_index,\n"
         "                      crossing_count, name (tab-separated).\n"
         "  --quiet             Suppress the stderr summary and per-summand warnings.\n"
         "  --randomize-projection  Apply random shear to 3D geometry projection.\n"
+        "  --cache=N           Keep up to N results in a cache keyed by the\n"
+        "                      canonical (MacLeod) code of the raw input diagram\n"
+        "                      (default 0 = off). Only complete identifications\n"
+        "                      are cached; repeated diagrams then cost one hash\n"
+        "                      lookup. Hit/miss counts go to the stderr summary.\n"
+        "  --threads=N         Identify on N worker threads (default 1; 0 = one per\n"
+        "                      hardware thread). Output order and content are the\n"
+        "                      same as with one thread; a bounded window of\n"
+        "                      finished knots waits for a slow one ahead of it.\n"
+        "  --write-table-files Convert the text tables in the data directory to\n"
+        "                      prebuilt Klut_Table_NN.bin files and exit. These\n"
+        "                      are memory-mapped instead of parsed, so later runs\n"
+        "                      start instantly and share one copy of the table.\n"
         "  -h, --help          Show this help.\n"
         "\n"
         "Knot symbols (default / --tsv); c=crossings, i=index, the third field is the\n"
         "alternating flag, last is the symmetry coset:\n"
         "  KnotSymbol[c,i,a,\"sym\"]  identified knot; a (alternating) is True/False\n"
-        "  Unidentified[N,PD]       N>13 crossings, over the table range; PD = signed\n"
+        "  Unidentified[N,PD]       N crossings, over the table range; PD = signed\n"
         "                           PD code of the unresolved diagram (for analysis)\n"
-        "  NotFound[N,PD]           <=13 yet unresolved after Reapr (suspicious!); PD too\n"
+        "  NotFound[N,PD]           within table range yet unresolved after Reapr\n"
+        "                           (suspicious!); PD too\n"
         "  Link[N]                  multi-component input (the table is knots-only)\n"
         "  Invalid[]                invalid diagram / internal error\n"
         "  (unknot summands are the connect-sum identity and are omitted)\n"
@@ -216,6 +247,16 @@ std::optional<Config> ParseArguments(int argc, char* argv[])
             }
             config.rotation_trials = static_cast<ki::Size_T>(*parsed);
         }
+        else if (arg.starts_with("--escalation-profile="))
+        {
+            if (arg.size() == 21)
+            {
+                LogError("Invalid --escalation-profile (expected a file path)");
+                config.help_requested = true;
+                return config;
+            }
+            config.escalation_profile = std::string(arg.substr(21));
+        }
         else if (arg.starts_with("--max-crossings="))
         {
             auto parsed = ParseInt(arg.substr(16));
@@ -245,6 +286,34 @@ std::optional<Config> ParseArguments(int argc, char* argv[])
         {
             config.randomize_projection = true;
         }
+        else if (arg.starts_with("--cache="))
+        {
+            auto parsed = ParseInt(arg.substr(8));
+            if (!parsed || *parsed < 0)
+            {
+                LogError("Invalid --cache (expected a nonnegative entry count)");
+                config.help_requested = true;
+                return config;
+            }
+            config.cache_size = static_cast<std::size_t>(*parsed);
+        }
+        else if (arg.starts_with("--threads="))
+        {
+            auto parsed = ParseInt(arg.substr(10));
+            if (!parsed || *parsed < 0 || *parsed > 4096)
+            {
+                LogError("Invalid --threads (expected 0-4096)");
+                config.help_requested = true;
+                return config;
+            }
+            config.threads = (*parsed == 0)
+                ? std::max<std::size_t>(std::thread::hardware_concurrency(), 1)
+                : static_cast<std::size_t>(*parsed);
+        }
+        else if (arg == "--write-table-files")
+        {
+            config.write_table_files = true;
+        }
         else if (arg.starts_with("-") && arg.size() > 1)
         {
             LogError("Unknown option: " + std::string(arg));
@@ -353,8 +422,9 @@ std::optional<std::filesystem::path> ResolveDataDir(const Config& config)
 
     for (const fs::path& dir : candidates)
     {
-        // The 3-crossing subtable always exists in a valid KLUT directory.
-        if (fs::exists(dir / "Klut_Values_03.tsv"))
+        // The 3-crossing subtable always exists in a valid KLUT directory,
+        // as text table or as prebuilt table file.
+        if (fs::exists(dir / "Klut_Values_03.tsv") || fs::exists(dir / "Klut_Table_03.bin"))
         {
             return dir;
         }
@@ -375,19 +445,16 @@ std::optional<std::filesystem::path> ResolveDataDir(const Config& config)
 
 /// Identify returns a compact (crossing_count, subtable id). The id is the knot's
 /// 0-based index within crossing-number subtable c, i.e. the id-th line of
-/// Klut_Values_cc.tsv. Load those name lists once for human-readable rendering.
+/// Klut_Values_cc.tsv. Load those name lists once for human-readable rendering;
+/// they come from the same (text or memory-mapped) subtables as the lookups.
 std::map<Int, std::vector<std::string>>
-LoadNames(const std::filesystem::path& dir, Int max_crossings)
+LoadNames(Klut& klut, Int max_crossings)
 {
     std::map<Int, std::vector<std::string>> names;
     for (Int c = 3; c <= max_crossings; ++c)
     {
-        const std::string cc = (c < 10 ? "0" : "") + std::to_string(c);
-        std::ifstream vf(dir / ("Klut_Values_" + cc + ".tsv"));
-        if (!vf) { continue; }
-        std::vector<std::string> v;
-        std::string name; long count;
-        while (vf >> name >> count) { v.push_back(name); }
+        std::vector<std::string> v = klut.SubtableNames(c);
+        if (v.empty()) { continue; }
         names[c] = std::move(v);
     }
     return names;
@@ -591,152 +658,299 @@ Summand ConvertSummand(const ki::Summand& rs,
 }
 
 /**
- * @brief Process one input stream; writes identifications to stdout.
+ * @brief Per-worker identify state: the Reapr, the scratch complexes and the
+ *        Simplify workspace that ki::IdentifyInto reuses across knots. One per thread; never shared --
+ *        except `cache` and `profile`, which all workers point to and which
+ *        synchronize themselves.
  */
-bool ProcessStream(std::istream& input, const std::string& source_name,
-                   const Config& config, Klut& klut,
-                   const std::map<Int, std::vector<std::string>>& names,
-                   ki::Reapr_T& reapr, Stats& stats, Knoodle::PRNG_T& rng)
+struct Worker
 {
-    bool reached_eof = false;
+    ki::Reapr_T            reapr{};
+    ki::PDC_T              work;
+    ki::PDC_T              temp;
+    ki::Workspace_T        workspace;
+    ki::ResultCache::Key   key;
+    ki::ResultCache*       cache = nullptr;   ///< --cache (null = off)
+    ki::EscalationProfile* profile = nullptr; ///< --escalation-profile (null = fixed schedule)
+};
 
-    while (!reached_eof)
+/**
+ * @brief What identifying one input knot produced; rendered by EmitKnot.
+ */
+struct Identified
+{
+    ki::IdentifyResult res;
+    Int                input_crossings = 0;
+};
+
+ki::IdentifyParams ParamsOf(const Config& config, ki::EscalationProfile* profile)
+{
+    ki::IdentifyParams params;
+    params.cap     = config.escalation_rounds;
+    params.deep_cx = config.escalation_band.value_or(config.max_crossings + Int(3));
+    params.max_cx  = config.max_crossings;
+    params.rot     = config.rotation_trials;
+    params.profile = profile;
+    return params;
+}
+
+/**
+ * @brief Identify one input knot with `worker`'s Reapr and scratch. Touches no
+ *        shared state except the (const, reentrant) Klut, so it is safe to run
+ *        on several workers at once.
+ */
+Identified IdentifyKnot(InputKnot& input_knot, const Config& config,
+                        const Klut& klut, Worker& worker)
+{
+    // Build a PDC from the raw input diagram(s). Raw input is normally a
+    // single diagram; if pre-split summands arrive, Identify re-decomposes
+    // their union. Bare unknot summands carry no diagram and are the identity.
+    // Push() is lock-guarded and silently does nothing on a locked complex,
+    // which would leave the complex empty and make every input look like an
+    // unknot. Feeding it diagrams that ReadKnot just produced from one input
+    // record is the sanctioned use, so unlock for the duration.
+    worker.work.Unlock();
+    worker.work.Clear();
+    for (PD_T& pd : input_knot.summands)
     {
-        auto input_knot = ReadKnot(input, config.randomize_projection, rng, source_name, reached_eof);
+        if (pd.ValidQ()) { worker.work.Push(std::move(pd)); }
+    }
 
-        if (!input_knot)
-        {
-            if (reached_eof) { continue; }
-            return false;  // Parse error
-        }
+    Identified out;
+    out.input_crossings =
+        (worker.work.DiagramCount() > Int(0)) ? worker.work.CrossingCount() : Int(0);
+
+    ki::IdentifyCachedInto(klut, worker.cache, worker.work, worker.temp, worker.reapr,
+                           &worker.workspace, worker.key, out.res,
+                           ParamsOf(config, worker.profile));
 
-        ++stats.knots;
+    return out;
+}
 
-        // Build a PDC from the raw input diagram(s). Raw input is normally a
-        // single diagram; if pre-split summands arrive, Identify re-decomposes
-        // their union. Bare unknot summands carry no diagram and are the identity.
-        ki::PDC_T pdc;
-        // Push() is lock-guarded and silently does nothing on a locked complex,
-        // which would leave pdc empty and make every input look like an unknot.
-        // Feeding it diagrams that ReadKnot just produced from one input record
-        // is the sanctioned use, so unlock for the duration.
-        pdc.Unlock();
-        for (PD_T& pd : input_knot->summands)
+/**
+ * @brief Render one identified knot to stdout and tally it. Called in input
+ *        order, from one thread only.
+ */
+void EmitKnot(const Identified& identified, const Config& config,
+              const std::map<Int, std::vector<std::string>>& names, Stats& stats)
+{
+    const ki::IdentifyResult& res = identified.res;
+
+    ++stats.knots;
+
+    std::vector<Summand> summands;
+
+    if (res.status == ki::IdentifyResult::Status::LinkOutOfScope)
+    {
+        Summand s; s.kind = Kind::Link; s.crossings = identified.input_crossings;
+        summands.push_back(s);
+        ++stats.summands; ++stats.links;
+    }
+    else
+    {
+        if (res.component_error && !config.quiet)
         {
-            if (pd.ValidQ()) { pdc.Push(std::move(pd)); }
+            LogError("knot " + std::to_string(stats.knots) +
+                     ": Simplify changed the link-component count (a bug) — "
+                     "identification suspect");
         }
-        const Int input_crossings =
-            (pdc.DiagramCount() > Int(0)) ? pdc.CrossingCount() : Int(0);
+        for (const ki::Summand& rs : res.summands)
+        {
+            summands.push_back(ConvertSummand(rs, names, stats));
+            ++stats.summands;
+        }
+        // Empty (and not a link) means everything reduced away: the unknot.
+        if (summands.empty())
+        {
+            summands.push_back(Summand{.kind = Kind::Unknot});
+            ++stats.summands; ++stats.unknots;
+        }
+    }
 
-        ki::IdentifyParams params;
-        params.cap     = config.escalation_rounds;
-        params.deep_cx = config.escalation_band;
-        params.rot     = config.rotation_trials;
+    if (config.tsv)
+    {
+        for (std::size_t i = 0; i < summands.size(); ++i)
+        {
+            const Summand& s = summands[i];
+            const std::string sym =
+                (s.kind == Kind::Unknot) ? "Unknot" : WLSymbol(s);
+            std::cout << stats.knots << '\t' << (i + 1) << '\t'
+                      << s.crossings << '\t' << sym << '\n';
+        }
+    }
+    else if (config.expanded)
+    {
+        // '#'-joined, arrival order. Unknot is the connect-sum identity:
+        // show it only when there is nothing else.
+        std::vector<std::string> shown;
+        for (const Summand& s : summands)
+        {
+            if (s.kind != Kind::Unknot) { shown.push_back(ExpandedSymbol(s)); }
+        }
+        if (shown.empty()) { shown.push_back("Unknot"); }
 
-        ki::IdentifyResult res =
-            ki::Identify(klut, std::move(pdc), reapr, params);
+        for (std::size_t i = 0; i < shown.size(); ++i)
+        {
+            if (i > 0) { std::cout << " # "; }
+            std::cout << shown[i];
+        }
+        std::cout << '\n';
+    }
+    else
+    {
+        // Default: a Wolfram Language association mapping each distinct
+        // (non-unknot) summand to its multiplicity, keys sorted.
+        std::map<Summand, Int, bool(*)(const Summand&, const Summand&)>
+            multiset(SummandLess);
 
-        std::vector<Summand> summands;
+        for (const Summand& s : summands)
+        {
+            if (s.kind == Kind::Unknot) { continue; }  // identity
+            ++multiset[s];
+        }
 
-        if (res.status == ki::IdentifyResult::Status::LinkOutOfScope)
+        std::cout << "<|";
+        bool first = true;
+        for (const auto& [s, count] : multiset)
         {
-            Summand s; s.kind = Kind::Link; s.crossings = input_crossings;
-            summands.push_back(s);
-            ++stats.summands; ++stats.links;
+            std::cout << (first ? " " : ", ")
+                      << WLSymbol(s) << " -> " << count;
+            first = false;
         }
-        else
+        std::cout << (first ? "|>" : " |>") << '\n';
+    }
+
+    std::cout << std::flush;
+
+    if (!config.quiet)
+    {
+        for (std::size_t i = 0; i < summands.size(); ++i)
         {
-            if (res.component_error && !config.quiet)
+            if (summands[i].kind == Kind::NotFound)
             {
                 LogError("knot " + std::to_string(stats.knots) +
-                         ": Simplify changed the link-component count (a bug) — "
-                         "identification suspect");
-            }
-            for (const ki::Summand& rs : res.summands)
-            {
-                summands.push_back(ConvertSummand(rs, names, stats));
-                ++stats.summands;
-            }
-            // Empty (and not a link) means everything reduced away: the unknot.
-            if (summands.empty())
-            {
-                summands.push_back(Summand{.kind = Kind::Unknot});
-                ++stats.summands; ++stats.unknots;
+                         ", summand " + std::to_string(i + 1) + ": " +
+                         std::to_string(summands[i].crossings) +
+                         " crossings, within table range yet unresolved after Reapr — "
+                         "table gap or a hard simplification case?");
             }
         }
+    }
+}
+
+/**
+ * @brief Process one input stream; writes identifications to stdout.
+ */
+bool ProcessStream(std::istream& input, const std::string& source_name,
+                   const Config& config, const Klut& klut,
+                   const std::map<Int, std::vector<std::string>>& names,
+                   Worker& worker, Stats& stats, Knoodle::PRNG_T& rng)
+{
+    bool reached_eof = false;
+
+    while (!reached_eof)
+    {
+        auto input_knot = ReadKnot(input, config.randomize_projection, rng, source_name, reached_eof);
 
-        if (config.tsv)
+        if (!input_knot)
         {
-            for (std::size_t i = 0; i < summands.size(); ++i)
-            {
-                const Summand& s = summands[i];
-                const std::string sym =
-                    (s.kind == Kind::Unknot) ? "Unknot" : WLSymbol(s);
-                std::cout << stats.knots << '\t' << (i + 1) << '\t'
-                          << s.crossings << '\t' << sym << '\n';
-            }
+            if (reached_eof) { continue; }
+            return false;  // Parse error
         }
-        else if (config.expanded)
+
+        EmitKnot(IdentifyKnot(*input_knot, config, klut, worker), config, names, stats);
+    }
+
+    return true;
+}
+
+/**
+ * @brief The --threads mode: identify all sources on a work-stealing pool.
+ *
+ * A reader thread parses the sources in order (so the --randomize-projection
+ * stream of random numbers is the same as in a serial run) and submits each
+ * knot; the workers each own a Worker over the shared const Klut; this thread
+ * emits the results in input order through the pool's bounded reorder window.
+ * The output is therefore identical to a serial run's, line for line.
+ */
+bool ProcessSourcesParallel(const Config& config, const Klut& klut,
+                            const std::map<Int, std::vector<std::string>>& names,
+                            ki::ResultCache* cache, ki::EscalationProfile* profile,
+                            Stats& stats, Knoodle::PRNG_T& rng)
+{
+    const std::size_t thread_count = config.threads;
+
+    std::vector<Worker> workers(thread_count);
+    for (Worker& worker : workers) { worker.cache = cache; worker.profile = profile; }
+
+    OrderedPool<InputKnot, Identified> pool(
+        thread_count, thread_count * kReorderWindowPerThread,
+        [&](std::size_t w, InputKnot& knot)
         {
-            // '#'-joined, arrival order. Unknot is the connect-sum identity:
-            // show it only when there is nothing else.
-            std::vector<std::string> shown;
-            for (const Summand& s : summands)
-            {
-                if (s.kind != Kind::Unknot) { shown.push_back(ExpandedSymbol(s)); }
-            }
-            if (shown.empty()) { shown.push_back("Unknot"); }
+            return IdentifyKnot(knot, config, klut, workers[w]);
+        });
 
-            for (std::size_t i = 0; i < shown.size(); ++i)
+    std::atomic<bool> reader_success = true;
+
+    std::thread reader([&]()
+    {
+        auto read = [&](std::istream& input, const std::string& source_name)
+        {
+            bool reached_eof = false;
+            while (!reached_eof)
             {
-                if (i > 0) { std::cout << " # "; }
-                std::cout << shown[i];
+                auto input_knot = ReadKnot(input, config.randomize_projection, rng,
+                                           source_name, reached_eof);
+                if (!input_knot)
+                {
+                    if (reached_eof) { continue; }
+                    reader_success = false;  // Parse error: skip the rest of this source
+                    return;
+                }
+                if (!pool.Submit(std::move(*input_knot))) { return; }
             }
-            std::cout << '\n';
+        };
+
+        if (config.input_files.empty())
+        {
+            read(std::cin, "stdin");
         }
         else
         {
-            // Default: a Wolfram Language association mapping each distinct
-            // (non-unknot) summand to its multiplicity, keys sorted.
-            std::map<Summand, Int, bool(*)(const Summand&, const Summand&)>
-                multiset(SummandLess);
-
-            for (const Summand& s : summands)
-            {
-                if (s.kind == Kind::Unknot) { continue; }  // identity
-                ++multiset[s];
-            }
-
-            std::cout << "<|";
-            bool first = true;
-            for (const auto& [s, count] : multiset)
+            for (const std::string& filename : config.input_files)
             {
-                std::cout << (first ? " " : ", ")
-                          << WLSymbol(s) << " -> " << count;
-                first = false;
+                std::ifstream file(filename);
+                if (!file)
+                {
+                    LogError("Failed to open " + filename);
+                    reader_success = false;
+                    continue;
+                }
+                read(file, filename);
             }
-            std::cout << (first ? "|>" : " |>") << '\n';
         }
 
-        std::cout << std::flush;
+        pool.Close();
+    });
 
-        if (!config.quiet)
+    try
+    {
+        while (auto identified = pool.Next())
         {
-            for (std::size_t i = 0; i < summands.size(); ++i)
-            {
-                if (summands[i].kind == Kind::NotFound)
-                {
-                    LogError("knot " + std::to_string(stats.knots) +
-                             ", summand " + std::to_string(i + 1) + ": " +
-                             std::to_string(summands[i].crossings) +
-                             " crossings, <=13 yet unresolved after Reapr — "
-                             "table gap or a hard simplification case?");
-                }
-            }
+            EmitKnot(*identified, config, names, stats);
         }
     }
+    catch (...)
+    {
+        // Unblock the reader so it can be joined, then rethrow.
+        pool.Stop();
+        reader.join();
+        throw;
+    }
 
-    return true;
+    reader.join();
+
+    return reader_success;
 }
 
 } // anonymous namespace
@@ -774,6 +988,19 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    if (config.write_table_files)
+    {
+        // Convert from the text tables, never from older table files.
+        Klut text_klut(*data_dir, static_cast<Knoodle::Size_T>(config.max_crossings), false);
+        const bool written = text_klut.WriteTableFiles();
+        if (!config.quiet)
+        {
+            Log(std::string("knoodleidentify: ") + (written ? "wrote" : "FAILED to write") +
+                " table files Klut_Table_NN.bin in " + data_dir->string());
+        }
+        return written ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     // knoodleidentify always writes its results to stdout, so rule 1 (put the
     // diagnostics beside the output file) never applies -- it is rule 2 every
     // time: a per-process directory under the system temp dir. This has to
@@ -785,27 +1012,62 @@ int main(int argc, char* argv[])
     const std::set<std::string> bundles_before = ListDiagnosticBundles(diag_dir);
 
     Klut klut(*data_dir, static_cast<Knoodle::Size_T>(config.max_crossings));
-    auto names = LoadNames(*data_dir, config.max_crossings);
+    // Subtables above 13 crossings exist only where table files were converted.
+    config.max_crossings = std::min(config.max_crossings,
+                                    static_cast<Int>(klut.AvailableCrossingCount()));
+    auto names = LoadNames(klut, config.max_crossings);
 
-    ki::Reapr_T reapr{};
     Knoodle::PRNG_T rng = Knoodle::InitializedRandomEngine<Knoodle::PRNG_T>();
 
+    // Shared by all workers; it locks per shard, see klut_result_cache.hpp.
+    std::optional<ki::ResultCache> cache;
+    if (config.cache_size > 0)
+    {
+        cache.emplace(config.cache_size);
+    }
+    ki::ResultCache* const cache_ptr = cache ? &*cache : nullptr;
+
+    // Shared by all workers; its counts are atomics, see klut_escalation_profile.hpp.
+    std::optional<ki::EscalationProfile> profile;
+    if (config.escalation_profile)
+    {
+        profile.emplace();
+        if (std::filesystem::exists(*config.escalation_profile) &&
+            !profile->Load(*config.escalation_profile))
+        {
+            LogError("Failed to read escalation profile " + *config.escalation_profile);
+            return EXIT_FAILURE;
+        }
+    }
+    ki::EscalationProfile* const profile_ptr = profile ? &*profile : nullptr;
+
     Stats stats;
     bool success = true;
 
-    if (config.input_files.empty())
+    if (config.input_files.empty() && StdinIsInteractive())
     {
         // Unix filter: no files -> read stdin. If stdin is an interactive terminal
         // (no pipe/redirect), say so, so a bare invocation does not just look hung.
-        if (StdinIsInteractive())
-        {
-            Log("knoodleidentify: reading diagrams from stdin (Ctrl-D to end). "
-                "Pipe a stream or pass a file; --help for usage.");
-        }
-        success = ProcessStream(std::cin, "stdin", config, klut, names, reapr, stats, rng);
+        Log("knoodleidentify: reading diagrams from stdin (Ctrl-D to end). "
+            "Pipe a stream or pass a file; --help for usage.");
+    }
+
+    if (config.threads > 1)
+    {
+        success = ProcessSourcesParallel(config, klut, names, cache_ptr, profile_ptr, stats, rng);
+    }
+    else if (config.input_files.empty())
+    {
+        Worker worker;
+        worker.cache = cache_ptr;
+        worker.profile = profile_ptr;
+        success = ProcessStream(std::cin, "stdin", config, klut, names, worker, stats, rng);
     }
     else
     {
+        Worker worker;
+        worker.cache = cache_ptr;
+        worker.profile = profile_ptr;
         for (const std::string& filename : config.input_files)
         {
             std::ifstream file(filename);
@@ -815,7 +1077,7 @@ int main(int argc, char* argv[])
                 success = false;
                 continue;
             }
-            if (!ProcessStream(file, filename, config, klut, names, reapr, stats, rng))
+            if (!ProcessStream(file, filename, config, klut, names, worker, stats, rng))
             {
                 success = false;
             }
@@ -832,6 +1094,31 @@ int main(int argc, char* argv[])
             std::to_string(stats.over_range) + " over table range, " +
             std::to_string(stats.links) + " links, " +
             std::to_string(stats.invalid) + " invalid)");
+
+        if (cache)
+        {
+            const ki::ResultCache::Counts counts = cache->GetCounts();
+            Log("knoodleidentify: result cache: " + std::to_string(counts.hits) + " hits, " +
+                std::to_string(counts.misses) + " misses, " +
+                std::to_string(counts.inserts) + " inserted, " +
+                std::to_string(counts.evictions) + " evicted, " +
+                std::to_string(counts.bypasses) + " not cacheable");
+        }
+    }
+
+    if (profile)
+    {
+        if (!profile->Save(*config.escalation_profile))
+        {
+            LogError("Failed to write escalation profile " + *config.escalation_profile);
+            success = false;
+        }
+        else if (!config.quiet)
+        {
+            const auto [steps, resolved] = profile->Totals();
+            Log("knoodleidentify: escalation profile: " + std::to_string(steps) +
+                " recorded rounds, " + std::to_string(resolved) + " resolved");
+        }
     }
 
     if (ErrorsSeen())
@@ -30,10 +30,13 @@
 // Only TOOLS_USE_BOOST_UNORDERED might be of some interest here because OrthoDraw and Reapr uses some of the containers provided by this a little. However, the containers sizes should be small in practive, so the corresponding fall back containers of the STL will be good enough. I doubt that anybody will measure some difference, but you are free to do so.
 
 #include "knoodle_io.hpp"
+#include "ordered_pool.hpp"
 
+#include <atomic>
 #include <cstdio>
 #include <filesystem>
 #include <limits>
+#include <thread>
 
 //==============================================================================
 // Configuration
@@ -74,6 +77,8 @@ struct Config
     std::optional<bool>     compress;
     std::optional<Int>      compression_threshold;
     std::optional<Knoodle::Size_T> rotation_trials;
+    std::optional<Knoodle::Size_T> rattle_threads;    ///< 0 = one per hardware thread
+    std::optional<Knoodle::Size_T> worklist_threads;  ///< 0 = one per hardware thread
     std::optional<bool>     reapr_permute_random;
     std::optional<double>   reapr_scaling;
     std::optional<int>      randomize_bends;
@@ -93,6 +98,7 @@ struct Config
     std::vector<std::string> input_files;    ///< Input file paths
     bool streaming_mode       = false;       ///< Read from stdin, write to stdout
     bool randomize_projection = false;       ///< Apply random shear to 3D projection
+    std::size_t threads       = 1;           ///< Simplify workers (1 = serial)
 
     // Output options
     std::optional<std::string> output_file;  ///< Single output file (if specified)
@@ -206,7 +212,8 @@ void PrintUsage()
     Log("preset -- see src/PlanarDiagramComplex/Simplify.hpp):");
     Log("  --compress-initial / --no-compress-initial   Compress input before simplifying");
     Log("  --local-opt-level=N (0-4)   Local pattern optimization intensity");
-    Log("  --dijkstra-strategy=S       unidirectional, alternating, bidirectional");
+    Log("  --dijkstra-strategy=S       unidirectional, alternating, bidirectional, guided");
+    Log("                                (guided: bidirectional, faces ordered by landmarks)");
     Log("  --start-max-dist=N          Initial Dijkstra max search distance");
     Log("  --final-max-dist=N          Final Dijkstra max search distance");
     Log("  --reroute / --no-reroute    Enable rerouting passes");
@@ -214,6 +221,12 @@ void PrintUsage()
     Log("  --compress / --no-compress  Compress diagrams during simplification");
     Log("  --compression-threshold=N   Crossing-count threshold for compression");
     Log("  --reapr-rotation-trials=N   Random rotations tried per Reapr embedding (default: 25)");
+    Log("  --rattle-threads=N          Evaluate Reapr embeddings and rotations on N threads");
+    Log("                                (default 1; 0 = one per hardware thread). The best");
+    Log("                                trial of each batch of N embeddings wins");
+    Log("  --worklist-threads=N        Simplify the summands of a knot on N threads (default");
+    Log("                                1; 0 = one per hardware thread). Pays off for");
+    Log("                                heavily composite knots");
     Log("  --reapr-permute-random / --no-reapr-permute-random");
     Log("                              Randomize arc permutation in Reapr");
     Log("  --reapr-scaling=X           3D grid scaling in Reapr (default: 1.0)");
@@ -236,6 +249,10 @@ void PrintUsage()
     Log("  --input=FILE                Specify input file (can use multiple times)");
     Log("  --streaming-mode            Read from stdin, write to stdout");
     Log("  --randomize-projection      Apply random shear to 3D geometry projection");
+    Log("  --threads=N                 Simplify on N worker threads (default 1; 0 = one");
+    Log("                                per hardware thread). Knots are written and");
+    Log("                                reported in input order; .kndlxyz files are");
+    Log("                                still processed one at a time");
     Log("");
     Log("Output options:");
     Log("  --output=FILE               Write all output to FILE");
@@ -392,10 +409,11 @@ std::optional<Config> ParseArguments(int argc, char* argv[])
             if      (v == "unidirectional") config.dijkstra_strategy = Knoodle::DijkstraStrategy_T::Unidirectional;
             else if (v == "alternating")    config.dijkstra_strategy = Knoodle::DijkstraStrategy_T::Alternating;
             else if (v == "bidirectional")  config.dijkstra_strategy = Knoodle::DijkstraStrategy_T::Bidirectional;
+            else if (v == "guided")         config.dijkstra_strategy = Knoodle::DijkstraStrategy_T::Guided;
             else
             {
                 LogError("Unknown dijkstra-strategy: '" + std::string(arg.substr(20)) + "'");
-                LogError("Valid options: unidirectional, alternating, bidirectional");
+                LogError("Valid options: unidirectional, alternating, bidirectional, guided");
                 return std::nullopt;
             }
         }
@@ -430,6 +448,30 @@ std::optional<Config> ParseArguments(int argc, char* argv[])
             }
             catch (const std::exception&) { LogError("Invalid reapr-rotation-trials value"); return std::nullopt; }
         }
+        else if (arg.starts_with("--rattle-threads="))
+        {
+            try
+            {
+                const long long v = std::stoll(std::string(arg.substr(17)));
+                if (v < 0 || v > 4096) { LogError("rattle-threads must be between 0 and 4096"); return std::nullopt; }
+                config.rattle_threads = (v == 0)
+                    ? std::max<Knoodle::Size_T>(std::thread::hardware_concurrency(), 1)
+                    : static_cast<Knoodle::Size_T>(v);
+            }
+            catch (const std::exception&) { LogError("Invalid rattle-threads value"); return std::nullopt; }
+        }
+        else if (arg.starts_with("--worklist-threads="))
+        {
+            try
+            {
+                const long long v = std::stoll(std::string(arg.substr(19)));
+                if (v < 0 || v > 4096) { LogError("worklist-threads must be between 0 and 4096"); return std::nullopt; }
+                config.worklist_threads = (v == 0)
+                    ? std::max<Knoodle::Size_T>(std::thread::hardware_concurrency(), 1)
+                    : static_cast<Knoodle::Size_T>(v);
+            }
+            catch (const std::exception&) { LogError("Invalid worklist-threads value"); return std::nullopt; }
+        }
         else if (arg == "--reapr-permute-random")    { config.reapr_permute_random = true; }
         else if (arg == "--no-reapr-permute-random") { config.reapr_permute_random = false; }
         else if (arg.starts_with("--reapr-scaling="))
@@ -481,6 +523,27 @@ std::optional<Config> ParseArguments(int argc, char* argv[])
         {
             config.randomize_projection = true;
         }
+        // Worker threads
+        else if (arg.starts_with("--threads="))
+        {
+            try
+            {
+                const long long threads = std::stoll(std::string(arg.substr(10)));
+                if (threads < 0 || threads > 4096)
+                {
+                    LogError("threads must be between 0 and 4096");
+                    return std::nullopt;
+                }
+                config.threads = (threads == 0)
+                    ? std::max<std::size_t>(std::thread::hardware_concurrency(), 1)
+                    : static_cast<std::size_t>(threads);
+            }
+            catch (const std::exception&)
+            {
+                LogError("Invalid threads value");
+                return std::nullopt;
+            }
+        }
         // Output file
         else if (arg.starts_with("--output="))
         {
@@ -592,6 +655,8 @@ PDC_T::Simplify_Args_T BuildSimplifyArgs(const Config& config)
     if (config.compress.has_value())               args.compressQ = *config.compress;
     if (config.compression_threshold.has_value())  args.compression_threshold = *config.compression_threshold;
     if (config.rotation_trials.has_value())        args.rotation_trials = *config.rotation_trials;
+    if (config.rattle_threads.has_value())         args.rattle_thread_count = *config.rattle_threads;
+    if (config.worklist_threads.has_value())       args.worklist_thread_count = *config.worklist_threads;
     if (config.reapr_permute_random.has_value())   args.permute_randomQ = *config.reapr_permute_random;
     if (config.reapr_scaling.has_value())          args.scaling = *config.reapr_scaling;
     if (config.randomize_bends.has_value())        args.randomize_bends = *config.randomize_bends;
@@ -602,6 +667,26 @@ PDC_T::Simplify_Args_T BuildSimplifyArgs(const Config& config)
     return args;
 }
 
+/**
+ * @brief The Reapr that PDC_T::Simplify(args) constructs for itself, built
+ *        once up front instead. Simplify(reapr, args) takes some options from
+ *        the Reapr rather than from args (Simplify.hpp), so the settings must
+ *        be copied over exactly as Simplify(args) does it.
+ */
+Reapr_T MakeReapr(const PDC_T::Simplify_Args_T& args)
+{
+    return Reapr_T({
+        .permute_randomQ     = args.permute_randomQ,
+        .energy              = args.energy,
+        .ortho_draw_settings = {
+            .randomize_bends          = args.randomize_bends,
+            .randomize_virtual_edgesQ = args.randomize_virtual_edgesQ,
+            .compaction_method        = args.compaction_method
+        },
+        .scaling             = args.scaling
+    });
+}
+
 /**
  * @brief Simplify a knot using the configured algorithm.
  *
@@ -613,9 +698,13 @@ PDC_T::Simplify_Args_T BuildSimplifyArgs(const Config& config)
  *        a summand becomes trivial (see knoodle_io.hpp's unknot_colors doc
  *        comment), this preserves full color fidelity via
  *        PlanarDiagramComplex's own native serialization.
+ * @param reapr If non-null, the Reapr to simplify with (see MakeReapr), so a
+ *        --threads worker keeps its own random engine across knots. If null,
+ *        PDC_T::Simplify constructs a fresh one per summand, as it always did.
  * @return The simplified knot with timing information.
  */
-SimplifiedKnot SimplifyKnot(const InputKnot& input, const Config& config, PDC_T* output_pdc = nullptr)
+SimplifiedKnot SimplifyKnot(const InputKnot& input, const Config& config, PDC_T* output_pdc = nullptr,
+                            Reapr_T* reapr = nullptr)
 {
     SimplifiedKnot result;
 
@@ -696,7 +785,14 @@ SimplifiedKnot SimplifyKnot(const InputKnot& input, const Config& config, PDC_T*
                 PD_T pd_copy = colorize(PD_T(pd_in));
                 PDC_T pdc(std::move(pd_copy));
 
-                pdc.Simplify(args);
+                if (reapr)
+                {
+                    pdc.Simplify(*reapr, args);
+                }
+                else
+                {
+                    pdc.Simplify(args);
+                }
 
                 if (pdc.DiagramCount() == 0)
                 {
@@ -1245,6 +1341,118 @@ bool ProcessXYZFile(const std::string& filepath,
     return true;
 }
 
+/**
+ * @brief Write, report and tally one simplified knot of a PD/3D source.
+ *
+ * Shared by ProcessSource and ProcessSourceParallel, so that both produce the
+ * same output and the same per-knot reports. `simplify_error_count` is the
+ * number of errors that the thread which simplified the knot reported while
+ * doing so (see ThreadErrorTotal).
+ *
+ * @return false if the per-file output could not be written.
+ */
+bool EmitKnot(const InputKnot& input_knot,
+              SimplifiedKnot& simplified,
+              PDC_T* output_pdc,
+              Duration input_time,
+              long simplify_error_count,
+              const std::string& source_name,
+              std::ostream* output_stream,
+              const Config& config,
+              ProcessingStats& stats,
+              bool& first_knot_in_output)
+{
+    // Determine output format based on input column count.
+    //
+    // Colors are also written whenever the result has more than one summand,
+    // even for uncolored input. Splitting a diagram is exactly when the color
+    // stops being redundant: it is the only thing recording that two summands
+    // were once one closed curve (a connected sum) rather than two (a split
+    // link), and a consumer such as `knoodledraw --embedding` cannot rebuild
+    // the correct link type without it. SimplifyKnot has already given
+    // uncolored input real per-link-component colors for this purpose.
+    const bool split_into_summands =
+        (simplified.summands.size() + static_cast<std::size_t>(simplified.unknot_count)) > 1;
+
+    bool colored_output = (input_knot.input_column_count >= 6) || split_into_summands;
+
+    // Output phase
+    Duration output_time{0};
+
+    {
+        ScopedTimer timer(output_time);
+
+        if (output_stream)
+        {
+            // Writing to shared output stream
+            WriteSimplified(simplified, output_pdc, *output_stream,
+                             !first_knot_in_output || !config.streaming_mode,
+                             colored_output);
+            first_knot_in_output = false;
+        }
+        else if (!config.streaming_mode)
+        {
+            // Per-file output. Staged, and committed only if nothing went
+            // wrong while producing this knot (see AtomicOutFile). The counts
+            // are per thread: with --threads, the other workers keep running
+            // while this one writes.
+            std::filesystem::path input_path(source_name);
+            std::filesystem::path output_path = GetSimplifiedFilename(input_path);
+
+            const long errors_before = ThreadErrorTotal();
+
+            AtomicOutFile file(output_path);
+            if (!file.Good())
+            {
+                LogError("Failed to open " + output_path.string() + " for writing");
+                return false;
+            }
+
+            WriteSimplified(simplified, output_pdc, file.Stream(), true, colored_output);
+
+            if ((simplify_error_count > 0) || (ThreadErrorTotal() != errors_before))
+            {
+                file.Abort();
+                *g_log_stream << "Refusing to write " << output_path.string()
+                              << ": the library reported an error while producing it.\n";
+                return false;
+            }
+            if (!file.Commit())
+            {
+                LogError("Failed to move output into place: " + output_path.string());
+                return false;
+            }
+        }
+    }
+
+    // Reporting phase
+    if (config.quiet)
+    {
+        // In quiet mode, just print a counter that updates in place
+        *g_log_stream << "\r" << (stats.total_knots + 1) << " knots processed" << std::flush;
+    }
+    else
+    {
+        WriteKnotReport(input_knot, simplified, config, input_time, output_time);
+    }
+
+    // Update stats
+    stats.input_crossings  += input_knot.total_crossings;
+    stats.output_crossings += simplified.total_crossings;
+    stats.total_summands   += simplified.TotalSummandCount();
+    stats.proven_minimal_summands += simplified.TotalProvenMinimalCount();
+    if (simplified.FullySimplifiedQ())
+    {
+        ++stats.fully_simplified_knots;
+    }
+    stats.input_time       += input_time;
+    stats.simplify_time    += simplified.simplify_time;
+    stats.output_time      += output_time;
+    ++stats.total_knots;
+
+    return true;
+}
+
 /**
  * @brief Process a single input source (file or stdin).
  *
@@ -1293,97 +1501,156 @@ bool ProcessSource(std::istream& input,
         }
 
         // Simplification phase
+        const long errors_before = ThreadErrorTotal();
         PDC_T output_pdc;
         SimplifiedKnot simplified = SimplifyKnot(*input_knot, config, config.pdc_format ? &output_pdc : nullptr);
+        const long simplify_error_count = ThreadErrorTotal() - errors_before;
 
-        // Determine output format based on input column count.
-        //
-        // Colors are also written whenever the result has more than one summand,
-        // even for uncolored input. Splitting a diagram is exactly when the color
-        // stops being redundant: it is the only thing recording that two summands
-        // were once one closed curve (a connected sum) rather than two (a split
-        // link), and a consumer such as `knoodledraw --embedding` cannot rebuild
-        // the correct link type without it. SimplifyKnot has already given
-        // uncolored input real per-link-component colors for this purpose.
-        const bool split_into_summands =
-            (simplified.summands.size() + static_cast<std::size_t>(simplified.unknot_count)) > 1;
+        if (!EmitKnot(*input_knot, simplified, config.pdc_format ? &output_pdc : nullptr, input_time,
+                      simplify_error_count, source_name, output_stream, config, stats, first_knot_in_output))
+        {
+            return false;
+        }
+    }
 
-        bool colored_output = (input_knot->input_column_count >= 6) || split_into_summands;
+    return true;
+}
+
+/**
+ * @brief One parsed knot on its way through the --threads pool, and later
+ *        the same knot simplified.
+ */
+struct PendingKnot
+{
+    InputKnot      input;
+    Duration       input_time{0};
+    SimplifiedKnot simplified;
+    PDC_T          output_pdc;
+    long           simplify_error_count = 0;  // Errors the worker reported while simplifying it.
+};
+
+/**
+ * @brief One Reapr per --threads worker, each with its own random stream.
+ *
+ * The streams are those of `rng`, advanced by (w + 1) * 2^96 steps for worker
+ * w -- as PolyFold does for its chains -- so they cannot overlap each other or
+ * the --randomize-projection draws that the reader makes from `rng` itself.
+ */
+std::vector<Reapr_T> MakeWorkerReaprs(const Config& config, const Knoodle::PRNG_T& rng)
+{
+    // Copies of a Reapr reseed themselves from std::random_device (Reapr.hpp),
+    // so the streams are set only once the vector is in place.
+    std::vector<Reapr_T> reaprs(config.threads, MakeReapr(BuildSimplifyArgs(config)));
+
+    using State_T = Knoodle::PRNG_T::state_type;
+
+    for (std::size_t w = 0; w < reaprs.size(); ++w)
+    {
+        reaprs[w].RandomEngine() = rng;
+        reaprs[w].RandomEngine().advance(static_cast<State_T>(w + 1) << 96);
+    }
 
-        // Output phase
-        Duration output_time{0};
+    return reaprs;
+}
 
+/**
+ * @brief The --threads variant of ProcessSource: same arguments, same output.
+ *
+ * A reader thread parses the source (so the --randomize-projection draws from
+ * `rng` happen in input order, as in a serial run) and submits each knot; the
+ * workers simplify with their own Reapr from `reaprs`; this thread writes,
+ * reports and tallies the knots in input order through the pool's bounded
+ * reorder window (tools/ordered_pool.hpp). The per-knot input and simplify
+ * times are measured where the work happens, so the report shows the same
+ * per-knot times as a serial run -- and the sums in ProcessingStats are CPU
+ * times, not the wall time of the run.
+ */
+bool ProcessSourceParallel(std::istream& input,
+                           const std::string& source_name,
+                           std::ostream* output_stream,
+                           const Config& config,
+                           Knoodle::PRNG_T& rng,
+                           std::vector<Reapr_T>& reaprs,
+                           ProcessingStats& stats,
+                           bool& first_knot_in_output)
+{
+    const std::size_t thread_count = reaprs.size();
+
+    OrderedPool<PendingKnot, PendingKnot> pool(
+        thread_count, thread_count * kReorderWindowPerThread,
+        [&](std::size_t w, PendingKnot& knot)
         {
-            ScopedTimer timer(output_time);
+            const long errors_before = ThreadErrorTotal();
+            knot.simplified = SimplifyKnot(knot.input, config,
+                                           config.pdc_format ? &knot.output_pdc : nullptr,
+                                           &reaprs[w]);
+            knot.simplify_error_count = ThreadErrorTotal() - errors_before;
+            return std::move(knot);
+        });
 
-            if (output_stream)
-            {
-                // Writing to shared output stream
-                WriteSimplified(simplified, config.pdc_format ? &output_pdc : nullptr, *output_stream,
-                                 !first_knot_in_output || !config.streaming_mode,
-                                 colored_output);
-                first_knot_in_output = false;
-            }
-            else if (!config.streaming_mode)
-            {
-                // Per-file output. Staged, and committed only if nothing went
-                // wrong while producing this knot (see AtomicOutFile).
-                std::filesystem::path input_path(source_name);
-                std::filesystem::path output_path = GetSimplifiedFilename(input_path);
+    std::atomic<bool> reader_success = true;
 
-                const long errors_before = ErrorTotal();
+    std::thread reader([&]()
+    {
+        bool reached_eof = false;
 
-                AtomicOutFile file(output_path);
-                if (!file.Good())
-                {
-                    LogError("Failed to open " + output_path.string() + " for writing");
-                    return false;
-                }
+        while (!reached_eof)
+        {
+            PendingKnot knot;
+            std::optional<InputKnot> input_knot;
 
-                WriteSimplified(simplified, config.pdc_format ? &output_pdc : nullptr, file.Stream(), true, colored_output);
+            {
+                ScopedTimer timer(knot.input_time);
+                input_knot = ReadKnot(input, config.randomize_projection, rng, source_name, reached_eof);
+            }
 
-                if (ErrorTotal() != errors_before)
-                {
-                    file.Abort();
-                    *g_log_stream << "Refusing to write " << output_path.string()
-                                  << ": the library reported an error while producing it.\n";
-                    return false;
-                }
-                if (!file.Commit())
+            if (!input_knot)
+            {
+                if (!reached_eof)
                 {
-                    LogError("Failed to move output into place: " + output_path.string());
-                    return false;
+                    reader_success = false;  // Parse error
+                    break;
                 }
+                continue;
             }
-        }
 
-        // Reporting phase
-        if (config.quiet)
-        {
-            // In quiet mode, just print a counter that updates in place
-            *g_log_stream << "\r" << (stats.total_knots + 1) << " knots processed" << std::flush;
-        }
-        else
-        {
-            WriteKnotReport(*input_knot, simplified, config, input_time, output_time);
+            knot.input = std::move(*input_knot);
+
+            if (!pool.Submit(std::move(knot))) { break; }
         }
 
-        // Update stats
-        stats.input_crossings  += input_knot->total_crossings;
-        stats.output_crossings += simplified.total_crossings;
-        stats.total_summands   += simplified.TotalSummandCount();
-        stats.proven_minimal_summands += simplified.TotalProvenMinimalCount();
-        if (simplified.FullySimplifiedQ())
+        pool.Close();
+    });
+
+    bool success = true;
+
+    try
+    {
+        while (auto knot = pool.Next())
         {
-            ++stats.fully_simplified_knots;
+            if (!EmitKnot(knot->input, knot->simplified,
+                          config.pdc_format ? &knot->output_pdc : nullptr, knot->input_time,
+                          knot->simplify_error_count, source_name, output_stream, config, stats, first_knot_in_output))
+            {
+                success = false;
+                break;
+            }
         }
-        stats.input_time       += input_time;
-        stats.simplify_time    += simplified.simplify_time;
-        stats.output_time      += output_time;
-        ++stats.total_knots;
+    }
+    catch (...)
+    {
+        // Unblock the reader so it can be joined, then rethrow.
+        pool.Stop();
+        reader.join();
+        throw;
     }
 
-    return true;
+    // Stop the pool before joining: after a write failure the reader may be
+    // blocked in Submit() on a full window.
+    pool.Stop();
+    reader.join();
+
+    return success && reader_success;
 }
 
 } // anonymous namespace
@@ -1464,6 +1731,23 @@ int main(int argc, char* argv[])
         output_stream = &output_file->Stream();
     }
 
+    // --threads: the workers' Reaprs live for the whole run, so each keeps one
+    // random stream across all sources.
+    std::vector<Reapr_T> worker_reaprs;
+    if (config.threads > 1)
+    {
+        worker_reaprs = MakeWorkerReaprs(config, rng);
+    }
+
+    auto process_source = [&](std::istream& input, const std::string& source_name)
+    {
+        return worker_reaprs.empty()
+            ? ProcessSource(input, source_name, output_stream, config, rng,
+                            stats, first_knot_in_output)
+            : ProcessSourceParallel(input, source_name, output_stream, config, rng,
+                                    worker_reaprs, stats, first_knot_in_output);
+    };
+
     // Process inputs
     bool success = true;
 
@@ -1477,8 +1761,7 @@ int main(int argc, char* argv[])
             std::cerr << "knoodlesimplify: reading diagrams from stdin (Ctrl-D to end). "
                          "Pipe a stream or pass a file; --help for usage.\n";
         }
-        success = ProcessSource(std::cin, "stdin", output_stream, config, rng,
-                                stats, first_knot_in_output);
+        success = process_source(std::cin, "stdin");
         if (success)
         {
             ++stats.files_processed;
@@ -1525,8 +1808,7 @@ int main(int argc, char* argv[])
                 continue;
             }
 
-            if (!ProcessSource(file, filename, output_stream, config, rng,
-                               stats, first_knot_in_output))
+            if (!process_source(file, filename))
             {
                 success = false;
             }
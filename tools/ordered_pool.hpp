@@ -0,0 +1,250 @@
+/**
+ * @file ordered_pool.hpp
+ * @brief Work-stealing thread pool with in-order result delivery, for the
+ *        --threads modes of knoodleidentify and knoodlesimplify.
+ *
+ * One producer Submit()s items, `thread_count` workers process them, and one
+ * consumer takes the results via Next() in exactly the order the items were
+ * submitted -- so a multithreaded run writes the same output, line for line,
+ * as a single-threaded one.
+ *
+ * Time per item varies by orders of magnitude (a Reapr escalation vs. a direct
+ * table hit), so the items are not handed out in fixed blocks. Each worker
+ * owns a deque; the producer deals items round-robin onto the deques, a worker
+ * pops from the front of its own deque and, when that is empty, steals from
+ * the back of the others'. A worker stuck on one slow item therefore never
+ * holds up the items queued behind it.
+ *
+ * Memory is bounded by the reorder window: Submit() blocks while `window`
+ * items are submitted but not yet taken by Next(). If the item at the head of
+ * the window is slow, the others finish and wait in their slots; the window
+ * must be comfortably larger than the thread count for the pool to stay busy.
+ *
+ * Exceptions thrown by the work function are captured per item and rethrown
+ * by Next() when that item's turn comes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Reorder window per worker thread for the tools' --threads modes. Large
+/// enough that one slow item at the head of the window does not idle the
+/// other workers for long; small enough that the buffered diagrams stay cheap.
+constexpr std::size_t kReorderWindowPerThread = 16;
+
+template <typename Item, typename Result>
+class OrderedPool
+{
+public:
+    /// The work function; `worker` is in [0, thread_count), so callers can keep
+    /// per-worker state (a Reapr, scratch diagrams) in a vector indexed by it.
+    using Work_T = std::function<Result(std::size_t worker, Item& item)>;
+
+    OrderedPool(std::size_t thread_count, std::size_t window, Work_T work)
+    :   work_   (std::move(work))
+    ,   window_ (std::max(window, std::size_t(1)))
+    ,   slots_  (window_)
+    {
+        thread_count = std::max(thread_count, std::size_t(1));
+
+        for (std::size_t w = 0; w < thread_count; ++w)
+        {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (std::size_t w = 0; w < thread_count; ++w)
+        {
+            threads_.emplace_back([this, w]() { WorkerLoop(w); });
+        }
+    }
+
+    OrderedPool(const OrderedPool&)            = delete;
+    OrderedPool& operator=(const OrderedPool&) = delete;
+
+    ~OrderedPool()
+    {
+        Stop();
+        for (std::thread& t : threads_) { t.join(); }
+    }
+
+    /// Stops the workers after their current item and makes Submit() return
+    /// false; items that were not processed yet are discarded. Use it to
+    /// unblock a producer thread when the consumer bails out.
+    void Stop()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        space_cv_.notify_all();
+    }
+
+    std::size_t ThreadCount() const { return threads_.size(); }
+
+    /// Single producer. Blocks while the reorder window is full. Returns false
+    /// (and drops the item) if the pool is being destroyed.
+    bool Submit(Item item)
+    {
+        std::size_t seq;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            space_cv_.wait(lock, [this]() { return stop_ || submitted_ - taken_ < window_; });
+            if (stop_) { return false; }
+            seq = submitted_++;
+            slots_[seq % window_] = Slot{};
+        }
+
+        Queue& q = *queues_[seq % queues_.size()];
+        {
+            const std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(Task{seq, std::move(item)});
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            ++queued_;
+        }
+        work_cv_.notify_one();
+        return true;
+    }
+
+    /// Single producer: no more items will be submitted.
+    void Close()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        result_cv_.notify_all();
+    }
+
+    /// Single consumer. The result of the next item in submission order; waits
+    /// for it if necessary. Returns nullopt once the pool is closed and every
+    /// submitted item has been taken.
+    std::optional<Result> Next()
+    {
+        Slot slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            result_cv_.wait(lock, [this]()
+            {
+                return slots_[taken_ % window_].readyQ || (closed_ && taken_ == submitted_);
+            });
+            if (taken_ == submitted_) { return std::nullopt; }
+
+            slot = std::move(slots_[taken_ % window_]);
+            slots_[taken_ % window_] = Slot{};
+            ++taken_;
+        }
+        space_cv_.notify_one();
+
+        if (slot.error) { std::rethrow_exception(slot.error); }
+        return std::move(slot.result);
+    }
+
+private:
+    struct Task
+    {
+        std::size_t seq;
+        Item        item;
+    };
+
+    struct Queue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct Slot
+    {
+        bool                  readyQ = false;
+        std::optional<Result> result;
+        std::exception_ptr    error;
+    };
+
+    /// Own deque first (front), then steal from the others (back).
+    std::optional<Task> TryPop(std::size_t w)
+    {
+        const std::size_t n = queues_.size();
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            Queue& q = *queues_[(w + k) % n];
+            const std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) { continue; }
+            Task t = (k == 0) ? std::move(q.tasks.front()) : std::move(q.tasks.back());
+            if (k == 0) { q.tasks.pop_front(); } else { q.tasks.pop_back(); }
+            return t;
+        }
+        return std::nullopt;
+    }
+
+    void WorkerLoop(std::size_t w)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.wait(lock, [this]() { return stop_ || queued_ > 0; });
+                if (stop_) { return; }
+                --queued_;   // reserve one task; it is in some deque
+            }
+
+            std::optional<Task> task;
+            while (!(task = TryPop(w)))
+            {
+                // The producer bumps queued_ only after the push is visible, so
+                // a reserved task is in some deque; another worker may just have
+                // stolen the one we saw. Rare and short: yield and look again.
+                std::this_thread::yield();
+            }
+
+            Slot slot;
+            slot.readyQ = true;
+            try
+            {
+                slot.result.emplace(work_(w, task->item));
+            }
+            catch (...)
+            {
+                slot.error = std::current_exception();
+            }
+
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                slots_[task->seq % window_] = std::move(slot);
+            }
+            result_cv_.notify_one();
+        }
+    }
+
+    Work_T                              work_;
+    std::size_t                         window_;
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread>            threads_;
+
+    std::mutex              mutex_;     // guards everything below
+    std::condition_variable work_cv_;   // queued_ > 0 or stop_
+    std::condition_variable result_cv_; // head slot ready or closed_
+    std::condition_variable space_cv_;  // window has room or stop_
+    std::vector<Slot>       slots_;     // reorder buffer, indexed by seq % window_
+    std::size_t             submitted_ = 0;
+    std::size_t             taken_     = 0;
+    std::size_t             queued_    = 0;  // pushed but not yet reserved by a worker
+    bool                    closed_    = false;
+    bool                    stop_      = false;
+};
+
+} // anonymous namespace